@@ -0,0 +1,212 @@
+#include "BenchmarkRunner.h"
+#include "WaveshaperKernels.h"
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <regex>
+
+BenchmarkRunner::Options BenchmarkRunner::parseOptions(const juce::ArgumentList& args)
+{
+    Options options;
+    options.filter = args.getValueForOption("--benchmark_filter");
+    options.jsonToConsole = args.getValueForOption("--benchmark_format") == "json";
+    options.listOnly = args.containsOption("--benchmark_list_tests")
+                       && args.getValueForOption("--benchmark_list_tests") != "false";
+
+    // Google Benchmark accepts "0.5" and "0.5s"
+    const auto minTime = args.getValueForOption("--benchmark_min_time").trimCharactersAtEnd("s");
+
+    if (minTime.isNotEmpty())
+        options.minTimeSeconds = juce::jmax(0.001, minTime.getDoubleValue());
+
+    const auto outputPath = args.getValueForOption("--benchmark_out");
+
+    if (outputPath.isNotEmpty())
+        options.outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+
+    return options;
+}
+
+void BenchmarkRunner::add(const juce::String& name, int samplesPerIteration, FixtureFactory createFixture)
+{
+    benchmarks.push_back({ name, samplesPerIteration, std::move(createFixture) });
+}
+
+int BenchmarkRunner::run(const Options& options) const
+{
+    const std::regex filter(options.filter.isEmpty() ? std::string(".") : options.filter.toStdString());
+    juce::Array<Result> results;
+
+    if (!options.listOnly && !options.jsonToConsole)
+        printHeader();
+
+    for (const auto& benchmark : benchmarks)
+    {
+        if (!std::regex_search(benchmark.name.toStdString(), filter))
+            continue;
+
+        if (options.listOnly)
+        {
+            std::cout << benchmark.name << std::endl;
+            continue;
+        }
+
+        results.add(measure(benchmark, options.minTimeSeconds));
+
+        if (!options.jsonToConsole)
+            printRow(results.getReference(results.size() - 1));
+    }
+
+    if (options.listOnly)
+        return 0;
+
+    int exitCode = 0;
+
+    for (const auto& result : results)
+    {
+        if (result.error.isNotEmpty())
+        {
+            std::cerr << result.name << " FAILED: " << result.error << std::endl;
+            exitCode = 1;
+        }
+    }
+
+    const auto json = juce::JSON::toString(createJson(results));
+
+    if (options.jsonToConsole)
+        std::cout << json << std::endl;
+
+    if (options.outputFile != juce::File() && !options.outputFile.replaceWithText(json))
+    {
+        std::cerr << "Couldn't write " << options.outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return exitCode;
+}
+
+BenchmarkRunner::Result BenchmarkRunner::measure(const Benchmark& benchmark, double minTimeSeconds)
+{
+    // Plugins run with denormals flushed, so benchmarks do too
+    juce::ScopedNoDenormals noDenormals;
+
+    auto fixture = benchmark.createFixture();
+
+    // Warm caches, branch predictors and any lazily started worker threads
+    for (int i = 0; i < 8; ++i)
+        fixture->run();
+
+    juce::int64 iterations = 1;
+
+    for (;;)
+    {
+        const auto wallStart = std::chrono::steady_clock::now();
+        const auto cpuStart = std::clock();
+
+        for (juce::int64 i = 0; i < iterations; ++i)
+            fixture->run();
+
+        const double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+        if (wallSeconds >= minTimeSeconds || iterations >= 1000000000)
+        {
+            Result result;
+            result.name = benchmark.name;
+            result.iterations = iterations;
+            result.realTimeNs = wallSeconds * 1.0e9 / static_cast<double>(iterations);
+            result.cpuTimeNs = cpuSeconds * 1.0e9 / static_cast<double>(iterations);
+            result.nsPerSample = result.realTimeNs / static_cast<double>(juce::jmax(1, benchmark.samplesPerIteration));
+            fixture->getCounters(result.counters);
+            result.error = fixture->getError();
+            return result;
+        }
+
+        // Aim a little past the minimum time, growing by at most 10x per attempt (as Google Benchmark does)
+        const double multiplier = wallSeconds > 0.0 ? juce::jmin(10.0, minTimeSeconds * 1.4 / wallSeconds) : 10.0;
+        iterations = juce::jmax(iterations + 1, static_cast<juce::int64>(static_cast<double>(iterations) * multiplier));
+    }
+}
+
+juce::var BenchmarkRunner::createJson(const juce::Array<Result>& results)
+{
+    auto* context = new juce::DynamicObject();
+    context->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    context->setProperty("host_name", juce::SystemStats::getComputerName());
+    context->setProperty("executable", juce::File::getSpecialLocation(juce::File::currentExecutableFile).getFullPathName());
+    context->setProperty("num_cpus", juce::SystemStats::getNumCpus());
+    context->setProperty("mhz_per_cpu", juce::SystemStats::getCpuSpeedInMegahertz());
+    context->setProperty("cpu_model", juce::SystemStats::getCpuModel());
+    context->setProperty("juce_version", juce::SystemStats::getJUCEVersion());
+    context->setProperty("waveshaper_instruction_set", juce::String(WaveshaperKernels::getActiveInstructionSet()));
+   #if JUCE_DEBUG
+    context->setProperty("library_build_type", "debug");
+   #else
+    context->setProperty("library_build_type", "release");
+   #endif
+
+    juce::Array<juce::var> benchmarkList;
+
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", result.name);
+        entry->setProperty("run_name", result.name);
+        entry->setProperty("run_type", "iteration");
+        entry->setProperty("repetitions", 1);
+        entry->setProperty("repetition_index", 0);
+        entry->setProperty("threads", 1);
+        entry->setProperty("iterations", result.iterations);
+        entry->setProperty("real_time", result.realTimeNs);
+        entry->setProperty("cpu_time", result.cpuTimeNs);
+        entry->setProperty("time_unit", "ns");
+        entry->setProperty("ns_per_sample", result.nsPerSample);
+
+        if (result.error.isNotEmpty())
+        {
+            entry->setProperty("error_occurred", true);
+            entry->setProperty("error_message", result.error);
+        }
+
+        // User counters sit next to the timings, as in Google Benchmark
+        for (const auto& counter : result.counters)
+            entry->setProperty(counter.name, counter.value);
+
+        benchmarkList.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("context", juce::var(context));
+    root->setProperty("benchmarks", benchmarkList);
+    return juce::var(root);
+}
+
+void BenchmarkRunner::printHeader()
+{
+    const juce::String rule = juce::String::repeatedString("-", 118);
+
+    std::cout << rule << "\n"
+              << juce::String("Benchmark").paddedRight(' ', 70)
+              << juce::String("Time").paddedLeft(' ', 12)
+              << juce::String("CPU").paddedLeft(' ', 12)
+              << juce::String("Iterations").paddedLeft(' ', 12)
+              << juce::String("ns/sample").paddedLeft(' ', 12) << "\n"
+              << rule << std::endl;
+}
+
+void BenchmarkRunner::printRow(const Result& result)
+{
+    std::cout << result.name.paddedRight(' ', 70)
+              << (juce::String(result.realTimeNs, 0) + " ns").paddedLeft(' ', 12)
+              << (juce::String(result.cpuTimeNs, 0) + " ns").paddedLeft(' ', 12)
+              << juce::String(result.iterations).paddedLeft(' ', 12)
+              << juce::String(result.nsPerSample, 3).paddedLeft(' ', 12);
+
+    for (const auto& counter : result.counters)
+        std::cout << "  " << counter.name.toString() << "=" << counter.value.toString();
+
+    if (result.error.isNotEmpty())
+        std::cout << "  ERROR: " << result.error;
+
+    std::cout << std::endl;
+}
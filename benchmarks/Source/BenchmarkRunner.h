@@ -0,0 +1,85 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * BenchmarkFixture - One configured engine, ready to be timed
+ *
+ * Everything expensive (allocation, prepare(), IR loading) happens in the
+ * constructor. run() is one timed iteration - normally refilling the input
+ * block and pushing it through processBlock().
+ */
+class BenchmarkFixture
+{
+public:
+    virtual ~BenchmarkFixture() = default;
+
+    virtual void run() = 0;
+
+    // Extra values reported next to the timings (e.g. error against a reference)
+    virtual void getCounters(juce::NamedValueSet& counters) const { juce::ignoreUnused(counters); }
+
+    // Non-empty if the fixture's own correctness check failed. The result is
+    // still timed, but marked as an error and the run exits non-zero.
+    virtual juce::String getError() const { return {}; }
+};
+
+/**
+ * BenchmarkRunner - A small Google Benchmark style timing harness
+ *
+ * Each benchmark grows its iteration count until one timed run lasts at
+ * least the minimum time, then reports wall and CPU time per iteration and
+ * nanoseconds per sample frame.
+ *
+ * Command line flags follow Google Benchmark (--benchmark_filter,
+ * --benchmark_min_time, --benchmark_format, --benchmark_out,
+ * --benchmark_list_tests) and the JSON output uses its schema, so results
+ * can be diffed with Google Benchmark's tools/compare.py.
+ */
+class BenchmarkRunner
+{
+public:
+    using FixtureFactory = std::function<std::unique_ptr<BenchmarkFixture>()>;
+
+    struct Options
+    {
+        juce::String filter;            // Regular expression, searched in the name
+        double minTimeSeconds = 0.1;
+        bool jsonToConsole = false;
+        juce::File outputFile;          // Also write JSON here
+        bool listOnly = false;
+    };
+
+    static Options parseOptions(const juce::ArgumentList& args);
+
+    // samplesPerIteration is the number of sample frames one run() processes
+    void add(const juce::String& name, int samplesPerIteration, FixtureFactory createFixture);
+
+    // Returns the process exit code: non-zero if any fixture reported an error
+    int run(const Options& options) const;
+
+private:
+    struct Benchmark
+    {
+        juce::String name;
+        int samplesPerIteration = 0;
+        FixtureFactory createFixture;
+    };
+
+    struct Result
+    {
+        juce::String name;
+        juce::int64 iterations = 0;
+        double realTimeNs = 0.0;     // Per iteration
+        double cpuTimeNs = 0.0;      // Per iteration
+        double nsPerSample = 0.0;
+        juce::NamedValueSet counters;
+        juce::String error;
+    };
+
+    std::vector<Benchmark> benchmarks;
+
+    static Result measure(const Benchmark& benchmark, double minTimeSeconds);
+    static juce::var createJson(const juce::Array<Result>& results);
+    static void printHeader();
+    static void printRow(const Result& result);
+};
@@ -0,0 +1,54 @@
+#include "DspBenchmarks.h"
+
+namespace DspBenchmarks
+{
+    juce::String makeName(const juce::String& engine, const juce::String& state,
+                          int blockSize, double sampleRate, int numChannels)
+    {
+        juce::String name(engine);
+
+        if (state.isNotEmpty())
+            name << "/" << state;
+
+        return name << "/block:" << blockSize
+                    << "/rate:" << juce::roundToInt(sampleRate)
+                    << "/channels:" << numChannels;
+    }
+
+    void fillTestSignal(juce::AudioBuffer<float>& buffer, double sampleRate, float peakLevel)
+    {
+        juce::Random random(0x5eed);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            float* data = buffer.getWritePointer(channel);
+
+            // Open A string, offset a little per channel so stereo isn't dual mono
+            const double phaseStep = juce::MathConstants<double>::twoPi * 110.0 / sampleRate;
+            const double phaseOffset = 0.3 * channel;
+
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            {
+                const double phase = phaseOffset + phaseStep * sample;
+                const float note = static_cast<float>(std::sin(phase) + 0.3 * std::sin(2.0 * phase));
+                const float noise = random.nextFloat() * 2.0f - 1.0f;
+
+                data[sample] = peakLevel * (0.75f * note + 0.02f * noise);
+            }
+        }
+    }
+
+    AudioBlockFixture::AudioBlockFixture(int blockSize, double sampleRate, int numChannels, float peakLevel)
+        : input(numChannels, blockSize),
+          block(numChannels, blockSize)
+    {
+        fillTestSignal(input, sampleRate, peakLevel);
+        restoreInput();
+    }
+
+    void AudioBlockFixture::restoreInput()
+    {
+        for (int channel = 0; channel < block.getNumChannels(); ++channel)
+            block.copyFrom(channel, 0, input, channel, 0, input.getNumSamples());
+    }
+}
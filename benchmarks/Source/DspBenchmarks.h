@@ -0,0 +1,53 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BenchmarkRunner.h"
+
+/**
+ * DspBenchmarks - What gets measured, and on what
+ *
+ * Engine benchmarks sweep every processBlock over the same matrix of block
+ * sizes, sample rates and channel counts, once per interesting parameter
+ * state. Names follow Google Benchmark's named-argument style, e.g.
+ *
+ *   AmpSimDSP/oversampling:4x/block:256/rate:48000/channels:2
+ *
+ * so a regression can be pinned to one configuration.
+ */
+namespace DspBenchmarks
+{
+    constexpr int blockSizes[] = { 16, 64, 256, 1024, 4096 };
+    constexpr double sampleRates[] = { 44100.0, 48000.0, 96000.0, 192000.0 };
+    constexpr int channelCounts[] = { 1, 2 };
+
+    juce::String makeName(const juce::String& engine, const juce::String& state,
+                          int blockSize, double sampleRate, int numChannels);
+
+    // A guitar-ish test signal: low note plus a little broadband noise.
+    // Deterministic, so every run measures the same thing.
+    void fillTestSignal(juce::AudioBuffer<float>& buffer, double sampleRate, float peakLevel = 0.5f);
+
+    /**
+     * Base for fixtures that process one audio block per iteration. The
+     * block is refilled from a stored copy of the input each time, so every
+     * iteration sees the same signal rather than its own output.
+     */
+    class AudioBlockFixture : public BenchmarkFixture
+    {
+    protected:
+        AudioBlockFixture(int blockSize, double sampleRate, int numChannels, float peakLevel = 0.5f);
+
+        void restoreInput();
+
+        juce::AudioBuffer<float> input;
+        juce::AudioBuffer<float> block;
+    };
+
+    // AmpSimDSP, JazzChorusDSP, ChorusEffect, BassVoice and BassEffects
+    void registerEngineBenchmarks(BenchmarkRunner& runner);
+
+    // Building blocks against the code they replaced: CascadedBiquad vs a
+    // ProcessorDuplicator chain, waveshaper kernels and the drive table vs
+    // the scalar reference (with their max error as a counter), and the
+    // chorus interpolators (with their THD+N as counters)
+    void registerKernelBenchmarks(BenchmarkRunner& runner);
+}
@@ -0,0 +1,375 @@
+#include "DspBenchmarks.h"
+#include "AmpSimDSP.h"
+#include "JazzChorusDSP.h"
+#include "ChorusEffect.h"
+#include "BassVoice.h"
+#include "BassWavetableBank.h"
+#include "BassSynthesiser.h"
+#include "BassEffects.h"
+
+namespace
+{
+    using namespace DspBenchmarks;
+
+    // A 500ms decaying-noise cabinet IR, written once per run
+    juce::File getTestImpulseResponse()
+    {
+        static juce::TemporaryFile impulseFile(".wav");
+        static const bool written = []
+        {
+            constexpr double sampleRate = 48000.0;
+            juce::AudioBuffer<float> impulse(1, static_cast<int>(0.5 * sampleRate));
+            juce::Random random(0x1234);
+
+            for (int sample = 0; sample < impulse.getNumSamples(); ++sample)
+                impulse.setSample(0, sample, (random.nextFloat() * 2.0f - 1.0f)
+                                                 * std::exp(-8.0f * static_cast<float>(sample / sampleRate)));
+
+            std::unique_ptr<juce::OutputStream> stream(impulseFile.getFile().createOutputStream());
+            juce::WavAudioFormat wavFormat;
+            std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), sampleRate, 1, 24, {}, 0));
+
+            if (writer == nullptr)
+                return false;
+
+            stream.release(); // Owned by the writer
+            return writer->writeFromAudioSampleBuffer(impulse, 0, impulse.getNumSamples());
+        }();
+
+        jassert(written);
+        juce::ignoreUnused(written);
+        return impulseFile.getFile();
+    }
+
+    template <typename FixtureType, typename StateType>
+    void addMatrix(BenchmarkRunner& runner, const juce::String& engine, const juce::String& stateName, StateType state)
+    {
+        for (const int blockSize : blockSizes)
+            for (const double sampleRate : sampleRates)
+                for (const int numChannels : channelCounts)
+                    runner.add(makeName(engine, stateName, blockSize, sampleRate, numChannels), blockSize,
+                               [=] { return std::make_unique<FixtureType>(blockSize, sampleRate, numChannels, state); });
+    }
+
+    //==============================================================================
+    struct AmpState
+    {
+        int oversampling = 0;
+        bool cabinet = false;
+    };
+
+    class AmpSimFixture : public AudioBlockFixture
+    {
+    public:
+        AmpSimFixture(int blockSize, double sampleRate, int numChannels, AmpState state)
+            : AudioBlockFixture(blockSize, sampleRate, numChannels)
+        {
+            ampSim.setPreampGain(0.6f);
+            ampSim.setDrive(0.5f);
+            ampSim.setOversampling(state.oversampling);
+            ampSim.setCabinetEnabled(state.cabinet);
+
+            if (state.cabinet)
+                ampSim.loadCabinetImpulseResponse(getTestImpulseResponse());
+
+            ampSim.prepare(sampleRate, blockSize, numChannels);
+        }
+
+        void run() override
+        {
+            restoreInput();
+            ampSim.processBlock(block);
+        }
+
+    private:
+        AmpSimDSP ampSim;
+    };
+
+    //==============================================================================
+    class JazzChorusFixture : public AudioBlockFixture
+    {
+    public:
+        JazzChorusFixture(int blockSize, double sampleRate, int numChannels, bool chorusEnabled)
+            : AudioBlockFixture(blockSize, sampleRate, numChannels)
+        {
+            jazzChorus.setChorusEnabled(chorusEnabled);
+            jazzChorus.prepare(sampleRate, blockSize, numChannels);
+        }
+
+        void run() override
+        {
+            restoreInput();
+            jazzChorus.processBlock(block);
+        }
+
+    private:
+        JazzChorusDSP jazzChorus;
+    };
+
+    struct ChorusState
+    {
+        bool enabled = true;
+        int numVoices = 1;
+        ChorusInterpolation interpolation = ChorusInterpolation::Linear;
+        bool bucketBrigade = false;
+    };
+
+    class ChorusFixture : public AudioBlockFixture
+    {
+    public:
+        ChorusFixture(int blockSize, double sampleRate, int numChannels, ChorusState state)
+            : AudioBlockFixture(blockSize, sampleRate, numChannels)
+        {
+            chorus.setEnabled(state.enabled);
+            chorus.setVoices(state.numVoices);
+            chorus.setInterpolation(state.interpolation);
+            chorus.setBucketBrigade(state.bucketBrigade);
+            chorus.prepare(sampleRate, blockSize, numChannels);
+        }
+
+        void run() override
+        {
+            restoreInput();
+            chorus.processBlock(block);
+        }
+
+    private:
+        ChorusEffect chorus;
+    };
+
+    //==============================================================================
+    // One held note rendered by a single voice - the per-voice cost of the synth
+    class BassVoiceFixture : public BenchmarkFixture
+    {
+    public:
+        BassVoiceFixture(int blockSize, double sampleRate, int numChannels, BassArticulation articulation)
+            : output(numChannels, blockSize)
+        {
+            voice = new BassVoice();
+            synthesiser.addVoice(voice);
+            synthesiser.addSound(new BassSound());
+            synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+
+            wavetables.prepare(sampleRate);
+            voice->prepare(sampleRate, blockSize);
+            voice->setWavetables(&wavetables);
+            voice->setNextArticulation(articulation);
+            startNote();
+        }
+
+        void run() override
+        {
+            // Every articulation sustains, but restart if a note ever ends
+            if (!voice->isVoiceActive())
+                startNote();
+
+            output.clear();
+            voice->renderNextBlock(output, 0, output.getNumSamples());
+        }
+
+    private:
+        BassWavetableBank wavetables;
+        juce::Synthesiser synthesiser;  // Starts the note so the voice is marked active
+        BassVoice* voice = nullptr;     // Owned by the synthesiser
+        juce::AudioBuffer<float> output;
+
+        void startNote()
+        {
+            synthesiser.noteOn(1, 40, 0.8f); // E2
+        }
+    };
+
+    struct BassSynthesiserState
+    {
+        int numVoices = 1;
+        BassSynthesisModel model = BassSynthesisModel::Wavetable;
+    };
+
+    // Several held notes through the batched synthesiser - cost as polyphony
+    // grows, for the wavetables or the waveguide string
+    class BassSynthesiserFixture : public BenchmarkFixture
+    {
+    public:
+        BassSynthesiserFixture(int blockSize, double sampleRate, int numChannels, BassSynthesiserState state)
+            : output(numChannels, blockSize),
+              numVoices(state.numVoices)
+        {
+            wavetables.prepare(sampleRate);
+            synthesiser.addSound(new BassSound());
+            synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+
+            for (int i = 0; i < numVoices; ++i)
+            {
+                auto* voice = new BassVoice();
+                synthesiser.addVoice(voice);
+                voice->prepare(sampleRate, blockSize);
+                voice->setWavetables(&wavetables);
+            }
+
+            synthesiser.prepare(blockSize);
+            synthesiser.setArticulation(BassArticulation::Slap);
+            synthesiser.setSynthesisModel(state.model);
+            startNotes();
+        }
+
+        void run() override
+        {
+            if (!synthesiser.getVoice(0)->isVoiceActive())
+                startNotes();
+
+            output.clear();
+            synthesiser.renderNextBlock(output, midi, 0, output.getNumSamples());
+        }
+
+    private:
+        BassWavetableBank wavetables;
+        BassSynthesiser synthesiser;
+        juce::AudioBuffer<float> output;
+        juce::MidiBuffer midi;
+        const int numVoices;
+
+        void startNotes()
+        {
+            // Stacked notes from E1 up, one per voice
+            for (int i = 0; i < numVoices; ++i)
+                synthesiser.noteOn(1, 28 + i * 5, 0.8f);
+        }
+    };
+
+    // A new note every block with the polyphony limit reached - every note
+    // steals one and crossfades it out on a spare pool voice
+    class BassVoiceStealingFixture : public BenchmarkFixture
+    {
+    public:
+        BassVoiceStealingFixture(int blockSize, double sampleRate, int numChannels, int polyphony)
+            : output(numChannels, blockSize)
+        {
+            wavetables.prepare(sampleRate);
+            synthesiser.addSound(new BassSound());
+            synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+
+            for (int i = 0; i < BassSynthesiser::voicePoolSize; ++i)
+            {
+                auto* voice = new BassVoice();
+                synthesiser.addVoice(voice);
+                voice->prepare(sampleRate, blockSize);
+                voice->setWavetables(&wavetables);
+            }
+
+            synthesiser.prepare(blockSize);
+            synthesiser.setArticulation(BassArticulation::Slap);
+            synthesiser.setPolyphony(polyphony);
+        }
+
+        void run() override
+        {
+            // Cycle through two octaves from E1
+            synthesiser.noteOn(1, 28 + nextNote, 0.8f);
+            nextNote = (nextNote + 5) % 24;
+
+            output.clear();
+            synthesiser.renderNextBlock(output, midi, 0, output.getNumSamples());
+        }
+
+    private:
+        BassWavetableBank wavetables;
+        BassSynthesiser synthesiser;
+        juce::AudioBuffer<float> output;
+        juce::MidiBuffer midi;
+        int nextNote = 0;
+    };
+
+    class BassEffectsFixture : public AudioBlockFixture
+    {
+    public:
+        BassEffectsFixture(int blockSize, double sampleRate, int numChannels, BassTone tone)
+            : AudioBlockFixture(blockSize, sampleRate, numChannels)
+        {
+            effects.setTone(tone);
+            effects.setCompression(0.5f);
+            effects.prepare(sampleRate, blockSize, numChannels);
+        }
+
+        void run() override
+        {
+            restoreInput();
+            effects.processBlock(block);
+        }
+
+    private:
+        BassEffects effects;
+    };
+}
+
+void DspBenchmarks::registerEngineBenchmarks(BenchmarkRunner& runner)
+{
+    const std::pair<const char*, AmpState> ampStates[] = {
+        { "oversampling:off", { 0, false } },
+        { "oversampling:2x", { 1, false } },
+        { "oversampling:4x", { 2, false } },
+        { "oversampling:8x", { 3, false } },
+        { "oversampling:2x/cabinet:on", { 1, true } }
+    };
+
+    for (const auto& [stateName, state] : ampStates)
+        addMatrix<AmpSimFixture>(runner, "AmpSimDSP", stateName, state);
+
+    for (const bool chorusEnabled : { true, false })
+    {
+        const juce::String stateName = chorusEnabled ? "chorus:on" : "chorus:off";
+        addMatrix<JazzChorusFixture>(runner, "JazzChorusDSP", stateName, chorusEnabled);
+        addMatrix<ChorusFixture>(runner, "ChorusEffect", stateName, ChorusState { chorusEnabled, 1 });
+    }
+
+    // Ensemble taps share the write, LFO and mix - cost against voice count
+    for (const int numVoices : { 2, 4, 8 })
+        addMatrix<ChorusFixture>(runner, "ChorusEffect", "ensemble:voices:" + juce::String(numVoices),
+                                 ChorusState { true, numVoices });
+
+    // The interpolators in place, one tap and a full ensemble
+    for (const auto interpolation : { ChorusInterpolation::Hermite, ChorusInterpolation::Lagrange,
+                                      ChorusInterpolation::Allpass, ChorusInterpolation::Sinc })
+    {
+        for (const int numVoices : { 1, 8 })
+            addMatrix<ChorusFixture>(runner, "ChorusEffect",
+                                     "interpolation:" + ChorusInterpolators::getName(interpolation) + "/voices:" + juce::String(numVoices),
+                                     ChorusState { true, numVoices, interpolation });
+    }
+
+    // The analog BBD path against the digital ones above
+    for (const int numVoices : { 1, 8 })
+        addMatrix<ChorusFixture>(runner, "ChorusEffect", "bbd/voices:" + juce::String(numVoices),
+                                 ChorusState { true, numVoices, ChorusInterpolation::Linear, true });
+
+    const std::pair<const char*, BassArticulation> articulations[] = {
+        { "articulation:picked", BassArticulation::Picked },
+        { "articulation:fingerstyle", BassArticulation::Fingerstyle },
+        { "articulation:slap", BassArticulation::Slap },
+        { "articulation:muted", BassArticulation::Muted }
+    };
+
+    for (const auto& [stateName, articulation] : articulations)
+        addMatrix<BassVoiceFixture>(runner, "BassVoice", stateName, articulation);
+
+    for (const int numVoices : { 1, 4, 8 })
+    {
+        addMatrix<BassSynthesiserFixture>(runner, "BassSynthesiser", "voices:" + juce::String(numVoices),
+                                          BassSynthesiserState { numVoices, BassSynthesisModel::Wavetable });
+        addMatrix<BassSynthesiserFixture>(runner, "BassSynthesiser", "string:voices:" + juce::String(numVoices),
+                                          BassSynthesiserState { numVoices, BassSynthesisModel::String });
+    }
+
+    for (const int polyphony : { 1, 8 })
+        addMatrix<BassVoiceStealingFixture>(runner, "BassSynthesiser", "stealing:poly" + juce::String(polyphony), polyphony);
+
+    const std::pair<const char*, BassTone> tones[] = {
+        { "tone:di", BassTone::DI },
+        { "tone:ampsim", BassTone::AmpSim },
+        { "tone:compressed", BassTone::Compressed },
+        { "tone:bright", BassTone::Bright },
+        { "tone:vintage", BassTone::Vintage }
+    };
+
+    for (const auto& [stateName, tone] : tones)
+        addMatrix<BassEffectsFixture>(runner, "BassEffects", stateName, tone);
+}
@@ -0,0 +1,350 @@
+#include "DspBenchmarks.h"
+#include "CascadedBiquad.h"
+#include "WaveshaperKernels.h"
+#include "TransferCurveTable.h"
+#include "ChorusInterpolation.h"
+
+namespace
+{
+    using namespace DspBenchmarks;
+
+    constexpr double kernelSampleRate = 48000.0;
+
+    //==============================================================================
+    // The Orange tone stack plus DC blocker, as one fused cascade...
+    class CascadedBiquadFixture : public AudioBlockFixture
+    {
+    public:
+        CascadedBiquadFixture(int blockSize, double sampleRate, int numChannels)
+            : AudioBlockFixture(blockSize, sampleRate, numChannels)
+        {
+            using Type = CascadedBiquad::SectionType;
+
+            cascade.setSection(0, Type::LowShelf, 120.0, 0.7, 3.0f);
+            cascade.setSection(1, Type::Peak, 800.0, 1.5, -2.0f);
+            cascade.setSection(2, Type::HighShelf, 3000.0, 0.7, 4.0f);
+            cascade.setSection(3, Type::HighShelf, 6000.0, 0.5, 1.5f);
+            cascade.setSection(4, Type::HighPass, 20.0);
+            cascade.prepare(sampleRate, numChannels);
+        }
+
+        void run() override
+        {
+            restoreInput();
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            cascade.process(audioBlock);
+        }
+
+    private:
+        CascadedBiquad cascade;
+    };
+
+    // ...and as the chain of ProcessorDuplicators it replaced
+    class DuplicatorChainFixture : public AudioBlockFixture
+    {
+    public:
+        DuplicatorChainFixture(int blockSize, double sampleRate, int numChannels)
+            : AudioBlockFixture(blockSize, sampleRate, numChannels)
+        {
+            using Coefficients = juce::dsp::IIR::Coefficients<float>;
+
+            *filters[0].state = *Coefficients::makeLowShelf(sampleRate, 120.0f, 0.7f, juce::Decibels::decibelsToGain(3.0f));
+            *filters[1].state = *Coefficients::makePeakFilter(sampleRate, 800.0f, 1.5f, juce::Decibels::decibelsToGain(-2.0f));
+            *filters[2].state = *Coefficients::makeHighShelf(sampleRate, 3000.0f, 0.7f, juce::Decibels::decibelsToGain(4.0f));
+            *filters[3].state = *Coefficients::makeHighShelf(sampleRate, 6000.0f, 0.5f, juce::Decibels::decibelsToGain(1.5f));
+            *filters[4].state = *Coefficients::makeHighPass(sampleRate, 20.0f);
+
+            const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize),
+                                                static_cast<juce::uint32>(numChannels) };
+
+            for (auto& filter : filters)
+                filter.prepare(spec);
+        }
+
+        void run() override
+        {
+            restoreInput();
+            juce::dsp::AudioBlock<float> audioBlock(block);
+            juce::dsp::ProcessContextReplacing<float> context(audioBlock);
+
+            for (auto& filter : filters)
+                filter.process(context);
+        }
+
+    private:
+        std::array<juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>,
+                                                  juce::dsp::IIR::Coefficients<float>>, 5> filters;
+    };
+
+    //==============================================================================
+    // Drive settings like the amp's: preamp gain 1-10, drive gain 1-21
+    const WaveshaperKernels::AmpStageGains testGains { 5.5f, 11.0f, 0.5f };
+
+    enum class WaveshaperPath
+    {
+        reference,  // The original per-sample scalar code
+        kernel,     // WaveshaperKernels block functions
+        table       // TransferCurveTable lookup (ampStages only)
+    };
+
+    // Largest difference from the reference each path may show on the test
+    // signal before the benchmark reports an error. The kernels do the same
+    // float operations, so only contraction into FMA in a scalar tail (arm64)
+    // can move them, by an ulp or two. The table's linear interpolation is
+    // good to about 3.5e-5 at this drive setting.
+    float getTolerance(WaveshaperPath path)
+    {
+        switch (path)
+        {
+            case WaveshaperPath::kernel: return 1.0e-6f;
+            case WaveshaperPath::table:  return 1.0e-4f;
+            case WaveshaperPath::reference:
+            default:                     return 0.0f;
+        }
+    }
+
+    juce::String getPathName(WaveshaperPath path)
+    {
+        switch (path)
+        {
+            case WaveshaperPath::kernel: return "kernel";
+            case WaveshaperPath::table:  return "table";
+            case WaveshaperPath::reference:
+            default:                     return "reference";
+        }
+    }
+
+    // Single channel, driven hard enough to reach both clipping regions
+    class WaveshaperFixture : public AudioBlockFixture
+    {
+    public:
+        WaveshaperFixture(int blockSize, bool fusedStages, WaveshaperPath pathToUse)
+            : AudioBlockFixture(blockSize, kernelSampleRate, 1, 2.0f),
+              ampStages(fusedStages),
+              path(pathToUse),
+              driveCurve(WaveshaperKernels::ampStageCurve, 3.0f)
+        {
+            driveCurve.setParameter(testGains.driveGain);
+            driveCurve.prepare(kernelSampleRate);
+
+            // Error against the reference on the same input, measured once up front
+            run();
+
+            const float* input = this->input.getReadPointer(0);
+            const float* output = block.getReadPointer(0);
+
+            for (int sample = 0; sample < block.getNumSamples(); ++sample)
+            {
+                const float expected = ampStages ? WaveshaperKernels::reference::ampStages(input[sample], testGains)
+                                                 : WaveshaperKernels::reference::softClip(input[sample]);
+                maxError = juce::jmax(maxError, std::abs(output[sample] - expected));
+            }
+        }
+
+        void run() override
+        {
+            restoreInput();
+            float* data = block.getWritePointer(0);
+            const int numSamples = block.getNumSamples();
+
+            switch (path)
+            {
+                case WaveshaperPath::reference:
+                    for (int sample = 0; sample < numSamples; ++sample)
+                        data[sample] = ampStages ? WaveshaperKernels::reference::ampStages(data[sample], testGains)
+                                                 : WaveshaperKernels::reference::softClip(data[sample]);
+                    break;
+
+                case WaveshaperPath::kernel:
+                    if (ampStages)
+                        WaveshaperKernels::ampStages(data, numSamples, testGains);
+                    else
+                        WaveshaperKernels::softClip(data, numSamples);
+                    break;
+
+                case WaveshaperPath::table:
+                {
+                    juce::dsp::AudioBlock<float> audioBlock(block);
+                    driveCurve.process(audioBlock, testGains.preampGain, testGains.outputGain);
+                    break;
+                }
+            }
+        }
+
+        void getCounters(juce::NamedValueSet& counters) const override
+        {
+            counters.set("max_abs_error", maxError);
+        }
+
+        juce::String getError() const override
+        {
+            if (maxError <= getTolerance(path))
+                return {};
+
+            return "max abs error " + juce::String(maxError) + " against the reference exceeds "
+                   + juce::String(getTolerance(path));
+        }
+
+    private:
+        const bool ampStages;
+        const WaveshaperPath path;
+        TransferCurveTable driveCurve;
+        float maxError = 0.0f;
+    };
+
+    //==============================================================================
+    // Chorus-like sweep: 40 samples +/- 12 at 1.3 Hz, so every fraction gets visited
+    double getSweptDelay(int sample)
+    {
+        return 40.0 + 12.0 * std::sin(juce::MathConstants<double>::twoPi * 1.3 * sample / kernelSampleRate);
+    }
+
+    // Reads source at each swept position; the allpass state carries across calls
+    template <typename Interpolator>
+    void interpolateSweep(Interpolator interpolate, const float* source, const double* positions,
+                          float* output, int numSamples, float& state)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int index = static_cast<int>(positions[i]);
+            output[i] = interpolate(source + index, static_cast<float>(positions[i] - index), state);
+        }
+    }
+
+    void interpolateSweep(ChorusInterpolation interpolation, const float* source, const double* positions,
+                          float* output, int numSamples, float& state)
+    {
+        using namespace ChorusInterpolators;
+
+        switch (interpolation)
+        {
+            case ChorusInterpolation::Linear:   interpolateSweep(Linear {}, source, positions, output, numSamples, state); break;
+            case ChorusInterpolation::Hermite:  interpolateSweep(Hermite {}, source, positions, output, numSamples, state); break;
+            case ChorusInterpolation::Lagrange: interpolateSweep(Lagrange {}, source, positions, output, numSamples, state); break;
+            case ChorusInterpolation::Allpass:  interpolateSweep(Allpass {}, source, positions, output, numSamples, state); break;
+            case ChorusInterpolation::Sinc:     interpolateSweep(Sinc { getSincTable().rows.data() }, source, positions, output, numSamples, state); break;
+        }
+    }
+
+    // THD+N in dB of a sine read back through the swept delay: everything that
+    // isn't the exactly delayed sine - harmonics, modulation noise, the kernel's
+    // high-frequency loss - against the sine itself
+    double measureDistortion(ChorusInterpolation interpolation, double frequency)
+    {
+        constexpr int length = 1 << 16;
+        constexpr int settleSamples = 2048;
+        const double omega = juce::MathConstants<double>::twoPi * frequency / kernelSampleRate;
+
+        std::vector<float> source(static_cast<size_t>(length));
+        std::vector<double> positions(static_cast<size_t>(length));
+        std::vector<float> output(static_cast<size_t>(length));
+
+        for (int i = 0; i < length; ++i)
+        {
+            source[static_cast<size_t>(i)] = static_cast<float>(std::sin(omega * i));
+            positions[static_cast<size_t>(i)] = juce::jmax(static_cast<double>(ChorusInterpolators::maxPointsBefore),
+                                                           i - getSweptDelay(i));
+        }
+
+        float state = 0.0f;
+        interpolateSweep(interpolation, source.data(), positions.data(), output.data(), length, state);
+
+        double errorPower = 0.0;
+        double signalPower = 0.0;
+
+        for (int i = settleSamples; i < length; ++i)
+        {
+            const double expected = std::sin(omega * positions[static_cast<size_t>(i)]);
+            const double error = output[static_cast<size_t>(i)] - expected;
+            errorPower += error * error;
+            signalPower += expected * expected;
+        }
+
+        return 10.0 * std::log10(juce::jmax(errorPower, 1.0e-30) / signalPower);
+    }
+
+    // One chorus tap's worth of reads per sample, timed alone
+    class ChorusInterpolationFixture : public BenchmarkFixture
+    {
+    public:
+        ChorusInterpolationFixture(int blockSize, ChorusInterpolation interpolationToUse)
+            : interpolation(interpolationToUse),
+              source(static_cast<size_t>(blockSize + 64)),
+              positions(static_cast<size_t>(blockSize)),
+              output(static_cast<size_t>(blockSize))
+        {
+            juce::AudioBuffer<float> signal(1, static_cast<int>(source.size()));
+            fillTestSignal(signal, kernelSampleRate);
+            std::copy(signal.getReadPointer(0), signal.getReadPointer(0) + signal.getNumSamples(), source.begin());
+
+            for (int i = 0; i < blockSize; ++i)
+                positions[static_cast<size_t>(i)] = 56.0 + i - getSweptDelay(i * 97);  // Fractions all over
+
+            // Quality, measured once up front
+            thdN1k = measureDistortion(interpolation, 1000.0);
+            thdN10k = measureDistortion(interpolation, 10000.0);
+        }
+
+        void run() override
+        {
+            interpolateSweep(interpolation, source.data(), positions.data(), output.data(),
+                             static_cast<int>(output.size()), state);
+        }
+
+        void getCounters(juce::NamedValueSet& counters) const override
+        {
+            counters.set("thd_n_db_1k", thdN1k);
+            counters.set("thd_n_db_10k", thdN10k);
+        }
+
+    private:
+        const ChorusInterpolation interpolation;
+        std::vector<float> source;
+        std::vector<double> positions;
+        std::vector<float> output;
+        float state = 0.0f;
+        double thdN1k = 0.0;
+        double thdN10k = 0.0;
+    };
+}
+
+void DspBenchmarks::registerKernelBenchmarks(BenchmarkRunner& runner)
+{
+    for (const int blockSize : blockSizes)
+    {
+        for (const int numChannels : channelCounts)
+        {
+            runner.add(makeName("EQ", "CascadedBiquad/sections:5", blockSize, kernelSampleRate, numChannels), blockSize,
+                       [=] { return std::make_unique<CascadedBiquadFixture>(blockSize, kernelSampleRate, numChannels); });
+
+            runner.add(makeName("EQ", "ProcessorDuplicator/sections:5", blockSize, kernelSampleRate, numChannels), blockSize,
+                       [=] { return std::make_unique<DuplicatorChainFixture>(blockSize, kernelSampleRate, numChannels); });
+        }
+    }
+
+    for (const int blockSize : blockSizes)
+    {
+        for (const auto path : { WaveshaperPath::reference, WaveshaperPath::kernel })
+        {
+            runner.add(makeName("Waveshaper/softClip", getPathName(path), blockSize, kernelSampleRate, 1), blockSize,
+                       [=] { return std::make_unique<WaveshaperFixture>(blockSize, false, path); });
+        }
+
+        for (const auto path : { WaveshaperPath::reference, WaveshaperPath::kernel, WaveshaperPath::table })
+        {
+            runner.add(makeName("Waveshaper/ampStages", getPathName(path), blockSize, kernelSampleRate, 1), blockSize,
+                       [=] { return std::make_unique<WaveshaperFixture>(blockSize, true, path); });
+        }
+    }
+
+    for (const int blockSize : blockSizes)
+    {
+        for (const auto interpolation : { ChorusInterpolation::Linear, ChorusInterpolation::Hermite,
+                                          ChorusInterpolation::Lagrange, ChorusInterpolation::Allpass,
+                                          ChorusInterpolation::Sinc })
+        {
+            runner.add(makeName("ChorusInterpolation", ChorusInterpolators::getName(interpolation), blockSize, kernelSampleRate, 1),
+                       blockSize, [=] { return std::make_unique<ChorusInterpolationFixture>(blockSize, interpolation); });
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#include <JuceHeader.h>
+#include "DspBenchmarks.h"
+
+/**
+ * dsp_benchmarks - ns/sample for every engine's processBlock
+ *
+ *   dsp_benchmarks                                  all benchmarks, console table
+ *   dsp_benchmarks --benchmark_filter=AmpSimDSP/    only matching names (regex)
+ *   dsp_benchmarks --benchmark_out=results.json     also write Google Benchmark JSON
+ *   dsp_benchmarks --benchmark_format=json          JSON to stdout instead of the table
+ *   dsp_benchmarks --benchmark_min_time=0.5         seconds per benchmark (default 0.1)
+ *   dsp_benchmarks --benchmark_list_tests           names only
+ *
+ * Build in Release - Debug numbers say nothing about the plugins.
+ */
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    // The cabinet loader posts clean-up to the message thread. Nothing runs
+    // the loop here - the manager just has to exist.
+    juce::MessageManager::getInstance();
+
+    BenchmarkRunner runner;
+    DspBenchmarks::registerEngineBenchmarks(runner);
+    DspBenchmarks::registerKernelBenchmarks(runner);
+
+    const int exitCode = runner.run(BenchmarkRunner::parseOptions(args));
+
+    juce::DeletedAtShutdown::deleteAll();
+    juce::MessageManager::deleteInstance();
+
+    return exitCode;
+}
@@ -0,0 +1,188 @@
+#include "BucketBrigadeDelay.h"
+
+namespace
+{
+    // std::complex operator* goes through the NaN/inf-safe library path
+    // without fast-math, which is far too slow per tick
+    inline std::complex<float> multiply(std::complex<float> a, std::complex<float> b)
+    {
+        return { a.real() * b.real() - a.imag() * b.imag(),
+                 a.real() * b.imag() + a.imag() * b.real() };
+    }
+}
+
+void BucketBrigadeDelay::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    // Butterworth poles at the cutoff, 4th order: angles 5pi/8 and 7pi/8, plus conjugates
+    const double cutoff = juce::MathConstants<double>::twoPi * juce::jmin(filterCutoffHz, 0.45 * sampleRate);
+    std::array<std::complex<double>, numPoles * 2> allPoles;
+
+    for (int k = 0; k < numPoles * 2; ++k)
+        allPoles[static_cast<size_t>(k)] = std::polar(cutoff, juce::MathConstants<double>::pi * (5 + 2 * k) / 8.0);
+
+    double dc = 0.0;
+
+    for (int k = 0; k < numPoles; ++k)
+    {
+        // Residue of cutoff^4 / prod(s - p) at this pole
+        const auto pole = allPoles[static_cast<size_t>(k)];
+        std::complex<double> denominator = 1.0;
+
+        for (int j = 0; j < numPoles * 2; ++j)
+            if (j != k)
+                denominator *= pole - allPoles[static_cast<size_t>(j)];
+
+        const auto residue = std::pow(cutoff, 4.0) / denominator;
+        dc -= 2.0 * (residue / pole).real();
+
+        // Time in samples from here on, so the residue and 1/p carry the sample period
+        const auto polePerSample = pole / sampleRate;
+        residues[static_cast<size_t>(k)] = Complex(2.0f * static_cast<float>((residue / sampleRate).real()),
+                                                   2.0f * static_cast<float>((residue / sampleRate).imag()));
+        const auto inversePole = 1.0 / polePerSample;
+        inversePoles[static_cast<size_t>(k)] = Complex(static_cast<float>(inversePole.real()), static_cast<float>(inversePole.imag()));
+        poles[static_cast<size_t>(k)] = polePerSample.real();
+        poleFrequencies[static_cast<size_t>(k)] = polePerSample.imag();
+        sampleDecay[static_cast<size_t>(k)] = getPoleExp(k, 1.0);
+        sampleGrowth[static_cast<size_t>(k)] = getPoleExp(k, -1.0);
+    }
+
+    dcGain = static_cast<float>(dc);
+    compandCoeff = 1.0f - std::exp(-1.0f / (compandSeconds * static_cast<float>(sampleRate)));
+
+    reset();
+}
+
+void BucketBrigadeDelay::reset()
+{
+    inputState.fill({});
+    lastInput = 0.0f;
+    compressorEnvelope = 0.0f;
+
+    for (auto& voice : voices)
+    {
+        voice.buckets.fill(0.0f);
+        voice.position = 0;
+        voice.heldOutput = 0.0f;
+        voice.outputState.fill({});
+        voice.expanderEnvelope = 0.0f;
+        voice.tickTime = 0.0;
+        resetPhasors(voice);
+    }
+}
+
+BucketBrigadeDelay::Complex BucketBrigadeDelay::getPoleExp(int pole, double samples) const
+{
+    const auto value = std::exp(std::complex<double>(poles[static_cast<size_t>(pole)],
+                                                     poleFrequencies[static_cast<size_t>(pole)]) * samples);
+    return { static_cast<float>(value.real()), static_cast<float>(value.imag()) };
+}
+
+void BucketBrigadeDelay::resetPhasors(Voice& voice) const
+{
+    // Exact again, so rounding in the stepped phasors never builds up
+    for (int k = 0; k < numPoles; ++k)
+    {
+        voice.inputPhasor[static_cast<size_t>(k)] = getPoleExp(k, voice.tickTime);
+        voice.outputPhasor[static_cast<size_t>(k)] = getPoleExp(k, 1.0 - voice.tickTime);
+        voice.inputStep[static_cast<size_t>(k)] = getPoleExp(k, voice.tickInterval);
+        voice.outputStep[static_cast<size_t>(k)] = getPoleExp(k, -voice.tickInterval);
+    }
+}
+
+void BucketBrigadeDelay::setDelays(const float* delaySamples, int numVoices)
+{
+    numActiveVoices = juce::jlimit(1, maxVoices, numVoices);
+
+    for (int v = 0; v < numActiveVoices; ++v)
+    {
+        // The clock that gets a sample through every bucket in the delay time
+        auto& voice = voices[static_cast<size_t>(v)];
+        voice.tickInterval = juce::jmax(1.0e-3, static_cast<double>(delaySamples[v]) / numBuckets);
+        resetPhasors(voice);
+    }
+}
+
+void BucketBrigadeDelay::process(const float* input, float* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // 2:1 compressor into the BBD
+        compressorEnvelope += compandCoeff * (std::abs(input[i]) - compressorEnvelope);
+        const float compressed = input[i] / std::sqrt(compressorEnvelope + compandFloor);
+
+        // Input is held for the sample period; its step moves the filter's shifted state
+        for (int k = 0; k < numPoles; ++k)
+            inputState[static_cast<size_t>(k)] += (compressed - lastInput) * inversePoles[static_cast<size_t>(k)];
+
+        lastInput = compressed;
+        float wet = 0.0f;
+
+        for (int v = 0; v < numActiveVoices; ++v)
+        {
+            auto& voice = voices[static_cast<size_t>(v)];
+
+            // Output filter state on to the end of this sample period; ticks add their steps from when they happened
+            for (int k = 0; k < numPoles; ++k)
+                voice.outputState[static_cast<size_t>(k)] = multiply(voice.outputState[static_cast<size_t>(k)],
+                                                                     sampleDecay[static_cast<size_t>(k)]);
+
+            while (voice.tickTime < 1.0)
+            {
+                // Anti-aliasing filter output at the tick
+                float filtered = dcGain * compressed;
+
+                for (int k = 0; k < numPoles; ++k)
+                    filtered += multiply(multiply(residues[static_cast<size_t>(k)], inputState[static_cast<size_t>(k)]),
+                                         voice.inputPhasor[static_cast<size_t>(k)]).real();
+
+                // One bucket out, one in
+                float& bucket = voice.buckets[static_cast<size_t>(voice.position)];
+                const float step = bucket - voice.heldOutput;
+                voice.heldOutput = bucket;
+                bucket = filtered;
+                voice.position = (voice.position + 1) & (numBuckets - 1);
+
+                for (int k = 0; k < numPoles; ++k)
+                {
+                    voice.outputState[static_cast<size_t>(k)] += step * multiply(inversePoles[static_cast<size_t>(k)],
+                                                                           voice.outputPhasor[static_cast<size_t>(k)]);
+                    voice.inputPhasor[static_cast<size_t>(k)] = multiply(voice.inputPhasor[static_cast<size_t>(k)],
+                                                                         voice.inputStep[static_cast<size_t>(k)]);
+                    voice.outputPhasor[static_cast<size_t>(k)] = multiply(voice.outputPhasor[static_cast<size_t>(k)],
+                                                                          voice.outputStep[static_cast<size_t>(k)]);
+                }
+
+                voice.tickTime += voice.tickInterval;
+            }
+
+            // Tick times are kept relative to the latest sample
+            voice.tickTime -= 1.0;
+
+            for (int k = 0; k < numPoles; ++k)
+            {
+                voice.inputPhasor[static_cast<size_t>(k)] = multiply(voice.inputPhasor[static_cast<size_t>(k)],
+                                                                     sampleGrowth[static_cast<size_t>(k)]);
+                voice.outputPhasor[static_cast<size_t>(k)] = multiply(voice.outputPhasor[static_cast<size_t>(k)],
+                                                                      sampleDecay[static_cast<size_t>(k)]);
+            }
+
+            // Anti-imaging filter output
+            float filtered = dcGain * voice.heldOutput;
+
+            for (int k = 0; k < numPoles; ++k)
+                filtered += multiply(residues[static_cast<size_t>(k)], voice.outputState[static_cast<size_t>(k)]).real();
+
+            // 1:2 expander undoes the compressor, a delay late
+            voice.expanderEnvelope += compandCoeff * (std::abs(filtered) - voice.expanderEnvelope);
+            wet += filtered * voice.expanderEnvelope;
+        }
+
+        for (int k = 0; k < numPoles; ++k)
+            inputState[static_cast<size_t>(k)] = multiply(inputState[static_cast<size_t>(k)], sampleDecay[static_cast<size_t>(k)]);
+
+        output[i] = wet;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * BucketBrigadeDelay - Analog BBD chorus delay for one channel
+ *
+ * Models the JC-120's bucket-brigade path: a 2:1 compressor, an
+ * anti-aliasing lowpass, a 512-stage BBD clocked at whatever rate gives
+ * the wanted delay, an anti-imaging lowpass, and the matching 1:2
+ * expander. Each voice is its own BBD with its own clock, output filter and
+ * expander; they share the channel's compressor and input filter.
+ *
+ * Nothing runs at the clock rate. Following Holters & Parker's BBD model,
+ * both filters are fourth-order Butterworth lowpasses split into partial
+ * fractions - one complex one-pole per conjugate pair - stepped once per
+ * host sample. A clock tick is an event between two samples: it reads the
+ * input filter at the exact tick time, moves one bucket, and feeds the
+ * output's step into the output filter with the decay it would have had
+ * by the end of the sample. The tick time's exponentials are phasors
+ * stepped by multiplication, so a tick is a handful of complex
+ * multiply-adds. Cost follows the clock rate (longer delays tick less),
+ * not the host rate, and clocks slower than twice the filter cutoff alias
+ * just like the hardware.
+ */
+class BucketBrigadeDelay
+{
+public:
+    static constexpr int maxVoices = 8;
+    static constexpr int numStages = 512;                 // MN3002-style: two stages per clock
+    static constexpr int numBuckets = numStages / 2;      // Samples held at once
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // Clock each voice for a delay in samples; call once per chunk, before process()
+    void setDelays(const float* delaySamples, int numVoices);
+
+    // Writes the voices' summed wet signal
+    void process(const float* input, float* output, int numSamples);
+
+private:
+    using Complex = std::complex<float>;
+    static constexpr int numPoles = 2;                    // Upper half-plane poles of the 4th-order Butterworth
+
+    static constexpr double filterCutoffHz = 8000.0;
+    static constexpr float compandSeconds = 0.01f;
+    static constexpr float compandFloor = 1.0e-4f;        // -80 dB: caps the compressor's gain
+
+    double currentSampleRate = 44100.0;
+
+    // Filter: poles, doubled residues (the conjugate half is the real part), and
+    // per-sample decay, shared by the input and output sides
+    std::array<Complex, numPoles> residues {};
+    std::array<Complex, numPoles> inversePoles {};
+    std::array<Complex, numPoles> sampleDecay {};         // e^(pT)
+    std::array<Complex, numPoles> sampleGrowth {};        // e^(-pT)
+    std::array<double, numPoles> poles {};                // Real and
+    std::array<double, numPoles> poleFrequencies {};      // imaginary parts, rad/sample
+    float dcGain = 1.0f;
+
+    // Input side: filter state just after the latest input sample, and that sample
+    std::array<Complex, numPoles> inputState {};
+    float lastInput = 0.0f;
+
+    struct Voice
+    {
+        std::array<float, numBuckets> buckets {};
+        int position = 0;
+        float heldOutput = 0.0f;
+        std::array<Complex, numPoles> outputState {};    // Anti-imaging filter
+        float expanderEnvelope = 0.0f;
+
+        double tickTime = 0.0;                            // Next tick, in samples from the previous sample
+        double tickInterval = 1.0;
+        std::array<Complex, numPoles> inputPhasor {};     // e^(p * tickTime)
+        std::array<Complex, numPoles> outputPhasor {};    // e^(p * (1 - tickTime))
+        std::array<Complex, numPoles> inputStep {};       // e^(p * tickInterval)
+        std::array<Complex, numPoles> outputStep {};      // e^(-p * tickInterval)
+    };
+
+    std::array<Voice, maxVoices> voices;
+    int numActiveVoices = 1;
+
+    // Compander
+    float compressorEnvelope = 0.0f;
+    float compandCoeff = 0.0f;
+
+    Complex getPoleExp(int pole, double samples) const;
+    void resetPhasors(Voice& voice) const;
+};
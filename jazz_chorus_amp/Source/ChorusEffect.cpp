@@ -14,25 +14,51 @@ void ChorusEffect::prepare(double sampleRate, int samplesPerBlock, int numChanne
 
     currentSampleRate = sampleRate;
 
-    // Allocate delay buffer (need enough for longest delay time)
-    delayBuffer.setSize(numChannels, maxDelayBufferSize);
-    delayBuffer.clear();
+    // Longest delay, the interpolator's window around it and a chunk written ahead of the reads
+    const int maxDelaySamples = static_cast<int>(std::ceil(maximumDelayMs * 0.001 * sampleRate));
+    delayBufferSize = juce::nextPowerOfTwo(maxDelaySamples + ChorusInterpolators::guardSamples + maxChunkSize);
+    delayBufferMask = delayBufferSize - 1;
+
+    // Channels a whole number of cache lines apart, from an aligned start
+    const int channelSize = delayBufferSize + ChorusInterpolators::guardSamples;
+    delayChannelStride = (channelSize + cacheLineFloats - 1) / cacheLineFloats * cacheLineFloats;
+    numDelayChannels = numChannels;
+    delayStorage.assign(static_cast<size_t>(delayChannelStride * numChannels + cacheLineFloats), 0.0f);
+
+    const auto address = reinterpret_cast<std::uintptr_t>(delayStorage.data()) / sizeof(float);
+    delayStorageOffset = static_cast<int>((cacheLineFloats - address % cacheLineFloats) % cacheLineFloats);
     delayBufferWritePos = 0;
+    allpassStates.assign(static_cast<size_t>(numChannels * maxVoices), 0.0f);
+    sincRows = ChorusInterpolators::getSincTable().rows.data();
+
+    bucketBrigades.resize(static_cast<size_t>(numChannels));
+
+    for (auto& bbd : bucketBrigades)
+        bbd.prepare(sampleRate);
 
     // Setup smoothing (20ms ramp time to prevent clicks)
     smoothedRate.reset(sampleRate, 0.02);
     smoothedDepth.reset(sampleRate, 0.02);
     smoothedMix.reset(sampleRate, 0.02);
 
-    updateLFOIncrement();
+    smoothedRate.setCurrentAndTargetValue(rate);
+    smoothedDepth.setCurrentAndTargetValue(depth);
+    smoothedMix.setCurrentAndTargetValue(mix);
+
     reset();
 }
 
 void ChorusEffect::reset()
 {
-    delayBuffer.clear();
+    std::fill(delayStorage.begin(), delayStorage.end(), 0.0f);
     delayBufferWritePos = 0;
-    lfoPhase = 0.0f;
+    lfoSin = 0.0f;
+    lfoCos = 1.0f;
+
+    std::fill(allpassStates.begin(), allpassStates.end(), 0.0f);
+
+    for (auto& bbd : bucketBrigades)
+        bbd.reset();
 }
 
 void ChorusEffect::processBlock(juce::AudioBuffer<float>& buffer)
@@ -41,103 +67,293 @@ void ChorusEffect::processBlock(juce::AudioBuffer<float>& buffer)
         return;
 
     const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numDelayChannels);
 
     // Update smoothed parameter values
     smoothedRate.setTargetValue(rate);
     smoothedDepth.setTargetValue(depth);
     smoothedMix.setTargetValue(mix);
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    if (voices != activeVoices)
+        updateVoiceTaps();
+
+    // The allpass starts from silence rather than whatever it last held
+    if (interpolation != activeInterpolation)
     {
-        // Get current smoothed values
-        float currentRate = smoothedRate.getNextValue();
-        float currentDepth = smoothedDepth.getNextValue();
-        float currentMix = smoothedMix.getNextValue();
-
-        // Update LFO
-        updateLFOIncrement();
-        lfoPhase += lfoPhaseIncrement;
-        if (lfoPhase >= 1.0f)
-            lfoPhase -= 1.0f;
-
-        // Process each channel with slightly different LFO phase for stereo width
-        for (int channel = 0; channel < numChannels; ++channel)
-        {
-            float* channelData = buffer.getWritePointer(channel);
-            float* delayData = delayBuffer.getWritePointer(channel);
+        activeInterpolation = interpolation;
+        std::fill(allpassStates.begin(), allpassStates.end(), 0.0f);
+    }
 
-            // Dry signal
-            float inputSample = channelData[sample];
+    // Likewise the BBDs, which haven't been clocked while off
+    if (bucketBrigade != activeBucketBrigade)
+    {
+        activeBucketBrigade = bucketBrigade;
 
-            // Write to delay buffer
-            delayData[delayBufferWritePos] = inputSample;
+        for (auto& bbd : bucketBrigades)
+            bbd.reset();
+    }
 
-            // Calculate modulated delay time
-            // Base delay: ~5ms, modulation depth: ±3ms
-            float lfoPhaseOffset = (channel == 1) ? 0.5f : 0.0f; // 180° phase difference for stereo
-            float lfoSample = getLFOSample(lfoPhase + lfoPhaseOffset);
+    // Base delay: ~5ms (spread across ensemble voices), modulation depth: ±3ms
+    const float samplesPerMs = 0.001f * static_cast<float>(currentSampleRate);
+    const float maxModulationSamples = maxModulationMs * samplesPerMs;
 
-            float baseDelayMs = 5.0f;
-            float modulationMs = 3.0f * currentDepth;
-            float delayMs = baseDelayMs + (lfoSample * modulationMs);
-            float delaySamples = (delayMs / 1000.0f) * currentSampleRate;
+    // Taps add up roughly as uncorrelated signals
+    const float tapGain = 1.0f / std::sqrt(static_cast<float>(activeVoices));
 
-            // Get delayed sample with interpolation
-            float delayedSample = getInterpolatedSample(channel, delaySamples);
+    for (int start = 0; start < numSamples; start += maxChunkSize)
+    {
+        const int chunkSize = juce::jmin(maxChunkSize, numSamples - start);
+
+        // Parameters step once per chunk
+        const float currentRate = smoothedRate.skip(chunkSize);
+        const float currentDepth = smoothedDepth.skip(chunkSize);
+        const float currentMix = smoothedMix.skip(chunkSize);
+
+        generateLFO(currentRate, chunkSize);
+
+        // Modulation depth in samples; the right channel runs 180° from the left for stereo width
+        const float modulation = maxModulationSamples * currentDepth;
+
+        for (int firstChannel = 0; firstChannel < numChannels; firstChannel += channelsPerPass)
+        {
+            const int passChannels = juce::jmin(channelsPerPass, numChannels - firstChannel);
+
+            // Write the dry chunk first - every read lands at or before its own sample
+            for (int c = 0; c < passChannels; ++c)
+                writeToDelay(firstChannel + c, buffer.getReadPointer(firstChannel + c, start), chunkSize);
+
+            updatePassTaps(firstChannel, passChannels, modulation, samplesPerMs);
+
+            if (activeBucketBrigade)
+            {
+                // Each voice's clock for the middle of the chunk
+                const auto middle = static_cast<size_t>(chunkSize / 2);
+
+                for (int c = 0; c < passChannels; ++c)
+                {
+                    for (int voice = 0; voice < activeVoices; ++voice)
+                    {
+                        const auto t = static_cast<size_t>(voice * passChannels + c);
+                        chunkDelays[static_cast<size_t>(voice)] = tapBaseDelays[t] + lfoSinBuffer[middle] * tapSinWeights[t]
+                                                                                   + lfoCosBuffer[middle] * tapCosWeights[t];
+                    }
+
+                    auto& bbd = bucketBrigades[static_cast<size_t>(firstChannel + c)];
+                    bbd.setDelays(chunkDelays.data(), activeVoices);
+                    bbd.process(buffer.getReadPointer(firstChannel + c, start), wetBuffers[static_cast<size_t>(c)].data(), chunkSize);
+                }
+            }
+            else
+            {
+                readTaps(firstChannel, passChannels, chunkSize);
+            }
 
             // Mix dry and wet signals
-            float outputSample = inputSample * (1.0f - currentMix) + delayedSample * currentMix;
-            channelData[sample] = outputSample;
+            for (int c = 0; c < passChannels; ++c)
+            {
+                float* channelData = buffer.getWritePointer(firstChannel + c, start);
+                juce::FloatVectorOperations::multiply(channelData, 1.0f - currentMix, chunkSize);
+                juce::FloatVectorOperations::addWithMultiply(channelData, wetBuffers[static_cast<size_t>(c)].data(),
+                                                             currentMix * tapGain, chunkSize);
+            }
         }
 
         // Advance write position
-        delayBufferWritePos++;
-        if (delayBufferWritePos >= maxDelayBufferSize)
-            delayBufferWritePos = 0;
+        delayBufferWritePos = (delayBufferWritePos + chunkSize) & delayBufferMask;
     }
 }
 
-void ChorusEffect::updateLFOIncrement()
+void ChorusEffect::generateLFO(float rateValue, int numSamples)
 {
-    // Convert rate (0-1) to frequency (0.1Hz - 5Hz)
-    float lfoFreq = 0.1f + (rate * 4.9f);
-    lfoPhaseIncrement = lfoFreq / static_cast<float>(currentSampleRate);
+    // Convert rate (0-1) to frequency (0.1Hz - 5Hz); the only trig per chunk
+    const float lfoFreq = 0.1f + (rateValue * 4.9f);
+    const float increment = juce::MathConstants<float>::twoPi * lfoFreq / static_cast<float>(currentSampleRate);
+    const float rotateCos = std::cos(increment);
+    const float rotateSin = std::sin(increment);
+
+    float c = lfoCos;
+    float s = lfoSin;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float nextCos = c * rotateCos - s * rotateSin;
+        s = s * rotateCos + c * rotateSin;
+        c = nextCos;
+        lfoSinBuffer[static_cast<size_t>(i)] = s;
+        lfoCosBuffer[static_cast<size_t>(i)] = c;
+    }
+
+    // Rounding slowly changes the amplitude - pull it back to 1
+    const float correction = 1.5f - 0.5f * (c * c + s * s);
+    lfoCos = c * correction;
+    lfoSin = s * correction;
 }
 
-float ChorusEffect::getLFOSample(float phase)
+void ChorusEffect::writeToDelay(int channel, const float* input, int numSamples)
 {
-    // Sine wave LFO (smooth modulation)
-    while (phase >= 1.0f)
-        phase -= 1.0f;
-    while (phase < 0.0f)
-        phase += 1.0f;
+    float* delayData = getDelayLine(channel);
+    const int first = juce::jmin(numSamples, delayBufferSize - delayBufferWritePos);
+
+    juce::FloatVectorOperations::copy(delayData + delayBufferWritePos, input, first);
+
+    if (numSamples > first)
+        juce::FloatVectorOperations::copy(delayData, input + first, numSamples - first);
+
+    juce::FloatVectorOperations::copy(delayData + delayBufferSize, delayData, ChorusInterpolators::guardSamples);
+}
+
+void ChorusEffect::updatePassTaps(int firstChannel, int passChannels, float modulation, float samplesPerMs)
+{
+    numPassTaps = activeVoices * passChannels;
+
+    for (int voice = 0; voice < activeVoices; ++voice)
+    {
+        const auto& tap = voiceTaps[static_cast<size_t>(voice)];
 
-    return std::sin(phase * 2.0f * juce::MathConstants<float>::pi);
+        for (int c = 0; c < passChannels; ++c)
+        {
+            const int channel = firstChannel + c;
+            const float channelModulation = channel == 1 ? -modulation : modulation;
+            const auto t = static_cast<size_t>(voice * passChannels + c);
+
+            tapBaseDelays[t] = tap.baseDelayMs * samplesPerMs;
+            tapSinWeights[t] = channelModulation * tap.sinWeight;
+            tapCosWeights[t] = channelModulation * tap.cosWeight;
+            tapOffsets[t] = channel * delayChannelStride;
+        }
+    }
 }
 
-float ChorusEffect::getInterpolatedSample(int channel, float delayInSamples)
+void ChorusEffect::readTaps(int firstChannel, int passChannels, int numSamples)
 {
-    // Calculate read position (write position minus delay)
-    float readPos = delayBufferWritePos - delayInSamples;
+    using namespace ChorusInterpolators;
 
-    // Wrap around if necessary
-    while (readPos < 0.0f)
-        readPos += maxDelayBufferSize;
-    while (readPos >= maxDelayBufferSize)
-        readPos -= maxDelayBufferSize;
+    switch (activeInterpolation)
+    {
+        case ChorusInterpolation::Linear:   readTaps(firstChannel, passChannels, numSamples, Linear {}); break;
+        case ChorusInterpolation::Hermite:  readTaps(firstChannel, passChannels, numSamples, Hermite {}); break;
+        case ChorusInterpolation::Lagrange: readTaps(firstChannel, passChannels, numSamples, Lagrange {}); break;
+        case ChorusInterpolation::Allpass:  readTaps(firstChannel, passChannels, numSamples, Allpass {}); break;
+        case ChorusInterpolation::Sinc:     readTaps(firstChannel, passChannels, numSamples, Sinc { sincRows }); break;
+    }
+}
+
+template <typename Interpolator>
+void ChorusEffect::readTaps(int firstChannel, int passChannels, int numSamples, Interpolator interpolate)
+{
+    using namespace ChorusInterpolators;
 
-    // Linear interpolation between two samples
-    int readPosInt = static_cast<int>(readPos);
-    float frac = readPos - readPosInt;
+    constexpr int before = Interpolator::pointsBefore;
+    constexpr int after = Interpolator::pointsAfter;
+    constexpr int windowSize = maxPointsBefore + maxPointsAfter + 1;
 
-    int nextReadPos = (readPosInt + 1) % maxDelayBufferSize;
+    const float* delayData = delayStorage.data() + delayStorageOffset;
+    float* states = allpassStates.data() + firstChannel * maxVoices;
+    float* sums = tapSums.data();
 
-    float* delayData = delayBuffer.getReadPointer(channel);
-    float sample1 = delayData[readPosInt];
-    float sample2 = delayData[nextReadPos];
+    std::fill(sums, sums + numSamples * lanes, 0.0f);
 
-    return sample1 + frac * (sample2 - sample1);
+    // A register of taps at a time; spare lanes in the last one repeat its first tap, silenced
+    for (int first = 0; first < numPassTaps; first += lanes)
+    {
+        alignas(32) float bases[lanes];
+        alignas(32) float sinWeights[lanes];
+        alignas(32) float cosWeights[lanes];
+        alignas(32) float gains[lanes];
+        alignas(32) float laneStates[lanes];
+        alignas(32) float wholes[lanes];
+        alignas(32) float points[windowSize * lanes];
+        int offsets[lanes];
+
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const bool used = first + lane < numPassTaps;
+            const auto tap = static_cast<size_t>(used ? first + lane : first);
+            bases[lane] = tapBaseDelays[tap];
+            sinWeights[lane] = tapSinWeights[tap];
+            cosWeights[lane] = tapCosWeights[tap];
+            offsets[lane] = tapOffsets[tap];
+            gains[lane] = used ? 1.0f : 0.0f;
+            laneStates[lane] = used ? states[first + lane] : 0.0f;
+        }
+
+        const Vec base = load(bases);
+        const Vec sinWeight = load(sinWeights);
+        const Vec cosWeight = load(cosWeights);
+        const Vec gain = load(gains);
+        Vec state = load(laneStates);
+        Vec window[windowSize];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Positions stay integers: a float write position only resolves a fraction of a
+            // sample once the line is long (384 kHz flanger), so the fraction comes from the
+            // delay itself. Reading from the sample before puts frac in (0, 1].
+            const Vec delay = base + sinWeight * lfoSinBuffer[static_cast<size_t>(i)]
+                                   + cosWeight * lfoCosBuffer[static_cast<size_t>(i)];
+            const Vec whole = truncate(delay);
+            const Vec frac = whole - delay + 1.0f;
+            const int writeIndex = delayBufferWritePos + i;
+            store(whole, wholes);
+
+            // The loads are the only per-tap step: the kernel's window starts maxPointsBefore
+            // back and the guard samples cover its end; the mask also wraps positions before
+            // the start of the line
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const int readPosInt = writeIndex - static_cast<int>(wholes[lane]) - 1;
+                const float* x = delayData + offsets[lane] + ((readPosInt - maxPointsBefore) & delayBufferMask) + maxPointsBefore;
+
+                for (int k = -before; k <= after; ++k)
+                    points[(maxPointsBefore + k) * lanes + lane] = x[k];
+            }
+
+            for (int k = -before; k <= after; ++k)
+                window[maxPointsBefore + k] = load(points + (maxPointsBefore + k) * lanes);
+
+            float* sum = sums + i * lanes;
+            store(load(sum) + interpolate(window + maxPointsBefore, frac, state) * gain, sum);
+        }
+
+        store(state, laneStates);
+
+        for (int lane = 0; lane < lanes && first + lane < numPassTaps; ++lane)
+            states[first + lane] = laneStates[lane];
+    }
+
+    // Lane k of every register holds channel k % passChannels
+    for (int c = 0; c < passChannels; ++c)
+    {
+        float* wet = wetBuffers[static_cast<size_t>(c)].data();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float total = 0.0f;
+
+            for (int lane = c; lane < lanes; lane += passChannels)
+                total += sums[i * lanes + lane];
+
+            wet[i] = total;
+        }
+    }
+}
+
+void ChorusEffect::updateVoiceTaps()
+{
+    activeVoices = voices;
+
+    for (int voice = 0; voice < activeVoices; ++voice)
+    {
+        // Evenly spaced LFO phases: sin(x + offset) = sin(x)cos(offset) + cos(x)sin(offset)
+        const float offset = juce::MathConstants<float>::twoPi * static_cast<float>(voice) / static_cast<float>(activeVoices);
+        auto& tap = voiceTaps[static_cast<size_t>(voice)];
+        tap.sinWeight = std::cos(offset);
+        tap.cosWeight = std::sin(offset);
+
+        // Base delays fanned out ±0.75ms, so the voices don't all comb at the same frequencies
+        tap.baseDelayMs = activeVoices > 1 ? baseDelayMs + voiceSpreadMs * (static_cast<float>(voice) / static_cast<float>(activeVoices - 1) - 0.5f)
+                                           : baseDelayMs;
+    }
 }
 
 // Parameter setters
@@ -160,3 +376,23 @@ void ChorusEffect::setEnabled(bool enabled)
 {
     isEnabled = enabled;
 }
+
+void ChorusEffect::setVoices(int numVoices)
+{
+    voices = juce::jlimit(1, maxVoices, numVoices);
+}
+
+void ChorusEffect::setInterpolation(ChorusInterpolation newInterpolation)
+{
+    interpolation = newInterpolation;
+}
+
+void ChorusEffect::setBucketBrigade(bool enabled)
+{
+    bucketBrigade = enabled;
+}
+
+void ChorusEffect::setMaximumDelay(float milliseconds)
+{
+    maximumDelayMs = juce::jmax(chorusMaxDelayMs, milliseconds);
+}
@@ -1,17 +1,37 @@
 #pragma once
 #include <JuceHeader.h>
+#include "ChorusInterpolation.h"
+#include "BucketBrigadeDelay.h"
 
 /**
  * ChorusEffect - Stereo chorus modulation effect
  *
  * Implements the iconic Jazz Chorus stereo chorus effect:
  * - Dual LFO modulated delay lines
+ * - Ensemble mode: up to maxVoices taps per channel from the same delay line
+ * - Selectable fractional delay interpolation (ChorusInterpolators)
+ * - Optional analog bucket-brigade path (BucketBrigadeDelay) in place of the
+ *   digital delay line, clocked per voice from the same delay times
  * - Stereo width control
  * - Rate and depth controls
  * - Warm analog-style modulation
  *
  * The Jazz Chorus chorus is known for its wide, shimmering sound
  * that doesn't sound overly processed.
+ *
+ * Processing runs in chunks of up to maxChunkSize samples. The LFO comes
+ * from a recursive quadrature oscillator, one rotation per sample and no
+ * trig beyond the increment. Its sine and cosine outputs give every voice's
+ * LFO at any phase offset as a weighted sum, so voices are spread evenly
+ * round the cycle (the right channel half a cycle from the left) without
+ * oscillators of their own. Channels go through in pairs: the left and
+ * right taps, interleaved voice by voice, are read a SIMD register at a
+ * time (4 taps with SSE/NEON, 8 with AVX). Each tap's delay, its whole and
+ * fractional read position and the interpolation kernel are worked out for
+ * every lane at once, branch-free; only fetching each lane's few window
+ * samples is per tap. The write and dry/wet mix are FloatVectorOperations
+ * over the chunk. The tap loop is a template over the interpolation
+ * kernel, so the choice costs one switch per chunk rather than one per tap.
  */
 class ChorusEffect
 {
@@ -29,6 +49,19 @@ public:
     void setMix(float mix);             // Dry/wet mix
     void setEnabled(bool enabled);      // Bypass control
 
+    // Ensemble: taps per channel, 1 (classic stereo chorus) to maxVoices
+    static constexpr int maxVoices = 8;
+    void setVoices(int numVoices);
+
+    void setInterpolation(ChorusInterpolation newInterpolation);
+
+    // Analog BBD emulation instead of the digital delay line
+    void setBucketBrigade(bool enabled);
+
+    // Longest delay the line must hold, for wider modulation (flanger, vibrato).
+    // Never less than the chorus itself needs. Not real-time safe: call before prepare().
+    void setMaximumDelay(float milliseconds);
+
 private:
     double currentSampleRate = 44100.0;
     bool isEnabled = true;
@@ -37,15 +70,83 @@ private:
     float rate = 0.5f;
     float depth = 0.5f;
     float mix = 0.5f;
+    int voices = 1;
+    ChorusInterpolation interpolation = ChorusInterpolation::Linear;
+    ChorusInterpolation activeInterpolation = ChorusInterpolation::Linear;
+    bool bucketBrigade = false;
+    bool activeBucketBrigade = false;
+
+    // Delay times: base (fanned out across ensemble voices) plus modulation
+    static constexpr float baseDelayMs = 5.0f;
+    static constexpr float voiceSpreadMs = 1.5f;
+    static constexpr float maxModulationMs = 3.0f;
+    static constexpr float chorusMaxDelayMs = baseDelayMs + 0.5f * voiceSpreadMs + maxModulationMs;
+    float maximumDelayMs = chorusMaxDelayMs;
 
-    // Delay buffer for chorus effect
-    static constexpr int maxDelayBufferSize = 8192;
-    juce::AudioBuffer<float> delayBuffer;
+    // Delay line per channel, sized in prepare() from the sample rate and the
+    // maximum delay: a power of two, so positions wrap with a mask, plus guard
+    // samples copying the first few so interpolation never wraps. Each channel
+    // starts on a cache line - a chorus at 48 kHz is 2 KB per channel, which
+    // stays in L1 alongside everything else.
+    static constexpr int cacheLineFloats = 64 / static_cast<int>(sizeof(float));
+    std::vector<float> delayStorage;
+    int delayBufferSize = 0;
+    int delayBufferMask = 0;
+    int delayChannelStride = 0;
+    int delayStorageOffset = 0;  // Floats to the first aligned one
+    int numDelayChannels = 0;
     int delayBufferWritePos = 0;
 
-    // LFO (Low Frequency Oscillator) for modulation
-    float lfoPhase = 0.0f;
-    float lfoPhaseIncrement = 0.0f;
+    float* getDelayLine(int channel) { return delayStorage.data() + delayStorageOffset + channel * delayChannelStride; }
+
+    // Blocks are processed in chunks; parameters, LFO increment and smoothing
+    // advance once per chunk, and everything per sample is in these buffers
+    static constexpr int maxChunkSize = 64;
+    std::array<float, maxChunkSize> lfoSinBuffer {};
+    std::array<float, maxChunkSize> lfoCosBuffer {};
+
+    // Quadrature LFO: (lfoCos, lfoSin) rotates by the phase increment each sample
+    float lfoSin = 0.0f;
+    float lfoCos = 1.0f;
+
+    // Per voice: weights turning the quadrature pair into that voice's phase, and base delay
+    struct VoiceTap
+    {
+        float sinWeight = 1.0f;
+        float cosWeight = 0.0f;
+        float baseDelayMs = ChorusEffect::baseDelayMs;
+    };
+
+    std::array<VoiceTap, maxVoices> voiceTaps;
+    int activeVoices = 0;
+    void updateVoiceTaps();
+
+    // The taps of the channels in this pass, [voice][channel], for the current chunk.
+    // A tap's delay at sample i is base + lfoSin[i] * sinWeight + lfoCos[i] * cosWeight.
+    // Channels pair up when a register has an even number of lanes, so every lane keeps
+    // to one channel; without SIMD each channel gets a pass to itself.
+    static constexpr int channelsPerPass = ChorusInterpolators::lanes % 2 == 0 ? 2 : 1;
+    static constexpr int maxTaps = maxVoices * channelsPerPass;
+    std::array<float, maxTaps> tapBaseDelays {};      // Samples
+    std::array<float, maxTaps> tapSinWeights {};
+    std::array<float, maxTaps> tapCosWeights {};
+    std::array<int, maxTaps> tapOffsets {};           // The tap's channel in delayStorage
+    int numPassTaps = 0;
+    std::array<std::array<float, maxChunkSize>, channelsPerPass> wetBuffers {};
+    std::array<float, maxChunkSize * ChorusInterpolators::lanes> tapSums {};  // [sample][lane], summed over registers
+
+    void updatePassTaps(int firstChannel, int passChannels, float modulation, float samplesPerMs);
+
+    // Allpass interpolator state per tap: maxTaps for each pass, in tap order
+    std::vector<float> allpassStates;
+
+    // Sinc interpolator coefficients, fetched in prepare() so the table is never built on the audio thread
+    const float* sincRows = nullptr;
+
+    // BBD path, per channel; the clocks follow the taps' delays once per chunk
+    static_assert(BucketBrigadeDelay::maxVoices >= maxVoices, "Every voice needs its own BBD");
+    std::vector<BucketBrigadeDelay> bucketBrigades;
+    std::array<float, maxVoices> chunkDelays {};
 
     // Smoothing filters to prevent zipper noise
     juce::SmoothedValue<float> smoothedRate;
@@ -53,7 +154,10 @@ private:
     juce::SmoothedValue<float> smoothedMix;
 
     // Helper functions
-    void updateLFOIncrement();
-    float getLFOSample(float phase);
-    float getInterpolatedSample(int channel, float delayInSamples);
+    void generateLFO(float rateValue, int numSamples);
+    void writeToDelay(int channel, const float* input, int numSamples);
+    void readTaps(int firstChannel, int passChannels, int numSamples);
+
+    template <typename Interpolator>
+    void readTaps(int firstChannel, int passChannels, int numSamples, Interpolator interpolate);
 };
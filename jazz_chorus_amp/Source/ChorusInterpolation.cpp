@@ -0,0 +1,86 @@
+#include "ChorusInterpolation.h"
+
+namespace ChorusInterpolators
+{
+    namespace
+    {
+        // Zeroth-order modified Bessel function, for the Kaiser window
+        double besselI0(double x)
+        {
+            double sum = 1.0;
+            double term = 1.0;
+
+            for (int k = 1; k < 32; ++k)
+            {
+                term *= (x * 0.5 / k) * (x * 0.5 / k);
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        // Trades passband ripple against how far up the flat response reaches
+        constexpr double kaiserBeta = 7.0;
+    }
+
+    SincTable::SincTable()
+    {
+        const double halfWidth = static_cast<double>(numPoints) * 0.5;
+        std::vector<double> taps(static_cast<size_t>((numPhases + 1) * numPoints));
+
+        for (int phase = 0; phase <= numPhases; ++phase)
+        {
+            const double frac = static_cast<double>(phase) / numPhases;
+            double* row = taps.data() + phase * numPoints;
+            double sum = 0.0;
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                const double t = static_cast<double>(i - maxPointsBefore) - frac;
+                const double x = juce::MathConstants<double>::pi * t;
+                const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+                const double w = juce::jlimit(0.0, 1.0, 1.0 - (t / halfWidth) * (t / halfWidth));
+
+                row[i] = sinc * besselI0(kaiserBeta * std::sqrt(w)) / besselI0(kaiserBeta);
+                sum += row[i];
+            }
+
+            // Unity gain at DC for every fraction
+            for (int i = 0; i < numPoints; ++i)
+                row[i] /= sum;
+        }
+
+        rows.resize(static_cast<size_t>(numPhases * rowSize));
+
+        for (int phase = 0; phase < numPhases; ++phase)
+        {
+            const double* row = taps.data() + phase * numPoints;
+            float* out = rows.data() + phase * rowSize;
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                out[i] = static_cast<float>(row[i]);
+                out[numPoints + i] = static_cast<float>(row[numPoints + i] - row[i]);
+            }
+        }
+    }
+
+    const SincTable& getSincTable()
+    {
+        static const SincTable table;
+        return table;
+    }
+
+    juce::String getName(ChorusInterpolation interpolation)
+    {
+        switch (interpolation)
+        {
+            case ChorusInterpolation::Hermite:  return "hermite";
+            case ChorusInterpolation::Lagrange: return "lagrange";
+            case ChorusInterpolation::Allpass:  return "allpass";
+            case ChorusInterpolation::Sinc:     return "sinc";
+            case ChorusInterpolation::Linear:
+            default:                            return "linear";
+        }
+    }
+}
@@ -0,0 +1,240 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * How ChorusEffect reads between the samples of its delay line
+ */
+enum class ChorusInterpolation
+{
+    Linear,      // 2 points - cheapest, dulls the top end at fractional delays
+    Hermite,     // 4-point cubic Hermite (Catmull-Rom)
+    Lagrange,    // 4-point, third-order Lagrange
+    Allpass,     // First-order allpass - flat magnitude, one state per tap
+    Sinc         // 8-point Kaiser-windowed sinc from a polyphase table
+};
+
+/**
+ * ChorusInterpolators - Fractional delay kernels for ChorusEffect
+ *
+ * Every kernel reads a fixed window of contiguous samples around x[0], the
+ * sample at or before the read position, and frac is how far past it to
+ * read (0 to 1). The window never goes further than maxPointsBefore /
+ * maxPointsAfter, so the delay line keeps that many guard samples and each
+ * read is one unmasked load of a few neighbours, with no wrap test per
+ * point. pointsBefore / pointsAfter say how much of that a kernel uses.
+ *
+ * The kernels are templates over the sample type: float for one tap, or
+ * Vec for a register of taps, one per lane, each lane with its own window
+ * and fraction. They are written so both read the same - no branches, no
+ * division, constants on the right. The FIR kernels are a coefficient
+ * vector dotted with the window.
+ *
+ * The allpass keeps its previous output in state; the others ignore it.
+ */
+namespace ChorusInterpolators
+{
+    constexpr int maxPointsBefore = 3;
+    constexpr int maxPointsAfter = 4;
+    constexpr int guardSamples = maxPointsBefore + maxPointsAfter;
+
+#if JUCE_USE_SIMD
+    // One SIMD register holds the same sample position from several taps
+    using Vec = juce::dsp::SIMDRegister<float>;
+    constexpr int lanes = static_cast<int>(Vec::SIMDNumElements);
+
+    inline Vec broadcast(float value) { return Vec::expand(value); }
+    inline Vec load(const float* source) { return Vec::fromRawArray(source); }
+    inline void store(Vec value, float* destination) { value.copyToRawArray(destination); }
+    inline Vec truncate(Vec value) { return Vec::truncate(value); }
+
+    // 1 where value >= edge, otherwise 0
+    inline Vec stepAt(Vec value, float edge)
+    {
+        return Vec::expand(1.0f) & Vec::greaterThanOrEqual(value, Vec::expand(edge));
+    }
+#else
+    // Scalar fallback - one tap per "register"
+    using Vec = float;
+    constexpr int lanes = 1;
+
+    inline Vec broadcast(float value) { return value; }
+    inline Vec load(const float* source) { return *source; }
+    inline void store(Vec value, float* destination) { *destination = value; }
+#endif
+
+    inline float truncate(float value) { return std::trunc(value); }
+    inline float stepAt(float value, float edge) { return value >= edge ? 1.0f : 0.0f; }
+
+    struct Linear
+    {
+        static constexpr int pointsBefore = 0;
+        static constexpr int pointsAfter = 1;
+
+        template <typename T>
+        T operator()(const T* x, T frac, T&) const
+        {
+            return x[0] + (x[1] - x[0]) * frac;
+        }
+    };
+
+    struct Hermite
+    {
+        static constexpr int pointsBefore = 1;
+        static constexpr int pointsAfter = 2;
+
+        template <typename T>
+        T operator()(const T* x, T frac, T&) const
+        {
+            const T c1 = (x[1] - x[-1]) * 0.5f;
+            const T c2 = x[-1] - x[0] * 2.5f + x[1] * 2.0f - x[2] * 0.5f;
+            const T c3 = (x[2] - x[-1]) * 0.5f + (x[0] - x[1]) * 1.5f;
+
+            return ((c3 * frac + c2) * frac + c1) * frac + x[0];
+        }
+    };
+
+    struct Lagrange
+    {
+        static constexpr int pointsBefore = 1;
+        static constexpr int pointsAfter = 2;
+
+        template <typename T>
+        T operator()(const T* x, T frac, T&) const
+        {
+            // Points at -1, 0, 1 and 2
+            const T dm1 = frac + 1.0f;
+            const T d1 = frac - 1.0f;
+            const T d2 = frac - 2.0f;
+            const T d1d2 = d1 * d2;
+            const T dm1Frac = dm1 * frac;
+
+            return x[-1] * (frac * d1d2 * (-1.0f / 6.0f))
+                 + x[0] * (dm1 * d1d2 * 0.5f)
+                 + x[1] * (dm1Frac * d2 * -0.5f)
+                 + x[2] * (dm1Frac * d1 * (1.0f / 6.0f));
+        }
+    };
+
+    struct Allpass
+    {
+        static constexpr int pointsBefore = 0;
+        static constexpr int pointsAfter = 2;
+
+        template <typename T>
+        T operator()(const T* x, T frac, T& state) const
+        {
+            // Thiran first-order: y = eta * (in - y[n-1]) + in[n-1] delays by d,
+            // with eta = (1 - d) / (1 + d). The pair of points is picked so d
+            // stays between 0.618 and 1.618, away from the pole near d = 0 -
+            // by blending the pairs rather than branching between them.
+            const T upper = stepAt(frac, 0.382f);
+            const T a = frac - upper;
+            const T previous = x[0] + (x[1] - x[0]) * upper;
+            const T input = x[1] + (x[2] - x[1]) * upper;
+
+            state = a * reciprocal(a * -1.0f + 2.0f) * (input - state) + previous;
+            return state;
+        }
+
+    private:
+        static float reciprocal(float value) { return 1.0f / value; }
+
+#if JUCE_USE_SIMD
+        // SIMDRegister has no divide. value is 2 - a, within [1.618, 2.618]: the
+        // chord of 1/x across that range is within 6%, and three Newton steps
+        // take it to float precision.
+        static Vec reciprocal(Vec value)
+        {
+            Vec result = value * -0.236068f + 1.0f;
+
+            for (int step = 0; step < 3; ++step)
+                result = result * (value * result * -1.0f + 2.0f);
+
+            return result;
+        }
+#endif
+    };
+
+    // Windowed sinc coefficients for numPhases fractions (plus one, for frac
+    // close to 1), each row stored as taps then the step to the next row
+    struct SincTable
+    {
+        static constexpr int numPoints = maxPointsBefore + maxPointsAfter + 1;
+        static constexpr int numPhases = 256;
+        static constexpr int rowSize = numPoints * 2;
+
+        std::vector<float> rows;
+
+        SincTable();
+    };
+
+    // Built once per process, on first use - so call it off the audio thread
+    const SincTable& getSincTable();
+
+    struct Sinc
+    {
+        static constexpr int pointsBefore = maxPointsBefore;
+        static constexpr int pointsAfter = maxPointsAfter;
+
+        const float* rows = nullptr;  // getSincTable().rows
+
+        float operator()(const float* x, float frac, float&) const
+        {
+            // Coefficients interpolated between the two nearest phases
+            float blend;
+            const float* row = findRow(frac, blend);
+            const float* window = x - maxPointsBefore;
+
+            float sum = 0.0f;
+
+            for (int i = 0; i < SincTable::numPoints; ++i)
+                sum += (row[i] + blend * row[SincTable::numPoints + i]) * window[i];
+
+            return sum;
+        }
+
+#if JUCE_USE_SIMD
+        // Each lane has its own phase, so the coefficients are gathered lane by lane
+        Vec operator()(const Vec* x, Vec frac, Vec&) const
+        {
+            alignas(32) float fracs[lanes];
+            alignas(32) float blends[lanes];
+            alignas(32) float taps[lanes];
+            alignas(32) float steps[lanes];
+            const float* laneRows[lanes];
+            store(frac, fracs);
+
+            for (int lane = 0; lane < lanes; ++lane)
+                laneRows[lane] = findRow(fracs[lane], blends[lane]);
+
+            const Vec blend = load(blends);
+            const Vec* window = x - maxPointsBefore;
+            Vec sum = broadcast(0.0f);
+
+            for (int i = 0; i < SincTable::numPoints; ++i)
+            {
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    taps[lane] = laneRows[lane][i];
+                    steps[lane] = laneRows[lane][SincTable::numPoints + i];
+                }
+
+                sum = sum + (load(taps) + load(steps) * blend) * window[i];
+            }
+
+            return sum;
+        }
+#endif
+
+    private:
+        const float* findRow(float frac, float& blend) const
+        {
+            const float phase = frac * static_cast<float>(SincTable::numPhases);
+            const int index = juce::jmin(static_cast<int>(phase), SincTable::numPhases - 1);
+            blend = phase - static_cast<float>(index);
+            return rows + index * SincTable::rowSize;
+        }
+    };
+
+    juce::String getName(ChorusInterpolation interpolation);
+}
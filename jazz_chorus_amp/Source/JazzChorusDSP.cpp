@@ -12,32 +12,19 @@ void JazzChorusDSP::prepare(double sampleRate, int samplesPerBlock, int numChann
 {
     currentSampleRate = sampleRate;
 
-    // Prepare all filters with proper spec
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = numChannels;
-
-    bassFilter.prepare(spec);
-    middleFilter.prepare(spec);
-    trebleFilter.prepare(spec);
-    brightFilter.prepare(spec);
+    // Initialize EQ with current parameter values, then prepare it
+    updateFilters();
+    eq.prepare(sampleRate, numChannels);
 
     // Prepare chorus effect
     chorus.prepare(sampleRate, samplesPerBlock, numChannels);
 
-    // Initialize filters with current parameter values
-    updateFilters();
-
     reset();
 }
 
 void JazzChorusDSP::reset()
 {
-    bassFilter.reset();
-    middleFilter.reset();
-    trebleFilter.reset();
-    brightFilter.reset();
+    eq.reset();
     chorus.reset();
 }
 
@@ -48,10 +35,10 @@ void JazzChorusDSP::processBlock(juce::AudioBuffer<float>& buffer)
 
     // Convert to JUCE DSP block for filter processing
     juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
 
     // Calculate gain value
     const float outputGain = volume * volume; // Squared for better taper
+    markLoadStage(setupLoadStage);
 
     // Stage 1: Clean preamp - minimal processing (Jazz Chorus is known for clean headroom)
     for (int channel = 0; channel < numChannels; ++channel)
@@ -69,14 +56,15 @@ void JazzChorusDSP::processBlock(juce::AudioBuffer<float>& buffer)
         }
     }
 
-    // Stage 2: EQ - Bright Jazz Chorus character
-    bassFilter.process(context);
-    middleFilter.process(context);
-    trebleFilter.process(context);
-    brightFilter.process(context);
+    markLoadStage(preampLoadStage);
+
+    // Stage 2: EQ - Bright Jazz Chorus character (all bands in one pass)
+    eq.process(block);
+    markLoadStage(eqLoadStage);
 
     // Stage 3: Chorus effect (the star of the show!)
     chorus.processBlock(buffer);
+    markLoadStage(chorusLoadStage);
 
     // Stage 4: Output volume
     for (int channel = 0; channel < numChannels; ++channel)
@@ -87,35 +75,44 @@ void JazzChorusDSP::processBlock(juce::AudioBuffer<float>& buffer)
             channelData[sample] *= outputGain;
         }
     }
+
+    markLoadStage(outputLoadStage);
+}
+
+juce::StringArray JazzChorusDSP::getLoadStageNames()
+{
+    return { "Setup", "Preamp", "EQ", "Chorus", "Output" };
+}
+
+void JazzChorusDSP::markLoadStage(LoadStage stage)
+{
+    if (loadMonitor != nullptr)
+        loadMonitor->markStage(stage);
 }
 
 void JazzChorusDSP::updateFilters()
 {
-    const double sampleRate = currentSampleRate;
+    // Only sections whose settings actually changed get redesigned
 
     // Bass - Low shelf at 100Hz
     // Range: -12dB to +12dB
-    float bassGainDb = (bass - 0.5f) * 24.0f;
-    *bassFilter.state = *FilterCoefs::makeLowShelf(sampleRate, 100.0, 0.7,
-                                                     juce::Decibels::decibelsToGain(bassGainDb));
+    eq.setSection(bassSection, CascadedBiquad::SectionType::LowShelf, 100.0, 0.7,
+                  (bass - 0.5f) * 24.0f);
 
     // Middle - Peaking filter at 1kHz (clear, clean midrange)
     // Range: -12dB to +12dB
-    float middleGainDb = (middle - 0.5f) * 24.0f;
-    *middleFilter.state = *FilterCoefs::makePeakFilter(sampleRate, 1000.0, 1.0,
-                                                         juce::Decibels::decibelsToGain(middleGainDb));
+    eq.setSection(middleSection, CascadedBiquad::SectionType::Peak, 1000.0, 1.0,
+                  (middle - 0.5f) * 24.0f);
 
     // Treble - High shelf at 4kHz (sparkle and clarity)
     // Range: -12dB to +12dB
-    float trebleGainDb = (treble - 0.5f) * 24.0f;
-    *trebleFilter.state = *FilterCoefs::makeHighShelf(sampleRate, 4000.0, 0.7,
-                                                        juce::Decibels::decibelsToGain(trebleGainDb));
+    eq.setSection(trebleSection, CascadedBiquad::SectionType::HighShelf, 4000.0, 0.7,
+                  (treble - 0.5f) * 24.0f);
 
     // Bright - High shelf at 8kHz (extra sparkle when engaged)
     // Range: 0dB to +8dB
-    float brightGainDb = bright * 8.0f;
-    *brightFilter.state = *FilterCoefs::makeHighShelf(sampleRate, 8000.0, 0.5,
-                                                        juce::Decibels::decibelsToGain(brightGainDb));
+    eq.setSection(brightSection, CascadedBiquad::SectionType::HighShelf, 8000.0, 0.5,
+                  bright * 8.0f);
 }
 
 float JazzChorusDSP::applyCleanSaturation(float input)
@@ -137,6 +134,22 @@ float JazzChorusDSP::applyCleanSaturation(float input)
 }
 
 // Parameter setters
+void JazzChorusDSP::setParameters(const Parameters& parameters)
+{
+    setVolume(parameters.volume);
+    setBass(parameters.bass);
+    setMiddle(parameters.middle);
+    setTreble(parameters.treble);
+    setBright(parameters.bright);
+    setChorusRate(parameters.chorusRate);
+    setChorusDepth(parameters.chorusDepth);
+    setChorusMix(parameters.chorusMix);
+    setChorusEnabled(parameters.chorusEnabled);
+    setChorusVoices(parameters.chorusVoices);
+    setChorusInterpolation(static_cast<ChorusInterpolation>(parameters.chorusInterpolation));
+    setChorusBucketBrigade(parameters.chorusBucketBrigade);
+}
+
 void JazzChorusDSP::setVolume(float volumeValue)
 {
     volume = juce::jlimit(0.0f, 1.0f, volumeValue);
@@ -185,3 +198,18 @@ void JazzChorusDSP::setChorusEnabled(bool enabled)
 {
     chorus.setEnabled(enabled);
 }
+
+void JazzChorusDSP::setChorusVoices(int voices)
+{
+    chorus.setVoices(voices);
+}
+
+void JazzChorusDSP::setChorusInterpolation(ChorusInterpolation interpolation)
+{
+    chorus.setInterpolation(interpolation);
+}
+
+void JazzChorusDSP::setChorusBucketBrigade(bool enabled)
+{
+    chorus.setBucketBrigade(enabled);
+}
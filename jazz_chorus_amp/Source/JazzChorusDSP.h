@@ -1,6 +1,8 @@
 #pragma once
 #include <JuceHeader.h>
 #include "ChorusEffect.h"
+#include "CascadedBiquad.h"
+#include "DspLoadMonitor.h"
 
 /**
  * JazzChorusDSP - Core DSP engine for Jazz Chorus amp simulation
@@ -17,7 +19,7 @@
  * Features:
  * - Clean preamp with subtle solid-state warmth
  * - Bright EQ voicing (treble, middle, bass)
- * - Stereo chorus effect (rate, depth, mix)
+ * - Stereo chorus effect (rate, depth, mix, 1-8 voice ensemble)
  * - Volume control
  * - Chorus on/off switch
  */
@@ -46,6 +48,44 @@ public:
     void setChorusDepth(float depth);    // Chorus modulation depth
     void setChorusMix(float mix);        // Chorus wet/dry mix
     void setChorusEnabled(bool enabled); // Chorus on/off
+    void setChorusVoices(int voices);    // Ensemble taps per channel
+    void setChorusInterpolation(ChorusInterpolation interpolation); // Delay read quality vs CPU
+    void setChorusBucketBrigade(bool enabled); // Analog BBD emulation
+
+    // Every setting the plugin's parameters drive. The processor and
+    // render_cli both push them through setParameters(), so a render always
+    // sets what processBlock() sets.
+    struct Parameters
+    {
+        float volume = 0.7f;
+        float bass = 0.5f;
+        float middle = 0.5f;
+        float treble = 0.6f;
+        float bright = 0.5f;
+        float chorusRate = 0.4f;
+        float chorusDepth = 0.6f;
+        float chorusMix = 0.5f;
+        bool chorusEnabled = true;
+        int chorusVoices = 1;
+        int chorusInterpolation = 0;  // ChorusInterpolation index
+        bool chorusBucketBrigade = false;
+    };
+
+    void setParameters(const Parameters& parameters);
+
+    // Per-stage timing for the DSP load meter; the time before the chain
+    // starts (parameter updates in the processor) is charged to setup
+    enum LoadStage
+    {
+        setupLoadStage = 0,
+        preampLoadStage,
+        eqLoadStage,
+        chorusLoadStage,
+        outputLoadStage
+    };
+
+    static juce::StringArray getLoadStageNames();
+    void setLoadMonitor(DspLoadMonitor* monitorToUse) { loadMonitor = monitorToUse; }
 
 private:
     // Sample rate
@@ -58,19 +98,25 @@ private:
     float treble = 0.6f;     // Slightly boosted by default (Jazz Chorus character)
     float bright = 0.5f;
 
-    // EQ filters using JUCE DSP
-    using Filter = juce::dsp::IIR::Filter<float>;
-    using FilterCoefs = juce::dsp::IIR::Coefficients<float>;
+    // EQ (bass, middle, treble, bright) in a single fused pass
+    enum EqSection
+    {
+        bassSection = 0,
+        middleSection,
+        trebleSection,
+        brightSection
+    };
 
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> bassFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> middleFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> trebleFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> brightFilter;
+    CascadedBiquad eq;
 
     // Chorus effect
     ChorusEffect chorus;
 
+    // Owned by the processor, null when not measuring
+    DspLoadMonitor* loadMonitor = nullptr;
+
     // Helper functions
     void updateFilters();
     float applyCleanSaturation(float input); // Subtle solid-state character
+    void markLoadStage(LoadStage stage);
 };
@@ -12,7 +12,9 @@ JazzChorusAmpAudioProcessorEditor::JazzChorusAmpAudioProcessorEditor(
       brightKnob("BRIGHT"),
       chorusRateKnob("RATE"),
       chorusDepthKnob("DEPTH"),
-      chorusMixKnob("MIX")
+      chorusMixKnob("MIX"),
+      chorusVoicesKnob("VOICES"),
+      loadMeter(p.getLoadMonitor())
 {
     // Set plugin window size - amp panel dimensions
     setSize(750, 400);
@@ -26,6 +28,7 @@ JazzChorusAmpAudioProcessorEditor::JazzChorusAmpAudioProcessorEditor(
     chorusRateKnob.setDisplayRange(0.1f, 5.0f, "Hz");
     chorusDepthKnob.setDisplayRange(0.0f, 10.0f, "");
     chorusMixKnob.setDisplayRange(0.0f, 100.0f, "%");
+    chorusVoicesKnob.setDisplayRange(1.0f, 8.0f, "");
 
     // Wire up knobs to processor parameters
     volumeKnob.onValueChange = [this](float value)
@@ -68,6 +71,11 @@ JazzChorusAmpAudioProcessorEditor::JazzChorusAmpAudioProcessorEditor(
         audioProcessor.chorusMixParam->setValueNotifyingHost(value);
     };
 
+    chorusVoicesKnob.onValueChange = [this](float value)
+    {
+        audioProcessor.chorusVoicesParam->setValueNotifyingHost(value);
+    };
+
     // Setup chorus button
     chorusButton.setButtonText("CHORUS");
     chorusButton.setClickingTogglesState(true);
@@ -86,8 +94,36 @@ JazzChorusAmpAudioProcessorEditor::JazzChorusAmpAudioProcessorEditor(
     addAndMakeVisible(chorusRateKnob);
     addAndMakeVisible(chorusDepthKnob);
     addAndMakeVisible(chorusMixKnob);
+    addAndMakeVisible(chorusVoicesKnob);
     addAndMakeVisible(chorusButton);
 
+    // Setup interpolation selector
+    interpolationLabel.setText("INTERPOLATION", juce::dontSendNotification);
+    interpolationLabel.setJustificationType(juce::Justification::centred);
+    interpolationLabel.setColour(juce::Label::textColourId, textColor);
+    addAndMakeVisible(interpolationLabel);
+
+    interpolationSelector.addItemList(audioProcessor.chorusInterpolationParam->choices, 1);
+    interpolationSelector.setSelectedId(audioProcessor.chorusInterpolationParam->getIndex() + 1, juce::dontSendNotification);
+    interpolationSelector.onChange = [this]()
+    {
+        const int index = interpolationSelector.getSelectedId() - 1;
+        audioProcessor.chorusInterpolationParam->setValueNotifyingHost(
+            audioProcessor.chorusInterpolationParam->convertTo0to1(static_cast<float>(index)));
+    };
+    addAndMakeVisible(interpolationSelector);
+
+    // Setup BBD button
+    bucketBrigadeButton.setButtonText("ANALOG BBD");
+    bucketBrigadeButton.setClickingTogglesState(true);
+    bucketBrigadeButton.setToggleState(*audioProcessor.chorusBucketBrigadeParam, juce::dontSendNotification);
+    bucketBrigadeButton.onClick = [this]()
+    {
+        audioProcessor.chorusBucketBrigadeParam->setValueNotifyingHost(bucketBrigadeButton.getToggleState() ? 1.0f : 0.0f);
+    };
+    addAndMakeVisible(bucketBrigadeButton);
+    addAndMakeVisible(loadMeter);
+
     // Start timer to sync GUI with parameter changes (e.g., from DAW automation)
     startTimerHz(30); // 30 FPS update rate
 }
@@ -184,6 +220,9 @@ void JazzChorusAmpAudioProcessorEditor::resized()
     bounds.removeFromTop(110);  // Skip header area
     bounds.removeFromBottom(35); // Skip footer area
 
+    // Load meter in the top bar corner
+    loadMeter.setBounds(getWidth() - 120, 24, 90, 22);
+
     const int knobWidth = 80;
     const int knobHeight = 100;
     const int spacing = 10;
@@ -224,16 +263,25 @@ void JazzChorusAmpAudioProcessorEditor::resized()
                               chorusTopRow.getCentreY() - knobHeight / 2,
                               knobWidth, knobHeight);
 
-    // Chorus mix and button
+    // Chorus mix, voices and button
     auto chorusBottomRow = chorusSection;
-    chorusMixKnob.setBounds(chorusBottomRow.getCentreX() - knobWidth / 2,
+    chorusMixKnob.setBounds(chorusBottomRow.getCentreX() - knobWidth - spacing / 2,
                             chorusBottomRow.getY() + 10,
                             knobWidth, knobHeight);
+    chorusVoicesKnob.setBounds(chorusBottomRow.getCentreX() + spacing / 2,
+                               chorusBottomRow.getY() + 10,
+                               knobWidth, knobHeight);
 
-    // Chorus button below mix knob
+    // Chorus button below mix and voices knobs
     chorusButton.setBounds(chorusBottomRow.getCentreX() - 50,
                            chorusBottomRow.getY() + 120,
                            100, 30);
+
+    // Master section (right): interpolation selector
+    auto masterSection = bounds.reduced(15, 0);
+    interpolationLabel.setBounds(masterSection.getX(), masterSection.getCentreY() - 30, masterSection.getWidth(), 20);
+    interpolationSelector.setBounds(masterSection.getX(), masterSection.getCentreY() - 8, masterSection.getWidth(), 26);
+    bucketBrigadeButton.setBounds(masterSection.getCentreX() - 50, masterSection.getCentreY() + 40, 100, 30);
 }
 
 void JazzChorusAmpAudioProcessorEditor::timerCallback()
@@ -248,5 +296,8 @@ void JazzChorusAmpAudioProcessorEditor::timerCallback()
     chorusRateKnob.setValue(*audioProcessor.chorusRateParam);
     chorusDepthKnob.setValue(*audioProcessor.chorusDepthParam);
     chorusMixKnob.setValue(*audioProcessor.chorusMixParam);
+    chorusVoicesKnob.setValue(audioProcessor.chorusVoicesParam->getValue());
     chorusButton.setToggleState(*audioProcessor.chorusEnabledParam, juce::dontSendNotification);
+    interpolationSelector.setSelectedId(audioProcessor.chorusInterpolationParam->getIndex() + 1, juce::dontSendNotification);
+    bucketBrigadeButton.setToggleState(*audioProcessor.chorusBucketBrigadeParam, juce::dontSendNotification);
 }
@@ -2,6 +2,7 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "CustomKnob.h"
+#include "DspLoadMeter.h"
 
 /**
  * JazzChorusAmpAudioProcessorEditor
@@ -10,6 +11,8 @@
  * - Silver/chrome Jazz Chorus-style visual design
  * - Interactive knobs for all parameters
  * - Chorus on/off button
+ * - Chorus interpolation selector and analog BBD switch
+ * - DSP load meter in the top bar
  * - Clean, professional layout
  * - Real-time parameter updates
  */
@@ -37,10 +40,20 @@ private:
     CustomKnob chorusRateKnob;
     CustomKnob chorusDepthKnob;
     CustomKnob chorusMixKnob;
+    CustomKnob chorusVoicesKnob;
 
     // Chorus on/off button
     juce::TextButton chorusButton;
 
+    // Chorus delay interpolation
+    juce::ComboBox interpolationSelector;
+    juce::Label interpolationLabel;
+
+    // Analog BBD on/off button
+    juce::TextButton bucketBrigadeButton;
+
+    DspLoadMeter loadMeter;
+
     // Colors for Jazz Chorus aesthetic - silver/chrome
     const juce::Colour silverColor = juce::Colour(0xFFC0C0C0);
     const juce::Colour panelColor = juce::Colour(0xFFE8E8E8);       // Light silver panel
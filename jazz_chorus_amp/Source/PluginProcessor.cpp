@@ -61,6 +61,23 @@ JazzChorusAmpAudioProcessor::JazzChorusAmpAudioProcessor()
         "chorusEnabled",
         "Chorus Enabled",
         true));                 // On by default (it's the signature sound!)
+
+    addParameter(chorusVoicesParam = new juce::AudioParameterInt(
+        "chorusVoices",
+        "Chorus Voices",
+        1, 8,
+        1));                    // Classic two-tap stereo chorus
+
+    addParameter(chorusInterpolationParam = new juce::AudioParameterChoice(
+        "chorusInterpolation",
+        "Chorus Interpolation",
+        juce::StringArray{"Linear", "Hermite", "Lagrange", "Allpass", "Sinc"},
+        0));                    // Cheapest, and the original sound
+
+    addParameter(chorusBucketBrigadeParam = new juce::AudioParameterBool(
+        "chorusBBD",
+        "Chorus BBD",
+        false));                // Digital delay line by default
 }
 
 JazzChorusAmpAudioProcessor::~JazzChorusAmpAudioProcessor()
@@ -122,6 +139,8 @@ void JazzChorusAmpAudioProcessor::prepareToPlay(double sampleRate, int samplesPe
 {
     // Prepare DSP engine
     jazzChorusDSP.prepare(sampleRate, samplesPerBlock, getTotalNumInputChannels());
+    loadMonitor.prepare(sampleRate);
+    jazzChorusDSP.setLoadMonitor(&loadMonitor);
 }
 
 void JazzChorusAmpAudioProcessor::releaseResources()
@@ -149,17 +168,23 @@ void JazzChorusAmpAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     juce::ignoreUnused(midiMessages);
 
     juce::ScopedNoDenormals noDenormals;
+    DspLoadMonitor::ScopedBlock loadTiming(loadMonitor, buffer.getNumSamples());
 
     // Update DSP parameters from plugin parameters
-    jazzChorusDSP.setVolume(*volumeParam);
-    jazzChorusDSP.setBass(*bassParam);
-    jazzChorusDSP.setMiddle(*middleParam);
-    jazzChorusDSP.setTreble(*trebleParam);
-    jazzChorusDSP.setBright(*brightParam);
-    jazzChorusDSP.setChorusRate(*chorusRateParam);
-    jazzChorusDSP.setChorusDepth(*chorusDepthParam);
-    jazzChorusDSP.setChorusMix(*chorusMixParam);
-    jazzChorusDSP.setChorusEnabled(*chorusEnabledParam);
+    JazzChorusDSP::Parameters parameters;
+    parameters.volume = *volumeParam;
+    parameters.bass = *bassParam;
+    parameters.middle = *middleParam;
+    parameters.treble = *trebleParam;
+    parameters.bright = *brightParam;
+    parameters.chorusRate = *chorusRateParam;
+    parameters.chorusDepth = *chorusDepthParam;
+    parameters.chorusMix = *chorusMixParam;
+    parameters.chorusEnabled = *chorusEnabledParam;
+    parameters.chorusVoices = *chorusVoicesParam;
+    parameters.chorusInterpolation = chorusInterpolationParam->getIndex();
+    parameters.chorusBucketBrigade = *chorusBucketBrigadeParam;
+    jazzChorusDSP.setParameters(parameters);
 
     // Process audio through Jazz Chorus simulator
     jazzChorusDSP.processBlock(buffer);
@@ -189,6 +214,9 @@ void JazzChorusAmpAudioProcessor::getStateInformation(juce::MemoryBlock& destDat
     stream.writeFloat(*chorusDepthParam);
     stream.writeFloat(*chorusMixParam);
     stream.writeBool(*chorusEnabledParam);
+    stream.writeInt(*chorusVoicesParam);
+    stream.writeInt(chorusInterpolationParam->getIndex());
+    stream.writeBool(*chorusBucketBrigadeParam);
 }
 
 void JazzChorusAmpAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -205,6 +233,16 @@ void JazzChorusAmpAudioProcessor::setStateInformation(const void* data, int size
     chorusDepthParam->setValueNotifyingHost(stream.readFloat());
     chorusMixParam->setValueNotifyingHost(stream.readFloat());
     chorusEnabledParam->setValueNotifyingHost(stream.readBool());
+
+    // Absent from states saved before the ensemble mode
+    if (!stream.isExhausted())
+        chorusVoicesParam->setValueNotifyingHost(chorusVoicesParam->convertTo0to1(static_cast<float>(stream.readInt())));
+
+    if (!stream.isExhausted())
+        chorusInterpolationParam->setValueNotifyingHost(chorusInterpolationParam->convertTo0to1(static_cast<float>(stream.readInt())));
+
+    if (!stream.isExhausted())
+        chorusBucketBrigadeParam->setValueNotifyingHost(stream.readBool() ? 1.0f : 0.0f);
 }
 
 // This creates new instances of the plugin
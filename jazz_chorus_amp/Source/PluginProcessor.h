@@ -50,10 +50,17 @@ public:
     juce::AudioParameterFloat* chorusDepthParam;
     juce::AudioParameterFloat* chorusMixParam;
     juce::AudioParameterBool* chorusEnabledParam;
+    juce::AudioParameterInt* chorusVoicesParam;
+    juce::AudioParameterChoice* chorusInterpolationParam;
+    juce::AudioParameterBool* chorusBucketBrigadeParam;
+
+    // Per-block and per-stage timings for the editor's load meter
+    DspLoadMonitor& getLoadMonitor() { return loadMonitor; }
 
 private:
     // DSP engine
     JazzChorusDSP jazzChorusDSP;
+    DspLoadMonitor loadMonitor { JazzChorusDSP::getLoadStageNames() };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JazzChorusAmpAudioProcessor)
 };
@@ -0,0 +1,302 @@
+#include "BassDiskStreamer.h"
+
+static_assert((BassSampleStream::bufferFrames & (BassSampleStream::bufferFrames - 1)) == 0, "Ring positions are masked");
+
+BassSampleStream::BassSampleStream(juce::AudioFormatManager& formats, juce::CriticalSection& lockForZones)
+    : formatManager(formats),
+      zoneLock(lockForZones),
+      workspace(2, readChunkFrames),
+      ring(static_cast<size_t>(bufferFrames), 0.0f)
+{
+}
+
+//==============================================================================
+void BassSampleStream::start(const BassSampleZone& zoneToPlay)
+{
+    zone = &zoneToPlay;
+    ++generation;
+
+    // Published by the generation store below
+    consumedFrame.store(0, std::memory_order_relaxed);
+    requestedZone.store(zone->needsStreaming() ? zone : nullptr, std::memory_order_relaxed);
+    requestedGeneration.store(generation, std::memory_order_release);
+}
+
+void BassSampleStream::stop()
+{
+    zone = nullptr;
+    ++generation;
+
+    requestedZone.store(nullptr, std::memory_order_relaxed);
+    requestedGeneration.store(generation, std::memory_order_release);
+}
+
+void BassSampleStream::read(juce::int64 startFrame, float* destination, int numFrames)
+{
+    if (zone == nullptr)
+    {
+        juce::FloatVectorOperations::clear(destination, numFrames);
+        return;
+    }
+
+    const int preloadLength = zone->getPreloadLength();
+    int numDone = 0;
+
+    if (waitForDisk.load(std::memory_order_relaxed))
+        waitUntilStreamed(startFrame + numFrames);
+
+    // The attack comes from RAM
+    if (startFrame < preloadLength)
+    {
+        numDone = static_cast<int>(juce::jmin(static_cast<juce::int64>(numFrames), preloadLength - startFrame));
+        zone->readPreload(static_cast<int>(startFrame), destination, numDone);
+    }
+
+    // The rest from the ring, once the streaming thread has caught up with this note
+    if (numDone < numFrames && servedGeneration.load(std::memory_order_acquire) == generation)
+    {
+        const juce::int64 firstFrame = startFrame + numDone;
+        const int numAvailable = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0),
+                                                               static_cast<juce::int64>(numFrames - numDone),
+                                                               validEnd.load(std::memory_order_acquire) - firstFrame));
+
+        for (int copied = 0; copied < numAvailable;)
+        {
+            const int ringIndex = static_cast<int>((firstFrame + copied) & (bufferFrames - 1));
+            const int length = juce::jmin(numAvailable - copied, bufferFrames - ringIndex);
+            juce::FloatVectorOperations::copy(destination + numDone + copied, ring.data() + ringIndex, length);
+            copied += length;
+        }
+
+        numDone += numAvailable;
+    }
+
+    if (numDone < numFrames)
+    {
+        juce::FloatVectorOperations::clear(destination + numDone, numFrames - numDone);
+
+        // Past the end of the file is just silence
+        if (startFrame + numDone < zone->lengthInSamples)
+            underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void BassSampleStream::waitUntilStreamed(juce::int64 endFrame)
+{
+    const auto neededEnd = juce::jmin(endFrame, zone->lengthInSamples);
+
+    if (neededEnd <= zone->getPreloadLength())
+        return;
+
+    // Bounded, in case the file has gone away
+    const auto timeout = juce::Time::getMillisecondCounter() + 2000;
+
+    while ((servedGeneration.load(std::memory_order_acquire) != generation
+            || validEnd.load(std::memory_order_acquire) < neededEnd)
+           && juce::Time::getMillisecondCounter() < timeout)
+        juce::Thread::sleep(1);
+}
+
+int BassSampleStream::useTimeSlice()
+{
+    const auto generationToServe = requestedGeneration.load(std::memory_order_acquire);
+
+    if (generationToServe != servedGeneration.load(std::memory_order_relaxed))
+    {
+        reader.reset();
+        packedFile.reset();
+        writeFrame = 0;
+        fileLength = 0;
+        juce::File file;
+        std::shared_ptr<const BassPackedSampleFile> newPackedFile;
+
+        {
+            // The zone's library can't be deleted while this is held
+            const juce::ScopedLock sl(zoneLock);
+
+            if (auto* newZone = requestedZone.load(std::memory_order_relaxed))
+            {
+                file = newZone->file;
+                writeFrame = newZone->getPreloadLength();
+                fileLength = newZone->lengthInSamples;
+
+                // Holding the mapping keeps packedData valid after the library goes
+                newPackedFile = newZone->packedFile;
+                packedData = newZone->packedData;
+                packedBitsPerSample = newZone->packedBitsPerSample;
+            }
+        }
+
+        if (fileLength > writeFrame)
+        {
+            if (newPackedFile != nullptr)
+                packedFile = std::move(newPackedFile);
+            else
+                reader.reset(formatManager.createReaderFor(file));
+        }
+
+        validEnd.store(writeFrame, std::memory_order_relaxed);
+        servedGeneration.store(generationToServe, std::memory_order_release);
+    }
+
+    if (reader == nullptr && packedFile == nullptr)
+        return 10;
+
+    // Stay at most one ring behind the voice
+    const auto limit = juce::jmin(fileLength, consumedFrame.load(std::memory_order_acquire) + bufferFrames);
+
+    if (writeFrame >= fileLength)
+    {
+        reader.reset();
+        packedFile.reset();
+        return 10;
+    }
+
+    if (writeFrame >= limit)
+        return 2;
+
+    const int ringIndex = static_cast<int>(writeFrame & (bufferFrames - 1));
+    const int numFrames = static_cast<int>(juce::jmin(static_cast<juce::int64>(readChunkFrames),
+                                                      limit - writeFrame,
+                                                      static_cast<juce::int64>(bufferFrames - ringIndex)));
+
+    if (packedFile != nullptr)
+        BassPackedSampleFile::decode(packedData, packedBitsPerSample, writeFrame, ring.data() + ringIndex, numFrames);
+    else
+        BassSampleLibrary::readMono(*reader, writeFrame, ring.data() + ringIndex, numFrames, workspace);
+
+    writeFrame += numFrames;
+    validEnd.store(writeFrame, std::memory_order_release);
+
+    return 0; // More to read - come straight back
+}
+
+//==============================================================================
+BassDiskStreamer::BassDiskStreamer(int numStreams)
+{
+    formatManager.registerBasicFormats();
+
+    for (int i = 0; i < numStreams; ++i)
+        thread.addTimeSliceClient(streams.add(new BassSampleStream(formatManager, zoneLock)));
+
+    thread.startThread();
+}
+
+BassDiskStreamer::~BassDiskStreamer()
+{
+    stopTimer();
+    thread.stopThread(1000);
+
+    for (auto* stream : streams)
+        thread.removeTimeSliceClient(stream);
+
+    delete pendingLibrary.exchange(nullptr);
+    deleteRetiredLibrary();
+}
+
+bool BassDiskStreamer::loadLibrary(const juce::File& folderOrPackedFile)
+{
+    auto library = BassSampleLibrary::loadShared(folderOrPackedFile);
+
+    if (library == nullptr)
+        return false;
+
+    {
+        const juce::ScopedLock lock(fileLock);
+        libraryFile = folderOrPackedFile;
+    }
+
+    // Replace anything the audio thread hasn't picked up yet
+    pendingIsEmpty.store(false);
+    delete pendingLibrary.exchange(new LibraryReference(std::move(library)));
+
+    startTimer(250); // Collects the old library once it's swapped out
+    return true;
+}
+
+void BassDiskStreamer::clearLibrary()
+{
+    {
+        const juce::ScopedLock lock(fileLock);
+        libraryFile = juce::File();
+    }
+
+    delete pendingLibrary.exchange(nullptr);
+    pendingIsEmpty.store(true);
+
+    startTimer(250);
+}
+
+juce::File BassDiskStreamer::getLibraryFile() const
+{
+    const juce::ScopedLock lock(fileLock);
+    return libraryFile;
+}
+
+bool BassDiskStreamer::isLibraryChangePending() const
+{
+    // Wait until the previous library has been collected
+    return retiredLibrary.load() == nullptr && (pendingLibrary.load() != nullptr || pendingIsEmpty.load());
+}
+
+void BassDiskStreamer::applyLibraryChange()
+{
+    // No stream may point into the old library once it's retired
+    for (auto* stream : streams)
+        stream->stop();
+
+    pendingIsEmpty.store(false);
+    retiredLibrary.store(activeLibrary.release());
+    activeLibrary.reset(pendingLibrary.exchange(nullptr));
+    roundRobinCounters.fill(0);
+}
+
+const BassSampleZone* BassDiskStreamer::chooseZone(BassArticulation articulation, int midiNoteNumber, float velocity)
+{
+    if (activeLibrary == nullptr || !juce::isPositiveAndBelow(midiNoteNumber, 128))
+        return nullptr;
+
+    auto& counter = roundRobinCounters[static_cast<size_t>(static_cast<int>(articulation) * 128 + midiNoteNumber)];
+    const int roundRobin = counter;
+
+    // Wraps at a multiple of every round robin count up to 16, so the cycle never skips
+    counter = (counter + 1) % 720720;
+
+    return (*activeLibrary)->findZone(articulation, midiNoteNumber, velocity, roundRobin);
+}
+
+void BassDiskStreamer::setNonRealtime(bool shouldBeNonRealtime)
+{
+    for (auto* stream : streams)
+        stream->setWaitForDisk(shouldBeNonRealtime);
+}
+
+int BassDiskStreamer::getNumUnderruns() const
+{
+    int total = 0;
+
+    for (auto* stream : streams)
+        total += stream->getNumUnderruns();
+
+    return total;
+}
+
+void BassDiskStreamer::timerCallback()
+{
+    deleteRetiredLibrary();
+
+    if (pendingLibrary.load() == nullptr && !pendingIsEmpty.load() && retiredLibrary.load() == nullptr)
+        stopTimer();
+}
+
+void BassDiskStreamer::deleteRetiredLibrary()
+{
+    std::unique_ptr<LibraryReference> library(retiredLibrary.exchange(nullptr));
+
+    if (library == nullptr)
+        return;
+
+    // Wait out a streaming thread that's copying details from one of its zones
+    const juce::ScopedLock sl(zoneLock);
+    library.reset();
+}
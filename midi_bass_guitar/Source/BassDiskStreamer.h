@@ -0,0 +1,144 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BassSampleLibrary.h"
+
+/**
+ * BassSampleStream - Feeds one voice the body of a sample from disk
+ *
+ * The voice plays the zone's preload straight from RAM while the streaming
+ * thread reads the rest of the file (or decodes it from a packed library's
+ * memory map), a chunk at a time, into this stream's ring buffer. Positions are absolute frames in the file, so the voice asks
+ * for any span it needs and the ring only has to stay bufferFrames ahead of
+ * what the voice has consumed.
+ *
+ * Single producer (streaming thread), single consumer (audio thread). Each
+ * start() opens a new generation; the consumer ignores the ring until the
+ * producer has switched to that generation, so a retriggered voice never
+ * reads frames left over from its previous note.
+ */
+class BassSampleStream : public juce::TimeSliceClient
+{
+public:
+    static constexpr int bufferFrames = 16384;   // Per voice, power of two
+    static constexpr int readChunkFrames = 2048;
+
+    BassSampleStream(juce::AudioFormatManager& formats, juce::CriticalSection& zoneLock);
+
+    // Audio thread
+    void start(const BassSampleZone& zoneToPlay);
+    void stop();
+
+    // Copies frames [startFrame, startFrame + numFrames) as mono. Frames the
+    // disk hasn't delivered yet come out silent and count as an underrun.
+    void read(juce::int64 startFrame, float* destination, int numFrames);
+
+    // Frames before this one won't be read again and can be overwritten
+    void setConsumedFrame(juce::int64 frame) { consumedFrame.store(frame, std::memory_order_release); }
+
+    int getNumUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+
+    // Offline rendering: read() blocks until the disk has caught up instead of dropping out
+    void setWaitForDisk(bool shouldWait) { waitForDisk.store(shouldWait, std::memory_order_relaxed); }
+
+    // Streaming thread
+    int useTimeSlice() override;
+
+private:
+    juce::AudioFormatManager& formatManager;
+    juce::CriticalSection& zoneLock;   // Keeps a requested zone alive while it is looked at
+
+    // Audio thread
+    const BassSampleZone* zone = nullptr;
+    juce::uint32 generation = 0;
+
+    // Handed from the audio thread to the streaming thread
+    std::atomic<const BassSampleZone*> requestedZone { nullptr };
+    std::atomic<juce::uint32> requestedGeneration { 0 };
+    std::atomic<juce::int64> consumedFrame { 0 };
+
+    // Handed back
+    std::atomic<juce::uint32> servedGeneration { 0 };
+    std::atomic<juce::int64> validEnd { 0 };  // Frames before this are in the ring
+    std::atomic<int> underruns { 0 };
+    std::atomic<bool> waitForDisk { false };
+
+    // Streaming thread
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    std::shared_ptr<const BassPackedSampleFile> packedFile;
+    const void* packedData = nullptr;
+    int packedBitsPerSample = 0;
+    juce::int64 writeFrame = 0;
+    juce::int64 fileLength = 0;
+    juce::AudioBuffer<float> workspace;
+
+    std::vector<float> ring;
+
+    void waitUntilStreamed(juce::int64 endFrame);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BassSampleStream)
+};
+
+/**
+ * BassDiskStreamer - Sample library plus the thread that streams it
+ *
+ * Holds the loaded BassSampleLibrary, one BassSampleStream per voice and the
+ * background thread that fills them, so the audio thread never touches the
+ * disk. A library loaded on the message thread is handed to the audio
+ * thread the same way CabinetSimulator hands over a new IR: it waits in
+ * pendingLibrary until the engine has stopped every voice, and the library
+ * it replaces is released later on the message thread.
+ *
+ * Libraries come from BassSampleLibrary::loadShared(), so instances playing
+ * the same library share it. The hand-over moves heap-allocated references,
+ * which keeps it a plain pointer swap and makes sure the last reference is
+ * never dropped on the audio thread.
+ */
+class BassDiskStreamer : private juce::Timer
+{
+public:
+    explicit BassDiskStreamer(int numStreams);
+    ~BassDiskStreamer() override;
+
+    // Message thread. False (keeping the current library) if there are no usable samples.
+    bool loadLibrary(const juce::File& folderOrPackedFile);
+    void clearLibrary();
+    juce::File getLibraryFile() const;
+
+    // Audio thread: after stopping every voice, swap in a newly loaded library
+    bool isLibraryChangePending() const;
+    void applyLibraryChange();
+
+    // Audio thread. Null when no library is loaded or it doesn't cover the note;
+    // successive calls for the same key cycle through its round robins.
+    const BassSampleZone* chooseZone(BassArticulation articulation, int midiNoteNumber, float velocity);
+
+    BassSampleStream& getStream(int index) { return *streams.getUnchecked(index); }
+    int getNumStreams() const { return streams.size(); }
+    int getNumUnderruns() const;
+
+    // Offline bounce/render: voices wait for the disk, so every run sounds the same
+    void setNonRealtime(bool shouldBeNonRealtime);
+
+private:
+    juce::AudioFormatManager formatManager;
+    juce::CriticalSection zoneLock;
+    juce::OwnedArray<BassSampleStream> streams;
+    juce::TimeSliceThread thread { "Bass disk streaming" };
+
+    using LibraryReference = std::shared_ptr<const BassSampleLibrary>;
+
+    std::unique_ptr<LibraryReference> activeLibrary;  // Audio thread
+    std::array<int, 4 * 128> roundRobinCounters {};
+
+    std::atomic<LibraryReference*> pendingLibrary { nullptr };
+    std::atomic<LibraryReference*> retiredLibrary { nullptr };
+    std::atomic<bool> pendingIsEmpty { false };  // Pending change is "no library at all"
+
+    juce::CriticalSection fileLock;
+    juce::File libraryFile;
+
+    void timerCallback() override;
+    void deleteRetiredLibrary();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BassDiskStreamer)
+};
@@ -12,26 +12,19 @@ void BassEffects::prepare(double sampleRate, int samplesPerBlock, int numChannel
 {
     currentSampleRate = sampleRate;
 
-    // Prepare filters
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = numChannels;
-
-    bassFilter.prepare(spec);
-    midFilter.prepare(spec);
-    trebleFilter.prepare(spec);
+    juce::ignoreUnused(samplesPerBlock);
 
+    // Set up EQ sections for the current settings, then prepare the filter
     updateFilters();
     updateTonePreset();
+    eq.prepare(sampleRate, numChannels);
+
     reset();
 }
 
 void BassEffects::reset()
 {
-    bassFilter.reset();
-    midFilter.reset();
-    trebleFilter.reset();
+    eq.reset();
     envelope = 0.0f;
     previousSample = 0.0f;
 }
@@ -43,7 +36,6 @@ void BassEffects::processBlock(juce::AudioBuffer<float>& buffer)
 
     // Convert to DSP block for filter processing
     juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
 
     // Stage 1: Apply tone-specific processing
     if (currentTone == BassTone::AmpSim || currentTone == BassTone::Vintage)
@@ -76,10 +68,8 @@ void BassEffects::processBlock(juce::AudioBuffer<float>& buffer)
         }
     }
 
-    // Stage 3: EQ
-    bassFilter.process(context);
-    midFilter.process(context);
-    trebleFilter.process(context);
+    // Stage 3: EQ (all bands in one pass)
+    eq.process(block);
 
     // Stage 4: Output gain
     for (int channel = 0; channel < numChannels; ++channel)
@@ -94,25 +84,22 @@ void BassEffects::processBlock(juce::AudioBuffer<float>& buffer)
 
 void BassEffects::updateFilters()
 {
-    const double sampleRate = currentSampleRate;
+    // Only sections whose settings actually changed get redesigned
 
     // Bass - Low shelf at 80Hz (fundamental bass frequencies)
     // Range: -12dB to +12dB
-    float bassGainDb = (bassLevel - 0.5f) * 24.0f;
-    *bassFilter.state = *FilterCoefs::makeLowShelf(sampleRate, 80.0, 0.7,
-                                                     juce::Decibels::decibelsToGain(bassGainDb));
+    eq.setSection(bassSection, CascadedBiquad::SectionType::LowShelf, 80.0, 0.7,
+                  (bassLevel - 0.5f) * 24.0f);
 
     // Mid - Peaking filter at 500Hz (punch and clarity)
     // Range: -12dB to +12dB
-    float midGainDb = (midLevel - 0.5f) * 24.0f;
-    *midFilter.state = *FilterCoefs::makePeakFilter(sampleRate, 500.0, 1.0,
-                                                      juce::Decibels::decibelsToGain(midGainDb));
+    eq.setSection(midSection, CascadedBiquad::SectionType::Peak, 500.0, 1.0,
+                  (midLevel - 0.5f) * 24.0f);
 
     // Treble - High shelf at 3kHz (brightness and string noise)
     // Range: -12dB to +12dB
-    float trebleGainDb = (trebleLevel - 0.5f) * 24.0f;
-    *trebleFilter.state = *FilterCoefs::makeHighShelf(sampleRate, 3000.0, 0.7,
-                                                        juce::Decibels::decibelsToGain(trebleGainDb));
+    eq.setSection(trebleSection, CascadedBiquad::SectionType::HighShelf, 3000.0, 0.7,
+                  (trebleLevel - 0.5f) * 24.0f);
 }
 
 void BassEffects::updateTonePreset()
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include "CascadedBiquad.h"
 
 /**
  * Bass tone presets/effects chains
@@ -59,13 +60,15 @@ private:
     float compressionAmount = 0.0f;
     float outputGain = 0.7f;
 
-    // EQ filters
-    using Filter = juce::dsp::IIR::Filter<float>;
-    using FilterCoefs = juce::dsp::IIR::Coefficients<float>;
+    // EQ (bass, mid, treble) in a single fused pass
+    enum EqSection
+    {
+        bassSection = 0,
+        midSection,
+        trebleSection
+    };
 
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> bassFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> midFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> trebleFilter;
+    CascadedBiquad eq;
 
     // Compressor (simple dynamics processing)
     float previousSample = 0.0f;
@@ -0,0 +1,204 @@
+#include "BassEnvelope.h"
+
+void BassEnvelope::setSampleRate(double newSampleRate)
+{
+    jassert(newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+    recalculateRates();
+}
+
+void BassEnvelope::setParameters(const juce::ADSR::Parameters& newParameters)
+{
+    parameters = newParameters;
+    recalculateRates();
+
+    if (state == State::sustain)
+        level = parameters.sustain;
+}
+
+void BassEnvelope::recalculateRates()
+{
+    const auto getRate = [this](float distance, float timeInSeconds)
+    {
+        return timeInSeconds > 0.0f ? static_cast<float>(distance / (timeInSeconds * sampleRate)) : -1.0f;
+    };
+
+    attackRate = getRate(1.0f, parameters.attack);
+    decayRate = getRate(1.0f - parameters.sustain, parameters.decay);
+    releaseRate = getRate(parameters.sustain, parameters.release);
+}
+
+void BassEnvelope::noteOn()
+{
+    if (attackRate > 0.0f)
+    {
+        state = State::attack;
+    }
+    else
+    {
+        level = 1.0f;
+        goToDecayOrSustain();
+    }
+}
+
+void BassEnvelope::noteOff()
+{
+    if (state == State::idle)
+        return;
+
+    if (parameters.release > 0.0f)
+    {
+        // Release from wherever the envelope is now, taking the full release time
+        releaseRate = static_cast<float>(level / (parameters.release * sampleRate));
+        state = State::release;
+    }
+    else
+    {
+        reset();
+    }
+}
+
+void BassEnvelope::fadeOut(float timeInSeconds)
+{
+    if (state == State::idle)
+        return;
+
+    if (level <= 0.0f || timeInSeconds <= 0.0f)
+    {
+        reset();
+        return;
+    }
+
+    releaseRate = static_cast<float>(level / (timeInSeconds * sampleRate));
+    state = State::release;
+}
+
+void BassEnvelope::reset()
+{
+    level = 0.0f;
+    state = State::idle;
+}
+
+void BassEnvelope::goToDecayOrSustain()
+{
+    if (decayRate > 0.0f)
+    {
+        state = State::decay;
+    }
+    else
+    {
+        level = parameters.sustain;
+        state = State::sustain;
+    }
+}
+
+float BassEnvelope::getNextSample()
+{
+    switch (state)
+    {
+        case State::attack:
+            level += attackRate;
+
+            if (level >= 1.0f)
+            {
+                level = 1.0f;
+                goToDecayOrSustain();
+            }
+            break;
+
+        case State::decay:
+            level -= decayRate;
+
+            if (level <= parameters.sustain)
+            {
+                level = parameters.sustain;
+                state = State::sustain;
+            }
+            break;
+
+        case State::sustain:
+            level = parameters.sustain;
+            break;
+
+        case State::release:
+            level -= releaseRate;
+
+            if (level <= 0.0f)
+                reset();
+            break;
+
+        case State::idle:
+        default:
+            break;
+    }
+
+    return level;
+}
+
+float BassEnvelope::getSlope() const
+{
+    switch (state)
+    {
+        case State::attack:  return attackRate;
+        case State::decay:   return -decayRate;
+        case State::release: return -releaseRate;
+        case State::sustain:
+        case State::idle:
+        default:             return 0.0f;
+    }
+}
+
+int BassEnvelope::getSamplesAbove(float distance, float rate)
+{
+    // Whole steps of `rate` that stay strictly inside `distance`
+    if (rate <= 0.0f)
+        return 0;
+
+    const float steps = std::ceil(distance / rate) - 1.0f;
+    return steps > 0.0f ? static_cast<int>(juce::jmin(steps, static_cast<float>(std::numeric_limits<int>::max() / 2))) : 0;
+}
+
+int BassEnvelope::getSamplesBeforeTransition() const
+{
+    switch (state)
+    {
+        case State::attack:  return getSamplesAbove(1.0f - level, attackRate);
+        case State::decay:   return getSamplesAbove(level - parameters.sustain, decayRate);
+        case State::release: return getSamplesAbove(level, releaseRate);
+        case State::sustain:
+        case State::idle:
+        default:             return std::numeric_limits<int>::max();
+    }
+}
+
+void BassEnvelope::skip(int numSamples)
+{
+    jassert(numSamples <= getSamplesBeforeTransition());
+    level += getSlope() * static_cast<float>(numSamples);
+}
+
+void BassEnvelope::getNextBlock(float* output, int numSamples, float gain)
+{
+    int position = 0;
+
+    while (position < numSamples)
+    {
+        const int run = juce::jmin(numSamples - position, getSamplesBeforeTransition());
+
+        if (run == 0)
+        {
+            output[position++] = getNextSample() * gain;
+            continue;
+        }
+
+        // A straight line until the segment ends
+        const float start = level * gain;
+        const float step = getSlope() * gain;
+
+        for (int i = 0; i < run; ++i)
+            output[position + i] = start + step * static_cast<float>(i + 1);
+
+        skip(run);
+        position += run;
+    }
+}
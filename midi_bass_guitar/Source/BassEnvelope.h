@@ -0,0 +1,62 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * BassEnvelope - Linear ADSR with the same segments as juce::ADSR
+ *
+ * Besides the usual per-sample getNextSample(), it can report how many
+ * samples its current segment keeps a constant slope for. A batch renderer
+ * can then step many voices' envelopes together as level += slope and call
+ * skip() afterwards, only falling back to getNextSample() on the sample
+ * where a segment ends. getNextBlock() does the same for a single voice.
+ */
+class BassEnvelope
+{
+public:
+    void setSampleRate(double newSampleRate);
+    void setParameters(const juce::ADSR::Parameters& newParameters);
+
+    void noteOn();
+    void noteOff();
+    void reset();
+
+    // Release to silence over a fixed time, whatever the release parameter
+    void fadeOut(float timeInSeconds);
+
+    bool isActive() const { return state != State::idle; }
+
+    float getNextSample();
+
+    // Batch stepping: for the next getSamplesBeforeTransition() samples the
+    // output is getLevel() + n * getSlope(), n = 1, 2, ...
+    float getLevel() const { return level; }
+    float getSlope() const;
+    int getSamplesBeforeTransition() const;
+    void skip(int numSamples);
+
+    // The next numSamples outputs times gain, a whole segment run at a time
+    void getNextBlock(float* output, int numSamples, float gain);
+
+private:
+    enum class State
+    {
+        idle,
+        attack,
+        decay,
+        sustain,
+        release
+    };
+
+    State state = State::idle;
+    juce::ADSR::Parameters parameters;
+    double sampleRate = 44100.0;
+
+    float level = 0.0f;
+    float attackRate = 0.0f;
+    float decayRate = 0.0f;
+    float releaseRate = 0.0f;
+
+    void recalculateRates();
+    void goToDecayOrSustain();
+    static int getSamplesAbove(float distance, float rate);
+};
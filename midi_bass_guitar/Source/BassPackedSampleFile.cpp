@@ -0,0 +1,196 @@
+#include "BassPackedSampleFile.h"
+#include "SharedAssetCache.h"
+
+namespace
+{
+    const char magic[] = { 'B', 'B', 'S', 'L' };
+
+    using FloatPointer = juce::AudioData::Pointer<juce::AudioData::Float32, juce::AudioData::NativeEndian,
+                                                  juce::AudioData::NonInterleaved, juce::AudioData::NonConst>;
+
+    template <typename SampleFormat>
+    using PackedPointer = juce::AudioData::Pointer<SampleFormat, juce::AudioData::LittleEndian,
+                                                   juce::AudioData::Interleaved, juce::AudioData::NonConst>;
+
+    template <typename SampleFormat>
+    using ConstPackedPointer = juce::AudioData::Pointer<SampleFormat, juce::AudioData::LittleEndian,
+                                                        juce::AudioData::Interleaved, juce::AudioData::Const>;
+
+    template <typename SampleFormat>
+    void decodeAs(const void* data, juce::int64 startFrame, float* destination, int numFrames)
+    {
+        const auto* first = static_cast<const char*>(data) + startFrame * SampleFormat::bytesPerSample;
+        FloatPointer output(destination);
+        output.convertSamples(ConstPackedPointer<SampleFormat>(first, 1), numFrames);
+    }
+
+    template <typename SampleFormat>
+    void encodeAs(const float* source, void* destination, int numFrames)
+    {
+        using ConstFloatPointer = juce::AudioData::Pointer<juce::AudioData::Float32, juce::AudioData::NativeEndian,
+                                                           juce::AudioData::NonInterleaved, juce::AudioData::Const>;
+        PackedPointer<SampleFormat> output(destination, 1);
+        output.convertSamples(ConstFloatPointer(source), numFrames);
+    }
+
+    juce::int64 readInt64(const char* bytes)
+    {
+        return static_cast<juce::int64>(juce::ByteOrder::littleEndianInt64(bytes));
+    }
+
+    double readDouble(const char* bytes)
+    {
+        const auto bits = juce::ByteOrder::littleEndianInt64(bytes);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+//==============================================================================
+std::shared_ptr<const BassPackedSampleFile> BassPackedSampleFile::open(const juce::File& fileToOpen)
+{
+    const auto key = SharedAssetCache::makeKey("BassPackedSampleFile", getFingerprint(fileToOpen));
+
+    return SharedAssetCache::getInstance().getOrCreate<BassPackedSampleFile>(key, [&fileToOpen]()
+    {
+        std::shared_ptr<BassPackedSampleFile> packed(new BassPackedSampleFile(fileToOpen));
+        return packed->readIndex() ? packed : nullptr;
+    });
+}
+
+juce::uint64 BassPackedSampleFile::getFingerprint(const juce::File& fileToOpen)
+{
+    juce::FileInputStream input(fileToOpen);
+
+    if (!input.openedOk())
+        return 0;
+
+    // The index covers every zone's layout; the size and date catch audio rewritten in place
+    juce::MemoryBlock index;
+    input.readIntoMemoryBlock(index, headerSize);
+
+    if (index.getSize() == static_cast<size_t>(headerSize))
+    {
+        const auto numIndexRecords = static_cast<juce::int64>(juce::ByteOrder::littleEndianInt(index.begin() + 8));
+        const auto maxRecords = juce::jmin(static_cast<juce::int64>(1 << 20), (input.getTotalLength() - headerSize) / recordSize);
+        input.readIntoMemoryBlock(index, static_cast<int>(juce::jlimit<juce::int64>(0, maxRecords, numIndexRecords) * recordSize));
+    }
+
+    auto hash = SharedAssetCache::hashBytes(index.getData(), index.getSize());
+    hash = SharedAssetCache::hashValue(input.getTotalLength(), hash);
+    return SharedAssetCache::hashValue(fileToOpen.getLastModificationTime().toMilliseconds(), hash);
+}
+
+BassPackedSampleFile::BassPackedSampleFile(const juce::File& fileToMap)
+    : file(fileToMap),
+      map(fileToMap, juce::MemoryMappedFile::readOnly)
+{
+}
+
+bool BassPackedSampleFile::readIndex()
+{
+    const auto size = static_cast<juce::int64>(map.getSize());
+
+    if (map.getData() == nullptr || size < headerSize)
+        return false;
+
+    const char* bytes = getBytes();
+
+    if (std::memcmp(bytes, magic, sizeof(magic)) != 0
+        || static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 4)) != version)
+        return false;
+
+    numRecords = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 8));
+    bitsPerSample = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 12));
+
+    if (numRecords <= 0 || !isSupportedBitDepth(bitsPerSample)
+        || numRecords > (size - headerSize) / recordSize)
+        return false;
+
+    // Everything the audio and streaming threads will touch has to lie inside the map
+    for (int i = 0; i < numRecords; ++i)
+    {
+        const auto record = getRecord(i);
+
+        if (!juce::isPositiveAndBelow(record.articulation, 4) || !juce::isPositiveAndBelow(record.rootNote, 128)
+            || record.sampleRate <= 0.0 || record.lengthInSamples <= 0
+            || record.dataOffset < getDataStart(numRecords) || record.dataOffset % alignment != 0
+            || record.lengthInSamples > (size - record.dataOffset) / getBytesPerSample(bitsPerSample))
+            return false;
+    }
+
+    return true;
+}
+
+BassPackedSampleFile::Record BassPackedSampleFile::getRecord(int index) const
+{
+    jassert(juce::isPositiveAndBelow(index, numRecords));
+
+    const char* bytes = getBytes() + headerSize + index * recordSize;
+
+    Record record;
+    record.articulation = static_cast<juce::uint8>(bytes[0]);
+    record.rootNote = static_cast<juce::uint8>(bytes[1]);
+    record.layer = static_cast<juce::uint8>(bytes[2]);
+    record.roundRobin = static_cast<juce::uint8>(bytes[3]);
+    record.sampleRate = readDouble(bytes + 8);
+    record.lengthInSamples = readInt64(bytes + 16);
+    record.dataOffset = readInt64(bytes + 24);
+    return record;
+}
+
+const void* BassPackedSampleFile::getSampleData(const Record& record) const
+{
+    return getBytes() + record.dataOffset;
+}
+
+//==============================================================================
+void BassPackedSampleFile::writeHeader(juce::OutputStream& output, int numRecordsToWrite, int bits)
+{
+    output.write(magic, sizeof(magic));
+    output.writeInt(version);
+    output.writeInt(numRecordsToWrite);
+    output.writeInt(bits);
+    output.writeInt(alignment);
+    output.writeInt(0);
+}
+
+void BassPackedSampleFile::writeRecord(juce::OutputStream& output, const Record& record)
+{
+    output.writeByte(static_cast<char>(record.articulation));
+    output.writeByte(static_cast<char>(record.rootNote));
+    output.writeByte(static_cast<char>(juce::jlimit(0, 255, record.layer)));
+    output.writeByte(static_cast<char>(juce::jlimit(0, 255, record.roundRobin)));
+    output.writeInt(0);
+    output.writeDouble(record.sampleRate);
+    output.writeInt64(record.lengthInSamples);
+    output.writeInt64(record.dataOffset);
+}
+
+juce::int64 BassPackedSampleFile::getDataStart(int numRecordsToWrite)
+{
+    return alignOffset(headerSize + static_cast<juce::int64>(numRecordsToWrite) * recordSize);
+}
+
+void BassPackedSampleFile::decode(const void* data, int bits, juce::int64 startFrame, float* destination, int numFrames)
+{
+    switch (bits)
+    {
+        case 16: decodeAs<juce::AudioData::Int16>(data, startFrame, destination, numFrames); break;
+        case 24: decodeAs<juce::AudioData::Int24>(data, startFrame, destination, numFrames); break;
+        case 32: decodeAs<juce::AudioData::Float32>(data, startFrame, destination, numFrames); break;
+        default: jassertfalse; juce::FloatVectorOperations::clear(destination, numFrames); break;
+    }
+}
+
+void BassPackedSampleFile::encode(const float* source, int bits, void* destination, int numFrames)
+{
+    switch (bits)
+    {
+        case 16: encodeAs<juce::AudioData::Int16>(source, destination, numFrames); break;
+        case 24: encodeAs<juce::AudioData::Int24>(source, destination, numFrames); break;
+        case 32: encodeAs<juce::AudioData::Float32>(source, destination, numFrames); break;
+        default: jassertfalse; break;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * BassPackedSampleFile - A whole bass sample library in one memory-mapped file
+ *
+ * Layout (little-endian):
+ *
+ *     header   "BBSL", version, zone count, bits per sample, alignment, 0
+ *     records  one 32-byte record per zone: articulation, root note, layer,
+ *              round robin, sample rate, length and data offset
+ *     data     each zone's mono PCM (16/24-bit integer or 32-bit float),
+ *              starting on its own page boundary
+ *
+ * Opening one only maps the file and checks the index - no sample data is
+ * read - and every instance in the process that opens the same file shares
+ * one mapping through SharedAssetCache, so the OS page cache holds a single
+ * copy of the audio.
+ * BassSampleLibrary::writePackedFile() builds one from a sample folder.
+ */
+class BassPackedSampleFile
+{
+public:
+    static constexpr int version = 1;
+    static constexpr int alignment = 4096;
+    static constexpr int headerSize = 24;
+    static constexpr int recordSize = 32;
+
+    struct Record
+    {
+        int articulation = 0;
+        int rootNote = 60;
+        int layer = 0;          // As numbered in the source file names
+        int roundRobin = 0;
+        double sampleRate = 44100.0;
+        juce::int64 lengthInSamples = 0;
+        juce::int64 dataOffset = 0;
+    };
+
+    // Maps the file, or shares the mapping another instance already has.
+    // Null if it isn't a valid packed library.
+    static std::shared_ptr<const BassPackedSampleFile> open(const juce::File& file);
+
+    // Hash of the index, size and modification date - changes whenever the file is rewritten
+    static juce::uint64 getFingerprint(const juce::File& file);
+
+    const juce::File& getFile() const { return file; }
+    int getBitsPerSample() const { return bitsPerSample; }
+    int getNumRecords() const { return numRecords; }
+    Record getRecord(int index) const;
+    const void* getSampleData(const Record& record) const;
+
+    // Writing, in this order: header, every record, then the data at the records' offsets
+    static void writeHeader(juce::OutputStream& output, int numRecords, int bitsPerSample);
+    static void writeRecord(juce::OutputStream& output, const Record& record);
+    static juce::int64 getDataStart(int numRecords);
+    static juce::int64 alignOffset(juce::int64 offset) { return (offset + alignment - 1) / alignment * alignment; }
+
+    // Sample conversion for any supported bit depth; safe on any thread
+    static bool isSupportedBitDepth(int bits) { return bits == 16 || bits == 24 || bits == 32; }
+    static int getBytesPerSample(int bits) { return bits / 8; }
+    static void decode(const void* data, int bits, juce::int64 startFrame, float* destination, int numFrames);
+    static void encode(const float* source, int bits, void* destination, int numFrames);
+
+private:
+    explicit BassPackedSampleFile(const juce::File& fileToMap);
+
+    juce::File file;
+    juce::MemoryMappedFile map;
+    int bitsPerSample = 0;
+    int numRecords = 0;
+
+    bool readIndex();
+    const char* getBytes() const { return static_cast<const char*>(map.getData()); }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BassPackedSampleFile)
+};
@@ -0,0 +1,451 @@
+#include "BassSampleLibrary.h"
+#include "SharedAssetCache.h"
+
+namespace
+{
+    bool parseArticulation(const juce::String& token, BassArticulation& articulation)
+    {
+        if (token == "picked" || token == "pick")
+            articulation = BassArticulation::Picked;
+        else if (token == "fingerstyle" || token == "finger")
+            articulation = BassArticulation::Fingerstyle;
+        else if (token == "slap")
+            articulation = BassArticulation::Slap;
+        else if (token == "muted" || token == "mute")
+            articulation = BassArticulation::Muted;
+        else
+            return false;
+
+        return true;
+    }
+
+    // "40", "e1", "f#2" or "bb1"; -1 if it isn't a note
+    int parseNote(const juce::String& token)
+    {
+        if (token.isEmpty())
+            return -1;
+
+        if (token.containsOnly("0123456789"))
+            return token.getIntValue();
+
+        int note = 0;
+
+        switch (token[0])
+        {
+            case 'c': note = 0;  break;
+            case 'd': note = 2;  break;
+            case 'e': note = 4;  break;
+            case 'f': note = 5;  break;
+            case 'g': note = 7;  break;
+            case 'a': note = 9;  break;
+            case 'b': note = 11; break;
+            default:  return -1;
+        }
+
+        int position = 1;
+
+        if (token[position] == '#')
+        {
+            ++note;
+            ++position;
+        }
+        else if (token[position] == 'b')
+        {
+            --note;
+            ++position;
+        }
+
+        const auto octave = token.substring(position);
+
+        if (!octave.trimCharactersAtStart("-").containsOnly("0123456789") || octave.isEmpty())
+            return -1;
+
+        // E1 = 28, as in BassSound
+        return (octave.getIntValue() + 1) * 12 + note;
+    }
+
+    // <articulation>_<note>[_v<layer>][_rr<round robin>]; layer and round robin as written
+    bool parseFileName(const juce::String& name, BassSampleZone& zone)
+    {
+        const auto tokens = juce::StringArray::fromTokens(name.toLowerCase(), "_", "");
+
+        if (tokens.size() < 2 || !parseArticulation(tokens[0], zone.articulation))
+            return false;
+
+        zone.rootNote = parseNote(tokens[1]);
+
+        if (!juce::isPositiveAndBelow(zone.rootNote, 128))
+            return false;
+
+        for (int i = 2; i < tokens.size(); ++i)
+        {
+            if (tokens[i].startsWith("rr"))
+                zone.roundRobin = tokens[i].substring(2).getIntValue();
+            else if (tokens[i].startsWith("v"))
+                zone.layer = tokens[i].substring(1).getIntValue();
+        }
+
+        return true;
+    }
+
+    bool isSameNote(const BassSampleZone& a, const BassSampleZone& b)
+    {
+        return a.articulation == b.articulation && a.rootNote == b.rootNote;
+    }
+
+    // The audio files' names, sizes and dates - cheap to gather, and it changes whenever a file does
+    juce::uint64 getFolderFingerprint(const juce::File& folder)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        auto files = folder.findChildFiles(juce::File::findFiles, true, formatManager.getWildcardForAllFormats());
+        files.sort();
+
+        auto hash = SharedAssetCache::hashSeed;
+
+        for (const auto& file : files)
+        {
+            hash = SharedAssetCache::hashString(file.getRelativePathFrom(folder), hash);
+            hash = SharedAssetCache::hashValue(file.getSize(), hash);
+            hash = SharedAssetCache::hashValue(file.getLastModificationTime().toMilliseconds(), hash);
+        }
+
+        return hash;
+    }
+}
+
+//==============================================================================
+void BassSampleZone::readPreload(int startFrame, float* destination, int numFrames) const
+{
+    jassert(startFrame + numFrames <= getPreloadLength());
+    juce::FloatVectorOperations::copy(destination, preload.getReadPointer(0, startFrame), numFrames);
+}
+
+//==============================================================================
+std::unique_ptr<BassSampleLibrary> BassSampleLibrary::load(const juce::File& folderOrPackedFile)
+{
+    if (folderOrPackedFile.isDirectory())
+        return loadFromFolder(folderOrPackedFile);
+
+    return loadFromPackedFile(folderOrPackedFile);
+}
+
+std::shared_ptr<const BassSampleLibrary> BassSampleLibrary::loadShared(const juce::File& folderOrPackedFile)
+{
+    const auto hash = folderOrPackedFile.isDirectory() ? getFolderFingerprint(folderOrPackedFile)
+                                                       : BassPackedSampleFile::getFingerprint(folderOrPackedFile);
+
+    const auto key = SharedAssetCache::makeKey("BassSampleLibrary", hash);
+
+    return SharedAssetCache::getInstance().getOrCreate<BassSampleLibrary>(key, [&folderOrPackedFile]()
+    {
+        return std::shared_ptr<const BassSampleLibrary>(load(folderOrPackedFile));
+    });
+}
+
+std::unique_ptr<BassSampleLibrary> BassSampleLibrary::loadFromFolder(const juce::File& folder)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto files = folder.findChildFiles(juce::File::findFiles, true, formatManager.getWildcardForAllFormats());
+    files.sort();
+
+    auto library = std::make_unique<BassSampleLibrary>();
+    library->source = folder;
+
+    juce::AudioBuffer<float> workspace;
+
+    for (const auto& file : files)
+    {
+        BassSampleZone zone;
+
+        if (!parseFileName(file.getFileNameWithoutExtension(), zone))
+            continue;
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader == nullptr || reader->lengthInSamples <= 0)
+            continue;
+
+        zone.file = file;
+        zone.sampleRate = reader->sampleRate;
+        zone.lengthInSamples = reader->lengthInSamples;
+
+        const int numFrames = static_cast<int>(juce::jmin(reader->lengthInSamples, static_cast<juce::int64>(preloadFrames)));
+        zone.preload.setSize(1, numFrames);
+        readMono(*reader, 0, zone.preload.getWritePointer(0), numFrames, workspace);
+
+        library->zones.push_back(std::move(zone));
+    }
+
+    if (!library->organiseZones())
+        return nullptr;
+
+    return library;
+}
+
+std::unique_ptr<BassSampleLibrary> BassSampleLibrary::loadFromPackedFile(const juce::File& file)
+{
+    auto packed = BassPackedSampleFile::open(file);
+
+    if (packed == nullptr)
+        return nullptr;
+
+    auto library = std::make_unique<BassSampleLibrary>();
+    library->source = file;
+    library->zones.reserve(static_cast<size_t>(packed->getNumRecords()));
+
+    for (int i = 0; i < packed->getNumRecords(); ++i)
+    {
+        const auto record = packed->getRecord(i);
+
+        BassSampleZone zone;
+        zone.file = file;
+        zone.articulation = static_cast<BassArticulation>(record.articulation);
+        zone.rootNote = record.rootNote;
+        zone.layer = record.layer;
+        zone.roundRobin = record.roundRobin;
+        zone.sampleRate = record.sampleRate;
+        zone.lengthInSamples = record.lengthInSamples;
+        zone.packedFile = packed;
+        zone.packedData = packed->getSampleData(record);
+        zone.packedBitsPerSample = packed->getBitsPerSample();
+
+        // The attack is decoded into RAM like a folder's, so the audio thread never touches the mapping
+        const int numFrames = static_cast<int>(juce::jmin(zone.lengthInSamples, static_cast<juce::int64>(preloadFrames)));
+        zone.preload.setSize(1, numFrames);
+        BassPackedSampleFile::decode(zone.packedData, zone.packedBitsPerSample, 0, zone.preload.getWritePointer(0), numFrames);
+
+        library->zones.push_back(std::move(zone));
+    }
+
+    if (!library->organiseZones())
+        return nullptr;
+
+    return library;
+}
+
+juce::Result BassSampleLibrary::writePackedFile(const juce::File& folder, const juce::File& outputFile, int bitsPerSample)
+{
+    if (!BassPackedSampleFile::isSupportedBitDepth(bitsPerSample))
+        return juce::Result::fail("Bits per sample must be 16, 24 or 32");
+
+    auto library = loadFromFolder(folder);
+
+    if (library == nullptr)
+        return juce::Result::fail("No usable samples in " + folder.getFullPathName());
+
+    const auto& zones = library->zones;
+    const int numZones = library->getNumZones();
+    const int bytesPerSample = BassPackedSampleFile::getBytesPerSample(bitsPerSample);
+
+    // Lay the data out first - the records ahead of it hold the offsets
+    std::vector<BassPackedSampleFile::Record> records;
+    auto offset = BassPackedSampleFile::getDataStart(numZones);
+
+    for (const auto& zone : zones)
+    {
+        BassPackedSampleFile::Record record;
+        record.articulation = static_cast<int>(zone.articulation);
+        record.rootNote = zone.rootNote;
+        record.layer = zone.layer;
+        record.roundRobin = zone.roundRobin;
+        record.sampleRate = zone.sampleRate;
+        record.lengthInSamples = zone.lengthInSamples;
+        record.dataOffset = offset;
+        records.push_back(record);
+
+        offset = BassPackedSampleFile::alignOffset(offset + zone.lengthInSamples * bytesPerSample);
+    }
+
+    juce::TemporaryFile temp(outputFile);
+
+    {
+        juce::FileOutputStream output(temp.getFile());
+
+        if (!output.openedOk())
+            return juce::Result::fail("Can't write " + outputFile.getFullPathName());
+
+        BassPackedSampleFile::writeHeader(output, numZones, bitsPerSample);
+
+        for (const auto& record : records)
+            BassPackedSampleFile::writeRecord(output, record);
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        constexpr int chunkFrames = 65536;
+        juce::AudioBuffer<float> workspace;
+        std::vector<float> frames(static_cast<size_t>(chunkFrames));
+        juce::HeapBlock<char> encoded(static_cast<size_t>(chunkFrames * bytesPerSample));
+
+        for (size_t i = 0; i < zones.size(); ++i)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(zones[i].file));
+
+            if (reader == nullptr)
+                return juce::Result::fail("Can't read " + zones[i].file.getFullPathName());
+
+            output.writeRepeatedByte(0, static_cast<size_t>(records[i].dataOffset - output.getPosition()));
+
+            for (juce::int64 frame = 0; frame < zones[i].lengthInSamples; frame += chunkFrames)
+            {
+                const int numFrames = static_cast<int>(juce::jmin(static_cast<juce::int64>(chunkFrames), zones[i].lengthInSamples - frame));
+                readMono(*reader, frame, frames.data(), numFrames, workspace);
+                BassPackedSampleFile::encode(frames.data(), bitsPerSample, encoded.get(), numFrames);
+                output.write(encoded.get(), static_cast<size_t>(numFrames * bytesPerSample));
+            }
+        }
+
+        // Pad the last block out to a whole page too
+        output.writeRepeatedByte(0, static_cast<size_t>(BassPackedSampleFile::alignOffset(output.getPosition()) - output.getPosition()));
+        output.flush();
+
+        if (output.getStatus().failed())
+            return output.getStatus();
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+        return juce::Result::fail("Can't replace " + outputFile.getFullPathName());
+
+    return juce::Result::ok();
+}
+
+void BassSampleLibrary::readMono(juce::AudioFormatReader& reader, juce::int64 startFrame, float* destination,
+                                 int numFrames, juce::AudioBuffer<float>& workspace)
+{
+    // Reading into two channels works for mono and stereo files alike
+    workspace.setSize(2, numFrames, false, false, true);
+    workspace.clear();
+    reader.read(&workspace, 0, numFrames, startFrame, true, true);
+
+    if (reader.numChannels < 2)
+    {
+        juce::FloatVectorOperations::copy(destination, workspace.getReadPointer(0), numFrames);
+        return;
+    }
+
+    juce::FloatVectorOperations::add(destination, workspace.getReadPointer(0), workspace.getReadPointer(1), numFrames);
+    juce::FloatVectorOperations::multiply(destination, 0.5f, numFrames);
+}
+
+bool BassSampleLibrary::organiseZones()
+{
+    if (zones.empty())
+        return false;
+
+    std::sort(zones.begin(), zones.end(), [](const BassSampleZone& a, const BassSampleZone& b)
+    {
+        return std::tie(a.articulation, a.rootNote, a.layer, a.roundRobin)
+             < std::tie(b.articulation, b.rootNote, b.layer, b.roundRobin);
+    });
+
+    // Number the layers and round robins of each recorded note from 0, whatever the file names said
+    for (size_t noteStart = 0; noteStart < zones.size();)
+    {
+        size_t noteEnd = noteStart;
+        int numLayers = 0;
+
+        for (; noteEnd < zones.size() && isSameNote(zones[noteStart], zones[noteEnd]); ++noteEnd)
+            if (noteEnd == noteStart || zones[noteEnd].layer != zones[noteEnd - 1].layer)
+                ++numLayers;
+
+        for (size_t layerStart = noteStart, layerIndex = 0; layerStart < noteEnd; ++layerIndex)
+        {
+            size_t layerEnd = layerStart;
+
+            while (layerEnd < noteEnd && zones[layerEnd].layer == zones[layerStart].layer)
+                ++layerEnd;
+
+            for (size_t i = layerStart; i < layerEnd; ++i)
+            {
+                auto& zone = zones[i];
+                zone.roundRobin = static_cast<int>(i - layerStart);
+                zone.numRoundRobins = static_cast<int>(layerEnd - layerStart);
+                zone.lowVelocity = static_cast<int>(layerIndex) * 127 / numLayers + 1;
+                zone.highVelocity = static_cast<int>(layerIndex + 1) * 127 / numLayers;
+            }
+
+            for (size_t i = layerStart; i < layerEnd; ++i)
+                zones[i].layer = static_cast<int>(layerIndex);
+
+            layerStart = layerEnd;
+        }
+
+        noteStart = noteEnd;
+    }
+
+    buildKeyMap();
+    return true;
+}
+
+void BassSampleLibrary::buildKeyMap()
+{
+    keyMap.fill({});
+
+    for (int articulation = 0; articulation < numArticulations; ++articulation)
+    {
+        // One range per recorded note of this articulation
+        std::vector<ZoneRange> notes;
+
+        for (int i = 0; i < getNumZones(); ++i)
+        {
+            if (static_cast<int>(zones[static_cast<size_t>(i)].articulation) != articulation)
+                continue;
+
+            if (notes.empty() || !isSameNote(zones[static_cast<size_t>(notes.back().begin)], zones[static_cast<size_t>(i)]))
+                notes.push_back({ i, i });
+
+            notes.back().end = i + 1;
+        }
+
+        if (notes.empty())
+            continue;
+
+        // Every key plays the nearest recorded note, pitching down on a tie
+        size_t nearest = 0;
+
+        for (int key = 0; key < 128; ++key)
+        {
+            while (nearest + 1 < notes.size()
+                   && std::abs(zones[static_cast<size_t>(notes[nearest + 1].begin)].rootNote - key)
+                          <= std::abs(zones[static_cast<size_t>(notes[nearest].begin)].rootNote - key))
+                ++nearest;
+
+            keyMap[static_cast<size_t>(articulation * 128 + key)] = notes[nearest];
+        }
+    }
+}
+
+const BassSampleZone* BassSampleLibrary::findZone(BassArticulation articulation, int midiNoteNumber,
+                                                           float velocity, int roundRobinCounter) const
+{
+    if (!juce::isPositiveAndBelow(midiNoteNumber, 128))
+        return nullptr;
+
+    const auto& range = keyMap[static_cast<size_t>(static_cast<int>(articulation) * 128 + midiNoteNumber)];
+    const int velocity127 = juce::jlimit(1, 127, juce::roundToInt(velocity * 127.0f));
+
+    for (int i = range.begin; i < range.end; ++i)
+    {
+        const auto& zone = zones[static_cast<size_t>(i)];
+
+        if (velocity127 >= zone.lowVelocity && velocity127 <= zone.highVelocity
+            && zone.roundRobin == roundRobinCounter % zone.numRoundRobins)
+            return &zone;
+    }
+
+    return nullptr;
+}
+
+size_t BassSampleLibrary::getPreloadBytes() const
+{
+    size_t bytes = 0;
+
+    for (const auto& zone : zones)
+        bytes += static_cast<size_t>(zone.preload.getNumSamples()) * sizeof(float);
+
+    return bytes;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BassVoice.h"
+#include "BassPackedSampleFile.h"
+
+/** One recorded file: the keys and velocities it plays, and where its audio lives */
+struct BassSampleZone
+{
+    juce::File file;
+    BassArticulation articulation = BassArticulation::Fingerstyle;
+    int rootNote = 60;
+    int layer = 0;                  // Velocity layer, 0 = softest
+    int lowVelocity = 1;            // 1-127, inclusive
+    int highVelocity = 127;
+    int roundRobin = 0;
+    int numRoundRobins = 1;
+
+    double sampleRate = 44100.0;
+    juce::int64 lengthInSamples = 0;
+    juce::AudioBuffer<float> preload;  // First BassSampleLibrary::preloadFrames frames (or all of a short file)
+
+    // Zones from a packed library stream their body straight from the shared mapping
+    std::shared_ptr<const BassPackedSampleFile> packedFile;
+    const void* packedData = nullptr;
+    int packedBitsPerSample = 0;
+
+    bool isPacked() const { return packedData != nullptr; }
+    int getPreloadLength() const { return preload.getNumSamples(); }
+    bool needsStreaming() const { return lengthInSamples > getPreloadLength(); }
+
+    // Audio thread: frames [startFrame, startFrame + numFrames) of the preload, as mono
+    void readPreload(int startFrame, float* destination, int numFrames) const;
+};
+
+/**
+ * BassSampleLibrary - Multisampled bass: articulations x notes x velocity
+ * layers x round robins
+ *
+ * Built from a folder of audio files named
+ *
+ *     <articulation>_<note>[_v<layer>][_rr<round robin>].wav
+ *
+ * e.g. "fingerstyle_E1_v2_rr3.wav" or "slap_40_v1.wav" (note names use
+ * E1 = MIDI 28). Each recorded note covers the keys up to halfway to its
+ * neighbours, and its layers split the velocity range evenly.
+ *
+ * Only the attack of each file (preloadFrames, folded to mono) is read into
+ * RAM; BassDiskStreamer streams the rest from disk while a note plays. The
+ * library is immutable once loaded, so the audio thread reads it without
+ * locking.
+ *
+ * writePackedFile() turns such a folder into a BassPackedSampleFile, which
+ * loads in milliseconds: the attacks are decoded into RAM as usual, and the
+ * streaming thread decodes the rest straight from the memory map.
+ */
+class BassSampleLibrary
+{
+public:
+    static constexpr int preloadFrames = 8192;  // About 190ms at 44.1kHz - covers the disk's start-up latency
+
+    // Not real-time safe. Returns nullptr if there are no usable samples.
+    static std::unique_ptr<BassSampleLibrary> load(const juce::File& folderOrPackedFile);
+
+    // As load(), but every instance that loads the same library shares one copy
+    static std::shared_ptr<const BassSampleLibrary> loadShared(const juce::File& folderOrPackedFile);
+    static std::unique_ptr<BassSampleLibrary> loadFromFolder(const juce::File& folder);
+    static std::unique_ptr<BassSampleLibrary> loadFromPackedFile(const juce::File& file);
+
+    // Packs every usable sample in the folder as 16, 24 or 32 (float) bit mono
+    static juce::Result writePackedFile(const juce::File& folder, const juce::File& outputFile, int bitsPerSample);
+
+    // Reads frames from any file as mono (stereo is averaged); workspace may grow
+    static void readMono(juce::AudioFormatReader& reader, juce::int64 startFrame, float* destination,
+                         int numFrames, juce::AudioBuffer<float>& workspace);
+
+    // Audio thread. Null if nothing is recorded for this articulation.
+    const BassSampleZone* findZone(BassArticulation articulation, int midiNoteNumber, float velocity, int roundRobinCounter) const;
+
+    const juce::File& getSource() const { return source; }
+    int getNumZones() const { return static_cast<int>(zones.size()); }
+    size_t getPreloadBytes() const;
+
+private:
+    static constexpr int numArticulations = 4;
+
+    juce::File source;  // Folder or packed file
+
+    // Sorted by articulation, root note, layer and round robin
+    std::vector<BassSampleZone> zones;
+
+    // Zones (all layers and round robins) that play each articulation/key
+    struct ZoneRange
+    {
+        int begin = 0;
+        int end = 0;
+    };
+
+    std::array<ZoneRange, numArticulations * 128> keyMap;
+
+    bool organiseZones();
+    void buildKeyMap();
+};
@@ -6,8 +6,8 @@ BassSamplerEngine::BassSamplerEngine()
     // BassSound defines what MIDI notes can be played
     synthesiser.addSound(new BassSound());
 
-    // Add voices (polyphony)
-    for (int i = 0; i < maxVoices; ++i)
+    // Add the whole voice pool up front; polyphony only limits how many sound
+    for (int i = 0; i < BassSynthesiser::voicePoolSize; ++i)
     {
         synthesiser.addVoice(new BassVoice());
     }
@@ -21,20 +21,27 @@ void BassSamplerEngine::prepare(double sampleRate, int samplesPerBlock, int numC
 {
     // Prepare synthesiser
     synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+    synthesiser.prepare(samplesPerBlock);
+
+    // Built once per rate for the whole process
+    wavetables = BassWavetableBank::getShared(sampleRate);
 
     // Prepare all voices
     for (int i = 0; i < synthesiser.getNumVoices(); ++i)
     {
-        if (auto* voice = dynamic_cast<BassVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->prepare(sampleRate, samplesPerBlock);
-            voice->setArticulation(currentArticulation);
-        }
+        auto* voice = synthesiser.getBassVoice(i);
+        voice->prepare(sampleRate, samplesPerBlock);
+        voice->setWavetables(wavetables.get());
+        voice->setSampleStreaming(&streamer, i < streamer.getNumStreams() ? &streamer.getStream(i) : nullptr);
     }
 
     // Prepare effects
     effects.prepare(sampleRate, samplesPerBlock, numChannels);
 
+    // Room for a busy block's MIDI without allocating
+    blockEvents.ensureSize(4096);
+    carriedEvents.ensureSize(4096);
+
     reset();
 }
 
@@ -42,6 +49,17 @@ void BassSamplerEngine::reset()
 {
     synthesiser.allNotesOff(0, false);
     effects.reset();
+    clearEvents();
+}
+
+void BassSamplerEngine::clearEvents()
+{
+    numControlChanges = 0;
+    lastQueuedValues.fill(std::numeric_limits<float>::quiet_NaN()); // Requeue everything
+    carriedEvents.clear();
+
+    samplePosition = 0;
+    lastSplitTime = -minSubBlockSize; // The first event needn't wait
 }
 
 void BassSamplerEngine::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
@@ -49,26 +67,235 @@ void BassSamplerEngine::processBlock(juce::AudioBuffer<float>& buffer, juce::Mid
     // Clear buffer
     buffer.clear();
 
-    // Synthesiser renders all active voices into the buffer
-    // It processes the MIDI messages and generates audio
-    synthesiser.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    // A newly loaded sample library takes over between blocks
+    if (streamer.isLibraryChangePending())
+    {
+        synthesiser.allNotesOff(0, false);
+        streamer.applyLibraryChange();
+    }
+    markLoadStage(setupLoadStage);
 
-    // Apply effects processing
-    effects.processBlock(buffer);
-}
+    const int numSamples = buffer.getNumSamples();
+    const auto blockStart = samplePosition;
+    const auto blockEnd = blockStart + numSamples;
+    constexpr auto never = std::numeric_limits<juce::int64>::max();
 
-void BassSamplerEngine::setArticulation(BassArticulation articulation)
-{
-    currentArticulation = articulation;
+    // Events carried over are already overdue, so they go at the very start
+    blockEvents.clear();
+    blockEvents.addEvents(carriedEvents, 0, -1, 0);
+    carriedEvents.clear();
 
-    // Update all voices with new articulation
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    for (const auto metadata : midiMessages)
+        blockEvents.addEvent(metadata.getMessage(), juce::jlimit(0, juce::jmax(0, numSamples - 1), metadata.samplePosition));
+
+    auto nextEvent = blockEvents.cbegin();
+    int nextControlChange = 0;
+    auto now = blockStart;
+
+    while (now < blockEnd)
     {
-        if (auto* voice = dynamic_cast<BassVoice*>(synthesiser.getVoice(i)))
+        const auto nextMidiTime = nextEvent != blockEvents.cend() ? blockStart + (*nextEvent).samplePosition : never;
+        const auto nextControlTime = nextControlChange < numControlChanges
+                                         ? controlChanges[static_cast<size_t>(nextControlChange)].time : never;
+        const auto splitTime = getNextSplitTime(juce::jmin(nextMidiTime, nextControlTime));
+
+        if (splitTime > now)
+        {
+            const auto segmentEnd = juce::jmin(splitTime, blockEnd);
+            renderSegment(buffer, static_cast<int>(now - blockStart), static_cast<int>(segmentEnd - now));
+            now = segmentEnd;
+            continue;
+        }
+
+        // Everything due by now, in time order - a control change before a note on the same sample
+        for (;;)
         {
-            voice->setArticulation(articulation);
+            const bool controlDue = nextControlChange < numControlChanges
+                                    && controlChanges[static_cast<size_t>(nextControlChange)].time <= now;
+            const bool midiDue = nextEvent != blockEvents.cend() && blockStart + (*nextEvent).samplePosition <= now;
+
+            if (controlDue && (!midiDue || controlChanges[static_cast<size_t>(nextControlChange)].time
+                                               <= blockStart + (*nextEvent).samplePosition))
+            {
+                const auto& change = controlChanges[static_cast<size_t>(nextControlChange++)];
+                applyControlChange(change.control, change.value);
+            }
+            else if (midiDue)
+            {
+                handleMidiEvent((*nextEvent).getMessage());
+                ++nextEvent;
+            }
+            else
+            {
+                break;
+            }
         }
+
+        lastSplitTime = now;
+        markLoadStage(setupLoadStage);
+    }
+
+    // Whatever had to wait for the next split
+    for (; nextEvent != blockEvents.cend(); ++nextEvent)
+        carriedEvents.addEvent((*nextEvent).getMessage(), 0);
+
+    std::move(controlChanges.begin() + nextControlChange, controlChanges.begin() + numControlChanges, controlChanges.begin());
+    numControlChanges -= nextControlChange;
+
+    samplePosition = blockEnd;
+}
+
+juce::int64 BassSamplerEngine::getNextSplitTime(juce::int64 nextEventTime) const
+{
+    if (nextEventTime == std::numeric_limits<juce::int64>::max())
+        return nextEventTime;
+
+    return juce::jmax(nextEventTime, lastSplitTime + minSubBlockSize);
+}
+
+void BassSamplerEngine::setParameters(const Parameters& parameters)
+{
+    // Articulation and tone preset
+    queueControlChange(Control::Articulation, static_cast<float>(parameters.articulation));
+    queueControlChange(Control::Tone, static_cast<float>(parameters.tone));
+
+    // Voice allocation
+    setVoiceMode(static_cast<BassSynthesiser::VoiceMode>(parameters.voiceMode));
+    setPolyphony(parameters.polyphony);
+
+    // Pitch
+    setPitchBendRange(static_cast<float>(parameters.pitchBendRange));
+    setGlideTime(parameters.glideTime);
+    setSynthesisModel(static_cast<BassSynthesisModel>(parameters.synthesisModel));
+
+    // EQ, dynamics and output
+    queueControlChange(Control::Bass, parameters.bass);
+    queueControlChange(Control::Mid, parameters.mid);
+    queueControlChange(Control::Treble, parameters.treble);
+    queueControlChange(Control::Compression, parameters.compression);
+    queueControlChange(Control::OutputGain, parameters.outputGain);
+}
+
+void BassSamplerEngine::queueControlChange(Control control, float value, int sampleOffset)
+{
+    auto& lastValue = lastQueuedValues[static_cast<size_t>(control)];
+
+    if (value == lastValue)
+        return;
+
+    lastValue = value;
+
+    if (numControlChanges == maxQueuedControlChanges)
+    {
+        jassertfalse; // Far more changes than a block can use
+        applyControlChange(control, value);
+        return;
+    }
+
+    // After anything already queued for the same sample
+    const auto time = samplePosition + juce::jmax(0, sampleOffset);
+    int index = numControlChanges++;
+
+    for (; index > 0 && controlChanges[static_cast<size_t>(index - 1)].time > time; --index)
+        controlChanges[static_cast<size_t>(index)] = controlChanges[static_cast<size_t>(index - 1)];
+
+    controlChanges[static_cast<size_t>(index)] = { time, control, value };
+}
+
+void BassSamplerEngine::applyControlChange(Control control, float value)
+{
+    switch (control)
+    {
+        case Control::Articulation: setArticulation(static_cast<BassArticulation>(juce::jlimit(0, 3, juce::roundToInt(value)))); break;
+        case Control::Tone:         setTone(static_cast<BassTone>(juce::jlimit(0, 4, juce::roundToInt(value)))); break;
+        case Control::Bass:         setBass(value); break;
+        case Control::Mid:          setMid(value); break;
+        case Control::Treble:       setTreble(value); break;
+        case Control::Compression:  setCompression(value); break;
+        case Control::OutputGain:   setOutputGain(value); break;
+    }
+}
+
+void BassSamplerEngine::handleMidiEvent(const juce::MidiMessage& message)
+{
+    if (message.isNoteOnOrOff()
+        && juce::isPositiveAndBelow(message.getNoteNumber() - firstKeyswitchNote, numKeyswitches))
+    {
+        if (message.isNoteOn())
+            setArticulation(static_cast<BassArticulation>(message.getNoteNumber() - firstKeyswitchNote));
+
+        return;
     }
+
+    synthesiser.handleMidiEvent(message);
+}
+
+void BassSamplerEngine::renderSegment(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    // Events are already handled, so the synthesiser renders the whole span in one go
+    synthesiser.renderNextBlock(buffer, noEvents, startSample, numSamples);
+    markLoadStage(voicesLoadStage);
+
+    juce::AudioBuffer<float> segment(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSamples);
+    effects.processBlock(segment);
+    markLoadStage(effectsLoadStage);
+}
+
+juce::StringArray BassSamplerEngine::getLoadStageNames()
+{
+    return { "Setup", "Voices", "Effects" };
+}
+
+void BassSamplerEngine::markLoadStage(LoadStage stage)
+{
+    if (loadMonitor != nullptr)
+        loadMonitor->markStage(stage);
+}
+
+void BassSamplerEngine::setArticulation(BassArticulation articulation)
+{
+    // Picked up by the next note-on; sounding notes keep theirs
+    synthesiser.setArticulation(articulation);
+}
+
+void BassSamplerEngine::setSynthesisModel(BassSynthesisModel model)
+{
+    synthesiser.setSynthesisModel(model);
+}
+
+void BassSamplerEngine::setPolyphony(int numVoices)
+{
+    synthesiser.setPolyphony(numVoices);
+}
+
+void BassSamplerEngine::setVoiceMode(BassSynthesiser::VoiceMode mode)
+{
+    synthesiser.setVoiceMode(mode);
+}
+
+void BassSamplerEngine::setPitchBendRange(float semitones)
+{
+    synthesiser.setPitchBendRange(semitones);
+}
+
+void BassSamplerEngine::setGlideTime(float seconds)
+{
+    synthesiser.setGlideTime(seconds);
+}
+
+bool BassSamplerEngine::loadSampleLibrary(const juce::File& folderOrPackedFile)
+{
+    return streamer.loadLibrary(folderOrPackedFile);
+}
+
+void BassSamplerEngine::clearSampleLibrary()
+{
+    streamer.clearLibrary();
+}
+
+juce::File BassSamplerEngine::getSampleLibraryFile() const
+{
+    return streamer.getLibraryFile();
 }
 
 // Effects pass-through methods
@@ -1,20 +1,40 @@
 #pragma once
 #include <JuceHeader.h>
 #include "BassVoice.h"
+#include "BassSynthesiser.h"
 #include "BassEffects.h"
+#include "BassWavetableBank.h"
+#include "BassDiskStreamer.h"
+#include "DspLoadMonitor.h"
 
 /**
  * BassSamplerEngine - Main sampler engine for bass guitar virtual instrument
  *
  * Manages:
  * - MIDI input and note routing
- * - Multiple voices for polyphony
- * - Articulation selection
+ * - A fixed voice pool with runtime polyphony and mono/legato modes,
+ *   sharing one wavetable bank
+ * - Articulation selection, latched per note
+ * - Pitch bend, mod wheel vibrato and legato slides
+ * - Wavetable or physically modelled (waveguide) string synthesis
  * - Effects processing chain
  * - Output mixing
  *
+ * - A multisample library streamed from disk, when one is loaded
+ *
  * Architecture:
- * MIDI In -> Synthesiser (BassVoice instances) -> Effects -> Audio Out
+ * MIDI In -> BassSynthesiser (BassVoices rendered in SIMD batches) -> Effects -> Audio Out
+ *
+ * Timing: processBlock() splits each block at its MIDI events and queued
+ * control changes, so a note, keyswitch or automation step lands on its own
+ * sample whatever the host's buffer size. To bound the cost, a split comes
+ * at least minSubBlockSize samples after the previous one; events inside
+ * that window wait for it, carrying over into the next block if need be.
+ * Splits are counted in samples since reset(), not from the block start, so
+ * a 32-sample and a 2048-sample buffer render the same output.
+ *
+ * Keyswitches: the four keys below the bass range (C1-D#1) don't play, but
+ * select Picked, Fingerstyle, Slap and Muted for the notes that follow.
  */
 class BassSamplerEngine
 {
@@ -28,9 +48,56 @@ public:
     // Process MIDI and audio together
     void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
 
-    // Articulation control
+    // Block-splitting granularity (samples)
+    static constexpr int minSubBlockSize = 32;
+
+    // Keyswitch notes, one per articulation in BassArticulation order
+    static constexpr int firstKeyswitchNote = 24;  // C1
+    static constexpr int numKeyswitches = 4;
+
+    // Controls that can change part-way through a block
+    enum class Control
+    {
+        Articulation,   // BassArticulation index
+        Tone,           // BassTone index
+        Bass,
+        Mid,
+        Treble,
+        Compression,
+        OutputGain
+    };
+
+    // Audio thread, before processBlock(): the change lands sampleOffset samples
+    // into the next block. Repeats of the last value queued are ignored, so a
+    // processor can queue its parameters every block and a keyswitch sticks
+    // until the articulation parameter actually moves.
+    void queueControlChange(Control control, float value, int sampleOffset = 0);
+
+    // Articulation for notes started from now on (immediate)
     void setArticulation(BassArticulation articulation);
-    BassArticulation getCurrentArticulation() const { return currentArticulation; }
+    BassArticulation getCurrentArticulation() const { return synthesiser.getArticulation(); }
+
+    // Wavetable or waveguide string for notes the sample library doesn't cover (immediate)
+    void setSynthesisModel(BassSynthesisModel model);
+
+    // Voice allocation (pass-through to BassSynthesiser), safe during playback
+    void setPolyphony(int numVoices);
+    void setVoiceMode(BassSynthesiser::VoiceMode mode);
+
+    // Pitch wheel range (semitones) and legato slide time (seconds); the mod
+    // wheel brings in vibrato
+    void setPitchBendRange(float semitones);
+    void setGlideTime(float seconds);
+
+    // Sample library (message thread). Until one is loaded, or for notes it
+    // doesn't cover, the voices fall back to the wavetable synth.
+    bool loadSampleLibrary(const juce::File& folderOrPackedFile);
+    void clearSampleLibrary();
+    juce::File getSampleLibraryFile() const;
+    int getNumStreamUnderruns() const { return streamer.getNumUnderruns(); }
+
+    // Offline bounce/render: sample voices wait for the disk instead of dropping out
+    void setNonRealtime(bool shouldBeNonRealtime) { streamer.setNonRealtime(shouldBeNonRealtime); }
 
     // Effects control (pass-through to BassEffects)
     void setTone(BassTone tone);
@@ -42,16 +109,84 @@ public:
     void setCompression(float compression);
     void setOutputGain(float gain);
 
+    // Every setting the plugin's parameters drive. The processor and
+    // render_cli both push them through setParameters() once a block, so a
+    // render always sets what processBlock() sets.
+    struct Parameters
+    {
+        int articulation = 1;    // BassArticulation index
+        int tone = 0;            // BassTone index
+        int voiceMode = 0;       // BassSynthesiser::VoiceMode index
+        int polyphony = 8;
+        int pitchBendRange = 2;  // Semitones
+        float glideTime = 0.0f;  // Seconds
+        int synthesisModel = 0;  // BassSynthesisModel index
+        float bass = 0.5f;
+        float mid = 0.5f;
+        float treble = 0.5f;
+        float compression = 0.0f;
+        float outputGain = 0.7f;
+    };
+
+    // Audio thread, before processBlock(). The controls go through
+    // queueControlChange(), so changes land at the start of the block and
+    // values that haven't moved leave keyswitched articulations in place.
+    void setParameters(const Parameters& parameters);
+
+    // Per-stage timing for the DSP load meter; the time before the voices
+    // render (parameter updates in the processor) is charged to setup
+    enum LoadStage
+    {
+        setupLoadStage = 0,
+        voicesLoadStage,
+        effectsLoadStage
+    };
+
+    static juce::StringArray getLoadStageNames();
+    void setLoadMonitor(DspLoadMonitor* monitorToUse) { loadMonitor = monitorToUse; }
+
 private:
-    // JUCE Synthesiser manages multiple voices
-    juce::Synthesiser synthesiser;
+    // Band-limited tables for every articulation, read by all voices (and other instances)
+    std::shared_ptr<const BassWavetableBank> wavetables;
+
+    // Sample library, one disk stream per voice and the thread that fills them
+    BassDiskStreamer streamer { BassSynthesiser::voicePoolSize };
+
+    // Synthesiser manages multiple voices and renders them in batches
+    BassSynthesiser synthesiser;
 
     // Effects processor
     BassEffects effects;
 
-    // Current settings
-    BassArticulation currentArticulation = BassArticulation::Fingerstyle;
+    // Event timeline, in samples since reset()
+    struct ControlChange
+    {
+        juce::int64 time = 0;
+        Control control = Control::Articulation;
+        float value = 0.0f;
+    };
+
+    static constexpr int numControls = 7;
+    static constexpr int maxQueuedControlChanges = 256;
+
+    std::array<ControlChange, maxQueuedControlChanges> controlChanges;  // Sorted by time
+    int numControlChanges = 0;
+    std::array<float, numControls> lastQueuedValues;
+
+    juce::int64 samplePosition = 0;
+    juce::int64 lastSplitTime = 0;
+    juce::MidiBuffer blockEvents;     // This block's MIDI plus any carried over
+    juce::MidiBuffer carriedEvents;   // Timed from the start of the next block
+    juce::MidiBuffer noEvents;
+
+    // Owned by the processor, null when not measuring
+    DspLoadMonitor* loadMonitor = nullptr;
+
+    void markLoadStage(LoadStage stage);
 
-    // Number of simultaneous notes (polyphony)
-    static constexpr int maxVoices = 8;
+    void clearEvents();
+    juce::int64 getNextSplitTime(juce::int64 nextMidiTime) const;
+    void applyControlChange(Control control, float value);
+    void handleMidiEvent(const juce::MidiMessage& message);
+    void renderSegment(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 };
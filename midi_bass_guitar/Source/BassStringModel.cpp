@@ -0,0 +1,172 @@
+#include "BassStringModel.h"
+
+void BassStringModel::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    // One period of the lowest pitch, plus the kernel's taps
+    lineSize = juce::nextPowerOfTwo(static_cast<int>(std::ceil(sampleRate / minFrequency)) + kernelSize + 2);
+    lineMask = lineSize - 1;
+
+    line.assign(static_cast<size_t>(lineSize * 2), 0.0f);
+    excitation.assign(static_cast<size_t>(lineSize), 0.0f);
+    reset();
+}
+
+void BassStringModel::reset()
+{
+    std::fill(line.begin(), line.end(), 0.0f);
+    writePosition = 0;
+    peak = 0.0f;
+}
+
+const BassStringModel::Style& BassStringModel::getStyle(BassArticulation articulation)
+{
+    //                                 position  noise  loop   T60    spike
+    static const Style picked      { 0.12f,    0.9f,  0.75f, 4.0f,  0.0f };
+    static const Style fingerstyle { 0.3f,     0.35f, 0.55f, 5.0f,  0.0f };
+    static const Style slap        { 0.05f,    1.0f,  0.85f, 3.0f,  3.0f };
+    static const Style muted       { 0.2f,     0.25f, 0.2f,  0.35f, 0.0f };
+
+    switch (articulation)
+    {
+        case BassArticulation::Picked:      return picked;
+        case BassArticulation::Fingerstyle: return fingerstyle;
+        case BassArticulation::Slap:        return slap;
+        case BassArticulation::Muted:       return muted;
+    }
+
+    return fingerstyle;
+}
+
+void BassStringModel::start(BassArticulation articulation, double frequency, float velocity)
+{
+    jassert(lineSize > 0); // prepare() first
+
+    const auto& style = getStyle(articulation);
+    loopBrightness = style.loopBrightness;
+    decaySeconds = style.decaySeconds;
+
+    reset();
+    setFrequency(frequency);
+
+    const int period = juce::jlimit(4, lineSize - kernelSize, juce::roundToInt(currentSampleRate / frequency));
+    float* shape = excitation.data();
+
+    // Noise burst, darker for softer notes
+    const float brightness = style.excitationBrightness * (0.4f + 0.6f * velocity);
+    float smoothed = 0.0f;
+
+    for (int i = 0; i < period; ++i)
+    {
+        smoothed += brightness * ((random.nextFloat() * 2.0f - 1.0f) - smoothed);
+        shape[i] = smoothed;
+    }
+
+    shape[0] += style.spike;
+    shape[1] -= style.spike * 0.5f;
+
+    // Plucking at a point on the string notches the harmonics that have a node there
+    const int pluckOffset = juce::jmax(1, juce::roundToInt(style.pluckPosition * static_cast<float>(period)));
+
+    for (int i = period - 1; i >= pluckOffset; --i)
+        shape[i] -= shape[i - pluckOffset];
+
+    // No DC in the loop, and a consistent level whatever the articulation
+    float mean = 0.0f;
+
+    for (int i = 0; i < period; ++i)
+        mean += shape[i];
+
+    juce::FloatVectorOperations::add(shape, -mean / static_cast<float>(period), period);
+
+    const auto range = juce::FloatVectorOperations::findMinAndMax(shape, period);
+    const float maxLevel = juce::jmax(-range.getStart(), range.getEnd());
+
+    if (maxLevel > 0.0f)
+        juce::FloatVectorOperations::multiply(shape, 0.5f / maxLevel, period);
+
+    writeToLine(shape, period);
+    peak = 1.0f;
+}
+
+void BassStringModel::setFrequency(double frequency)
+{
+    frequency = juce::jmax(minFrequency, frequency);
+
+    // Loop length in samples, less the damping filter's one-sample delay. The
+    // Lagrange interpolator is most accurate for delays between 1 and 2, so
+    // the whole-sample part leaves it that much.
+    const double loopLength = juce::jlimit(5.0, static_cast<double>(lineSize - kernelSize - 2),
+                                           currentSampleRate / frequency - 1.0);
+    delay = static_cast<int>(loopLength) - 1;
+    const auto d = static_cast<float>(loopLength - delay);
+
+    const float lagrange[4] = {
+        -(d - 1.0f) * (d - 2.0f) * (d - 3.0f) / 6.0f,
+        d * (d - 2.0f) * (d - 3.0f) / 2.0f,
+        -d * (d - 1.0f) * (d - 3.0f) / 2.0f,
+        d * (d - 1.0f) * (d - 2.0f) / 6.0f
+    };
+
+    // Lose 60 dB over decaySeconds - once per trip round the loop. Low notes ring longer.
+    const double t60 = decaySeconds * juce::jlimit(0.5, 2.0, std::sqrt(82.4 / frequency));
+    const auto loopGain = static_cast<float>(std::exp(-6.907755 / (frequency * t60)));
+
+    const float damping[3] = {
+        loopGain * (1.0f - loopBrightness) * 0.25f,
+        loopGain * (1.0f + loopBrightness) * 0.5f,
+        loopGain * (1.0f - loopBrightness) * 0.25f
+    };
+
+    kernel.fill(0.0f);
+
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 4; ++j)
+            kernel[static_cast<size_t>(i + j)] += damping[i] * lagrange[j];
+}
+
+void BassStringModel::process(float* output, int numSamples)
+{
+    float* const start = output;
+    const int total = numSamples;
+
+    while (numSamples > 0)
+    {
+        // Every tap of a chunk this long reads samples written before it
+        const int chunk = juce::jmin(numSamples, delay);
+        juce::FloatVectorOperations::clear(output, chunk);
+
+        for (int tap = 0; tap < kernelSize; ++tap)
+        {
+            const int readPosition = (writePosition - delay - tap) & lineMask;
+            juce::FloatVectorOperations::addWithMultiply(output, line.data() + readPosition,
+                                                         kernel[static_cast<size_t>(tap)], chunk);
+        }
+
+        writeToLine(output, chunk);
+        output += chunk;
+        numSamples -= chunk;
+    }
+
+    const auto range = juce::FloatVectorOperations::findMinAndMax(start, total);
+    peak = juce::jmax(-range.getStart(), range.getEnd());
+}
+
+void BassStringModel::writeToLine(const float* source, int numSamples)
+{
+    // Both copies, wrapping once if need be
+    const int first = juce::jmin(numSamples, lineSize - writePosition);
+    float* data = line.data();
+
+    juce::FloatVectorOperations::copy(data + writePosition, source, first);
+    juce::FloatVectorOperations::copy(data + writePosition + lineSize, source, first);
+
+    if (numSamples > first)
+    {
+        juce::FloatVectorOperations::copy(data, source + first, numSamples - first);
+        juce::FloatVectorOperations::copy(data + lineSize, source + first, numSamples - first);
+    }
+
+    writePosition = (writePosition + numSamples) & lineMask;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BassVoice.h"
+
+/**
+ * BassStringModel - Karplus-Strong / waveguide string for one voice
+ *
+ * A note starts by loading one period of excitation into a delay line -
+ * noise shaped per articulation: bright and plucked near the bridge for a
+ * pick, soft and further along the string for fingers, a hard spike for
+ * slap, heavily filtered for muted notes. The line then loops through its
+ * own loop filter, losing a little level and top end on every pass, which
+ * gives the natural decay of a plucked string with no envelope.
+ *
+ * The loop filter is one short FIR kernel: a three-tap linear-phase
+ * damping filter convolved with a third-order Lagrange fractional delay,
+ * which tunes the string between whole samples. Because the loop delay is
+ * longer than a processing chunk, a chunk of output only depends on samples
+ * already in the line, so it's a few FloatVectorOperations multiply-adds -
+ * SIMD across samples instead of a per-sample recursion. The line is stored
+ * twice over so every read is contiguous.
+ *
+ * The line is allocated in prepare() for the lowest playable pitch; start()
+ * and process() don't allocate.
+ */
+class BassStringModel
+{
+public:
+    static constexpr double minFrequency = 20.0;  // E1 bent down an octave, with margin
+
+    // Not real-time safe
+    void prepare(double sampleRate);
+    void reset();
+
+    // Pluck with an articulation's excitation and loop damping
+    void start(BassArticulation articulation, double frequency, float velocity);
+
+    // Retune the loop (pitch bends, slides); call at control rate
+    void setFrequency(double frequency);
+
+    // Overwrites numSamples of output
+    void process(float* output, int numSamples);
+
+    // True once the string has decayed below audibility
+    bool isSilent() const { return peak < silenceThreshold; }
+
+    // Peak of the last process() call (1 straight after start())
+    float getPeak() const { return peak; }
+
+private:
+    struct Style
+    {
+        float pluckPosition;       // Fraction of the string from the bridge
+        float excitationBrightness; // One-pole coefficient for the noise (1 = unfiltered)
+        float loopBrightness;      // Damping filter gain at Nyquist (1 = no damping)
+        float decaySeconds;        // T60 at 82 Hz; higher notes die away faster
+        float spike;               // Extra impulse at the start of the excitation
+    };
+
+    static const Style& getStyle(BassArticulation articulation);
+
+    static constexpr int kernelSize = 6;
+    static constexpr float silenceThreshold = 1.0e-4f;  // -80 dB
+
+    double currentSampleRate = 44100.0;
+    std::vector<float> line;  // 2 * lineSize: each sample is written at i and i + lineSize
+    std::vector<float> excitation;
+    int lineSize = 0;         // Power of two
+    int lineMask = 0;
+    int writePosition = 0;
+
+    int delay = 1;            // Whole samples before the kernel's first tap
+    std::array<float, kernelSize> kernel {};
+    float loopBrightness = 1.0f;
+    float decaySeconds = 1.0f;
+    float peak = 0.0f;
+
+    juce::Random random;
+
+    void writeToLine(const float* source, int numSamples);
+};
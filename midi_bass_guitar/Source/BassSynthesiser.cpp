@@ -0,0 +1,678 @@
+#include "BassSynthesiser.h"
+#include "BassWavetableBank.h"
+
+namespace
+{
+#if JUCE_USE_SIMD
+    // One SIMD register holds the same sample position from several voices
+    using Vec = juce::dsp::SIMDRegister<float>;
+    constexpr int lanes = static_cast<int>(Vec::SIMDNumElements);
+
+    inline Vec broadcast(float value) { return Vec::expand(value); }
+    inline Vec load(const float* source) { return Vec::fromRawArray(source); }
+    inline void store(Vec value, float* destination) { value.copyToRawArray(destination); }
+    inline float sum(Vec value) { return value.sum(); }
+
+    inline Vec wrap(Vec phase, Vec length)
+    {
+        return phase - (length & Vec::greaterThanOrEqual(phase, length));
+    }
+#else
+    // Scalar fallback - one voice per "register"
+    using Vec = float;
+    constexpr int lanes = 1;
+
+    inline Vec broadcast(float value) { return value; }
+    inline Vec load(const float* source) { return *source; }
+    inline void store(Vec value, float* destination) { *destination = value; }
+    inline float sum(Vec value) { return value; }
+
+    inline Vec wrap(Vec phase, Vec length) { return phase >= length ? phase - length : phase; }
+#endif
+
+    constexpr float tableLength = static_cast<float>(BassWavetableBank::tableSize);
+
+    // Stealing order: released notes first, then the quietest, then the oldest
+    bool isBetterToSteal(const BassVoice& candidate, const BassVoice& current)
+    {
+        if (candidate.isPlayingButReleased() != current.isPlayingButReleased())
+            return candidate.isPlayingButReleased();
+
+        // Levels within about 1dB of each other count as equally loud
+        const float candidateLevel = candidate.getCurrentLevel();
+        const float currentLevel = current.getCurrentLevel();
+
+        if (candidateLevel < currentLevel * 0.9f)
+            return true;
+
+        if (currentLevel < candidateLevel * 0.9f)
+            return false;
+
+        return candidate.wasStartedBefore(current);
+    }
+}
+
+BassSynthesiser::BassSynthesiser()
+{
+    prepare(512);
+}
+
+void BassSynthesiser::prepare(int samplesPerBlock)
+{
+    scratch.assign(static_cast<size_t>(juce::jmax(1, samplesPerBlock)), 0.0f);
+    sourceScratch.assign(static_cast<size_t>(lanes * BassVoice::pitchUpdateInterval), 0.0f);
+    tableVoices.reserve(static_cast<size_t>(getNumVoices()));
+    sourceVoices.reserve(static_cast<size_t>(getNumVoices()));
+}
+
+BassVoice* BassSynthesiser::addVoice(BassVoice* newVoice)
+{
+    const juce::ScopedLock sl(lock);
+
+    newVoice->setPitchBendRange(pitchBendRange);
+    newVoice->setGlideTime(glideTime);
+    bassVoices.push_back(newVoice);
+    juce::Synthesiser::addVoice(newVoice);
+    return newVoice;
+}
+
+void BassSynthesiser::removeVoice(int index)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (!juce::isPositiveAndBelow(index, static_cast<int>(bassVoices.size())))
+        return;
+
+    if (monoVoice == bassVoices[static_cast<size_t>(index)])
+        monoVoice = nullptr;
+
+    bassVoices.erase(bassVoices.begin() + index);
+    juce::Synthesiser::removeVoice(index);
+}
+
+void BassSynthesiser::clearVoices()
+{
+    const juce::ScopedLock sl(lock);
+
+    bassVoices.clear();
+    monoVoice = nullptr;
+    juce::Synthesiser::clearVoices();
+}
+
+BassVoice* BassSynthesiser::getBassVoice(int index) const
+{
+    return juce::isPositiveAndBelow(index, static_cast<int>(bassVoices.size()))
+               ? bassVoices[static_cast<size_t>(index)] : nullptr;
+}
+
+void BassSynthesiser::setPolyphony(int numVoices)
+{
+    const juce::ScopedLock sl(lock);
+    numVoices = juce::jlimit(1, maxPolyphony, numVoices);
+
+    if (numVoices == polyphony)
+        return;
+
+    polyphony = numVoices;
+    fadeOutExcessVoices();
+}
+
+void BassSynthesiser::setVoiceMode(VoiceMode newMode)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (newMode == voiceMode)
+        return;
+
+    // Start the new mode clean - whatever is sounding fades out
+    voiceMode = newMode;
+    numHeldNotes = 0;
+    monoVoice = nullptr;
+    monoNote = -1;
+
+    for (auto* voice : bassVoices)
+    {
+        if (voice->isVoiceActive() && !voice->isFadingOut())
+            voice->startFadeOut();
+    }
+}
+
+void BassSynthesiser::setPitchBendRange(float semitones)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (semitones == pitchBendRange)
+        return;
+
+    // Sounding notes pick up the new range at the next pitch wheel move
+    pitchBendRange = semitones;
+
+    for (auto* voice : bassVoices)
+        voice->setPitchBendRange(semitones);
+}
+
+void BassSynthesiser::setGlideTime(float seconds)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (seconds == glideTime)
+        return;
+
+    glideTime = seconds;
+
+    for (auto* voice : bassVoices)
+        voice->setGlideTime(seconds);
+}
+
+void BassSynthesiser::handleController(int midiChannel, int controllerNumber, int controllerValue)
+{
+    if (controllerNumber == 1 && juce::isPositiveAndBelow(midiChannel, static_cast<int>(modWheelValues.size())))
+        modWheelValues[static_cast<size_t>(midiChannel)] = controllerValue;
+
+    juce::Synthesiser::handleController(midiChannel, controllerNumber, controllerValue);
+}
+
+void BassSynthesiser::noteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (voiceMode != VoiceMode::Poly)
+    {
+        monoNoteOn(midiChannel, midiNoteNumber, velocity);
+        return;
+    }
+
+    for (auto* sound : sounds)
+    {
+        if (!sound->appliesToNote(midiNoteNumber) || !sound->appliesToChannel(midiChannel))
+            continue;
+
+        // A string can't ring the same note twice - fade out the one still ringing
+        for (auto* voice : bassVoices)
+        {
+            if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel(midiChannel)
+                && !voice->isFadingOut())
+                voice->startFadeOut();
+        }
+
+        // Every voice is a BassVoice, so this is a static cast
+        startBassVoice(static_cast<BassVoice*>(findFreeVoice(sound, midiChannel, midiNoteNumber, isNoteStealingEnabled())),
+                       sound, midiChannel, midiNoteNumber, velocity);
+    }
+}
+
+void BassSynthesiser::noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (voiceMode != VoiceMode::Poly)
+        monoNoteOff(midiChannel, midiNoteNumber, velocity, allowTailOff);
+    else
+        juce::Synthesiser::noteOff(midiChannel, midiNoteNumber, velocity, allowTailOff);
+}
+
+void BassSynthesiser::allNotesOff(int midiChannel, bool allowTailOff)
+{
+    const juce::ScopedLock sl(lock);
+
+    numHeldNotes = 0;
+    monoVoice = nullptr;
+    monoNote = -1;
+
+    juce::Synthesiser::allNotesOff(midiChannel, allowTailOff);
+}
+
+juce::SynthesiserVoice* BassSynthesiser::findFreeVoice(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                                       int midiNoteNumber, bool stealIfNoneAvailable) const
+{
+    juce::ignoreUnused(soundToPlay, midiChannel, midiNoteNumber);
+
+    auto* idleVoice = findIdleVoice();
+
+    if (idleVoice != nullptr && countSoundingVoices() < getVoiceLimit())
+        return idleVoice;
+
+    if (!stealIfNoneAvailable)
+        return nullptr;
+
+    auto* victim = findQuietestVoice();
+
+    if (victim == nullptr)
+        return idleVoice;
+
+    // Pool exhausted - hard steal, the way juce::Synthesiser would
+    if (idleVoice == nullptr)
+        return victim;
+
+    // Otherwise the old note fades out while the new one starts on a spare voice
+    victim->startFadeOut();
+    return idleVoice;
+}
+
+juce::SynthesiserVoice* BassSynthesiser::findVoiceToSteal(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                                          int midiNoteNumber) const
+{
+    juce::ignoreUnused(soundToPlay, midiChannel, midiNoteNumber);
+    return findQuietestVoice();
+}
+
+BassVoice* BassSynthesiser::findQuietestVoice() const
+{
+    BassVoice* quietest = nullptr;
+
+    for (auto* candidate : bassVoices)
+    {
+        if (!candidate->isVoiceActive() || candidate->isFadingOut())
+            continue;
+
+        if (quietest == nullptr || isBetterToSteal(*candidate, *quietest))
+            quietest = candidate;
+    }
+
+    return quietest;
+}
+
+int BassSynthesiser::countSoundingVoices() const
+{
+    int count = 0;
+
+    for (auto* voice : bassVoices)
+    {
+        if (voice->isVoiceActive() && !voice->isFadingOut())
+            ++count;
+    }
+
+    return count;
+}
+
+BassVoice* BassSynthesiser::findIdleVoice() const
+{
+    // Any voice can play any BassSound, so there's no canPlaySound() check
+    for (auto* voice : bassVoices)
+    {
+        if (!voice->isVoiceActive())
+            return voice;
+    }
+
+    return nullptr;
+}
+
+void BassSynthesiser::fadeOutExcessVoices()
+{
+    for (int excess = countSoundingVoices() - getVoiceLimit(); excess > 0; --excess)
+    {
+        if (auto* victim = findQuietestVoice())
+            victim->startFadeOut();
+        else
+            break;
+    }
+}
+
+void BassSynthesiser::startBassVoice(BassVoice* voice, juce::SynthesiserSound* sound,
+                                     int midiChannel, int midiNoteNumber, float velocity)
+{
+    if (voice == nullptr)
+        return;
+
+    // Latched here - later articulation changes leave this note alone
+    voice->setNextArticulation(articulation);
+    voice->setNextSynthesisModel(synthesisModel);
+
+    // The mod wheel position carries over to new notes, like the pitch wheel does
+    if (juce::isPositiveAndBelow(midiChannel, static_cast<int>(modWheelValues.size())))
+        voice->controllerMoved(1, modWheelValues[static_cast<size_t>(midiChannel)]);
+    startVoice(voice, sound, midiChannel, midiNoteNumber, velocity);
+}
+
+//==============================================================================
+juce::SynthesiserSound* BassSynthesiser::findSound(int midiChannel, int midiNoteNumber) const
+{
+    for (auto* sound : sounds)
+    {
+        if (sound->appliesToNote(midiNoteNumber) && sound->appliesToChannel(midiChannel))
+            return sound;
+    }
+
+    return nullptr;
+}
+
+void BassSynthesiser::monoNoteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    if (findSound(midiChannel, midiNoteNumber) == nullptr)
+        return;
+
+    removeHeldNote(midiChannel, midiNoteNumber);
+
+    if (numHeldNotes < static_cast<int>(heldNotes.size()))
+        heldNotes[static_cast<size_t>(numHeldNotes++)] = { midiChannel, midiNoteNumber, velocity };
+
+    // Legato only when another key is still held; a note that is just
+    // releasing gets retriggered
+    const bool overlapping = numHeldNotes > 1 && monoVoice != nullptr && monoVoice->isVoiceActive()
+                             && !monoVoice->isFadingOut();
+
+    if (voiceMode == VoiceMode::Legato && overlapping)
+    {
+        monoVoice->glideToNote(midiNoteNumber);
+        monoNote = midiNoteNumber;
+        return;
+    }
+
+    startMonoNote(midiChannel, midiNoteNumber, velocity);
+}
+
+void BassSynthesiser::monoNoteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    removeHeldNote(midiChannel, midiNoteNumber);
+
+    if (monoVoice == nullptr || midiNoteNumber != monoNote)
+        return;
+
+    // Fall back to the most recent key still held
+    if (numHeldNotes > 0)
+    {
+        const auto previous = heldNotes[static_cast<size_t>(numHeldNotes - 1)];
+
+        if (voiceMode == VoiceMode::Legato && monoVoice->isVoiceActive() && !monoVoice->isFadingOut())
+        {
+            monoVoice->glideToNote(previous.note);
+            monoNote = previous.note;
+        }
+        else
+        {
+            startMonoNote(previous.channel, previous.note, previous.velocity);
+        }
+
+        return;
+    }
+
+    if (monoVoice->isVoiceActive())
+    {
+        // As juce::Synthesiser::noteOff does, so the voice doesn't count as held
+        monoVoice->setKeyDown(false);
+        stopVoice(monoVoice, velocity, allowTailOff);
+    }
+
+    monoNote = -1;
+}
+
+void BassSynthesiser::startMonoNote(int midiChannel, int midiNoteNumber, float velocity)
+{
+    auto* sound = findSound(midiChannel, midiNoteNumber);
+
+    if (sound == nullptr)
+        return;
+
+    if (monoVoice != nullptr && monoVoice->isVoiceActive() && !monoVoice->isFadingOut())
+        monoVoice->startFadeOut();
+
+    // Crossfade onto a spare voice; restart in place only if the pool is exhausted
+    auto* voice = findIdleVoice();
+
+    if (voice == nullptr)
+        voice = monoVoice;
+
+    if (voice == nullptr)
+        return;
+
+    startBassVoice(voice, sound, midiChannel, midiNoteNumber, velocity);
+    monoVoice = voice;
+    monoNote = midiNoteNumber;
+}
+
+void BassSynthesiser::removeHeldNote(int midiChannel, int midiNoteNumber)
+{
+    for (int i = 0; i < numHeldNotes; ++i)
+    {
+        const auto& held = heldNotes[static_cast<size_t>(i)];
+
+        if (held.channel == midiChannel && held.note == midiNoteNumber)
+        {
+            std::move(heldNotes.begin() + i + 1, heldNotes.begin() + numHeldNotes, heldNotes.begin() + i);
+            --numHeldNotes;
+            return;
+        }
+    }
+}
+
+//==============================================================================
+void BassSynthesiser::renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    // Gather the voices that are sounding, by what they play
+    tableVoices.clear();
+    sourceVoices.clear();
+
+    for (auto* voice : bassVoices)
+    {
+        if (!voice->isVoiceActive())
+            continue;
+
+        const bool playsSource = voice->isPlayingSample() || voice->isPlayingString();
+
+        if (!playsSource && voice->currentTable == nullptr)
+            continue;
+
+        auto& batch = playsSource ? sourceVoices : tableVoices;
+
+        // More voices than prepare() made room for render themselves
+        if (batch.size() == batch.capacity())
+        {
+            voice->renderNextBlock(outputAudio, startSample, numSamples);
+            continue;
+        }
+
+        batch.push_back(voice);
+    }
+
+    if (tableVoices.empty() && sourceVoices.empty())
+        return;
+
+    // Chunks are also the voices' pitch control blocks
+    const int chunkSize = juce::jmin(static_cast<int>(scratch.size()), BassVoice::pitchUpdateInterval);
+
+    for (int position = 0; position < numSamples; position += chunkSize)
+    {
+        const int chunkLength = juce::jmin(chunkSize, numSamples - position);
+        float* mix = scratch.data();
+        juce::FloatVectorOperations::clear(mix, chunkLength);
+
+        for (auto* voice : tableVoices)
+            voice->updatePitch(chunkLength);
+
+        for (auto* voice : sourceVoices)
+            voice->updatePitch(chunkLength);
+
+        for (size_t first = 0; first < tableVoices.size(); first += lanes)
+        {
+            const int numInGroup = juce::jmin(lanes, static_cast<int>(tableVoices.size() - first));
+            renderTableGroup(tableVoices.data() + first, numInGroup, mix, chunkLength);
+        }
+
+        for (size_t first = 0; first < sourceVoices.size(); first += lanes)
+        {
+            const int numInGroup = juce::jmin(lanes, static_cast<int>(sourceVoices.size() - first));
+            renderSourceGroup(sourceVoices.data() + first, numInGroup, mix, chunkLength);
+        }
+
+        // Voices are mono - one add per channel for the whole batch
+        for (int channel = 0; channel < outputAudio.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::add(outputAudio.getWritePointer(channel, startSample + position), mix, chunkLength);
+    }
+}
+
+void BassSynthesiser::renderTableGroup(BassVoice* const* group, int numVoices, float* output, int numSamples)
+{
+    // Structure-of-arrays oscillator state, one lane per voice. Spare lanes
+    // play the first voice's table (at zero gain).
+    alignas(32) float phases[lanes] = {};
+    alignas(32) float phaseDeltas[lanes] = {};
+    alignas(32) float phaseDeltaSteps[lanes] = {};
+    const float* tables[lanes] = {};
+
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        tables[lane] = group[0]->currentTable;
+
+        if (lane >= numVoices)
+            continue;
+
+        const auto* voice = group[lane];
+        tables[lane] = voice->currentTable;
+        phases[lane] = static_cast<float>(voice->phase);
+        phaseDeltas[lane] = static_cast<float>(voice->phaseDelta);
+        phaseDeltaSteps[lane] = static_cast<float>(voice->phaseDeltaStep);
+    }
+
+    Vec phase = load(phases);
+    Vec phaseDelta = load(phaseDeltas);
+    const Vec phaseDeltaStep = load(phaseDeltaSteps);
+    const Vec length = broadcast(tableLength);
+
+    // Table reads are per lane; the interpolation is vectorised
+    alignas(32) float lower[lanes];
+    alignas(32) float upper[lanes];
+    alignas(32) float fractions[lanes];
+
+    renderGroup(group, numVoices, output, numSamples, [&]
+    {
+        store(phase, phases);
+
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const int index = static_cast<int>(phases[lane]);
+            fractions[lane] = phases[lane] - static_cast<float>(index);
+            lower[lane] = tables[lane][index];
+            upper[lane] = tables[lane][index + 1];
+        }
+
+        const Vec a = load(lower);
+        phase = wrap(phase + phaseDelta, length);
+        phaseDelta = phaseDelta + phaseDeltaStep;
+        return a + (load(upper) - a) * load(fractions);
+    });
+
+    // Hand the phases back
+    store(phase, phases);
+
+    for (int lane = 0; lane < numVoices; ++lane)
+        group[lane]->phase = phases[lane];
+}
+
+void BassSynthesiser::renderSourceGroup(BassVoice* const* group, int numVoices, float* output, int numSamples)
+{
+    // Each voice renders its sample or string mono into its own lane's block;
+    // spare lanes are silent
+    jassert(numSamples <= BassVoice::pitchUpdateInterval);
+    const float* sources[lanes] = {};
+
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        float* source = sourceScratch.data() + lane * BassVoice::pitchUpdateInterval;
+        sources[lane] = source;
+
+        if (lane < numVoices && group[lane]->isVoiceActive())
+            group[lane]->renderSource(source, numSamples);
+        else
+            juce::FloatVectorOperations::clear(source, numSamples);
+    }
+
+    alignas(32) float frame[lanes];
+    int position = 0;
+
+    renderGroup(group, numVoices, output, numSamples, [&]
+    {
+        for (int lane = 0; lane < lanes; ++lane)
+            frame[lane] = sources[lane][position];
+
+        ++position;
+        return load(frame);
+    });
+}
+
+template <typename ReadLanes>
+void BassSynthesiser::renderGroup(BassVoice* const* group, int numVoices, float* output, int numSamples, ReadLanes&& readLanes)
+{
+    // Envelope level, slope and velocity, one lane per voice; spare lanes have no gain
+    alignas(32) float levels[lanes] = {};
+    alignas(32) float slopes[lanes] = {};
+    alignas(32) float gains[lanes] = {};
+    bool sounding[lanes] = {};
+    int numSounding = 0;
+
+    for (int lane = 0; lane < numVoices; ++lane)
+    {
+        sounding[lane] = group[lane]->adsr.isActive();
+        gains[lane] = sounding[lane] ? group[lane]->currentVelocity : 0.0f;
+        numSounding += sounding[lane] ? 1 : 0;
+    }
+
+    int position = 0;
+
+    while (position < numSamples && numSounding > 0)
+    {
+        // Longest run over which every envelope in the group keeps its slope
+        int run = numSamples - position;
+
+        for (int lane = 0; lane < numVoices; ++lane)
+        {
+            if (sounding[lane])
+                run = juce::jmin(run, group[lane]->adsr.getSamplesBeforeTransition());
+        }
+
+        if (run == 0)
+        {
+            // Some envelope changes segment on this sample - step each one on its own
+            for (int lane = 0; lane < numVoices; ++lane)
+            {
+                if (!sounding[lane])
+                    continue;
+
+                auto& envelope = group[lane]->adsr;
+                levels[lane] = envelope.getNextSample();
+
+                if (!envelope.isActive())
+                {
+                    sounding[lane] = false;
+                    gains[lane] = 0.0f;
+                    --numSounding;
+                }
+            }
+
+            output[position++] += sum(readLanes() * load(levels) * load(gains));
+            continue;
+        }
+
+        for (int lane = 0; lane < numVoices; ++lane)
+        {
+            levels[lane] = sounding[lane] ? group[lane]->adsr.getLevel() : 0.0f;
+            slopes[lane] = sounding[lane] ? group[lane]->adsr.getSlope() : 0.0f;
+        }
+
+        Vec level = load(levels);
+        const Vec slope = load(slopes);
+        const Vec gain = load(gains);
+
+        for (int sample = 0; sample < run; ++sample)
+        {
+            level = level + slope;
+            output[position + sample] += sum(readLanes() * level * gain);
+        }
+
+        for (int lane = 0; lane < numVoices; ++lane)
+        {
+            if (sounding[lane])
+                group[lane]->adsr.skip(run);
+        }
+
+        position += run;
+    }
+
+    // Free voices whose release finished, or whose string or sample ran out
+    for (int lane = 0; lane < numVoices; ++lane)
+    {
+        auto* voice = group[lane];
+
+        if (voice->isVoiceActive() && (!sounding[lane] || voice->hasSourceEnded()))
+            voice->endNote();
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BassVoice.h"
+
+/**
+ * BassSynthesiser - juce::Synthesiser that renders BassVoices in SIMD batches
+ *
+ * Instead of every voice running its own scalar loop and adding each sample
+ * to every output channel, active voices are packed into groups the width of
+ * a SIMD register (4 with SSE/NEON). Each lane holds one voice's phase,
+ * increment, envelope level/slope and velocity; a group is rendered into a
+ * mono scratch block, which is summed into each output channel once.
+ * Chunks are at most BassVoice::pitchUpdateInterval samples: each voice
+ * updates its pitch once per chunk and its lane ramps the increment.
+ *
+ * Envelopes are linear within a segment, so a group runs vectorised until
+ * any of its voices reaches a segment boundary, steps that one sample per
+ * voice, and carries on. Voices playing recorded samples or the string
+ * model have no table to share, so each renders its source mono into a
+ * lane of its own scratch block, and their envelopes and velocities are
+ * batched across lanes the same way.
+ *
+ * Only BassVoices can be added (addVoice() is typed), and they're kept in
+ * a typed list as well, so allocation and rendering never dynamic_cast.
+ * Each note takes the articulation set when it starts and keeps it.
+ *
+ * Voice allocation: the engine adds a fixed pool of voicePoolSize voices up
+ * front, and setPolyphony() (1-64) only limits how many of them may sound at
+ * once, so it can change during playback without allocating. Past the
+ * limit, the quietest voice is stolen (released notes first, the oldest on
+ * a tie) and fades out over a few milliseconds on a spare pool voice while
+ * the new note starts. Mono and legato modes play one note at a time from
+ * a stack of held keys; legato changes pitch without retriggering.
+ */
+class BassSynthesiser : public juce::Synthesiser
+{
+public:
+    BassSynthesiser();
+
+    enum class VoiceMode
+    {
+        Poly,
+        Mono,   // One note, retriggered on every key
+        Legato  // One note, overlapping keys glide without retriggering
+    };
+
+    static constexpr int maxPolyphony = 64;
+    static constexpr int numFadeVoices = 8;  // Spare voices for stolen notes to fade out on
+    static constexpr int voicePoolSize = maxPolyphony + numFadeVoices;
+
+    // Largest block renderVoices() sees; bigger ones are rendered in chunks
+    void prepare(int samplesPerBlock);
+
+    // Hide juce::Synthesiser's untyped versions so every voice is a BassVoice
+    BassVoice* addVoice(BassVoice* newVoice);
+    void removeVoice(int index);
+    void clearVoices();
+    BassVoice* getBassVoice(int index) const;
+
+    // Audio thread: articulation for notes started from now on
+    void setArticulation(BassArticulation newArticulation) { articulation = newArticulation; }
+    BassArticulation getArticulation() const { return articulation; }
+
+    // Audio thread: synthesis model for notes started from now on
+    void setSynthesisModel(BassSynthesisModel newModel) { synthesisModel = newModel; }
+    BassSynthesisModel getSynthesisModel() const { return synthesisModel; }
+
+    // Audio thread, no allocation
+    void setPolyphony(int numVoices);
+    void setVoiceMode(VoiceMode newMode);
+    int getPolyphony() const { return polyphony; }
+    VoiceMode getVoiceMode() const { return voiceMode; }
+
+    // Audio thread, no allocation. Glide applies to legato slides.
+    void setPitchBendRange(float semitones);
+    void setGlideTime(float seconds);
+
+    // Public so the engine can play events at its own split points
+    using juce::Synthesiser::handleMidiEvent;
+
+    void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+    void noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+    void allNotesOff(int midiChannel, bool allowTailOff) override;
+    void handleController(int midiChannel, int controllerNumber, int controllerValue) override;
+
+protected:
+    void renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+
+    juce::SynthesiserVoice* findFreeVoice(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                          int midiNoteNumber, bool stealIfNoneAvailable) const override;
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                             int midiNoteNumber) const override;
+
+private:
+    std::vector<BassVoice*> bassVoices;  // Same voices as juce::Synthesiser::voices
+    std::vector<float> scratch;
+    std::vector<float> sourceScratch;        // One pitch block per lane
+    std::vector<BassVoice*> tableVoices;
+    std::vector<BassVoice*> sourceVoices;    // Playing a sample or the string
+
+    BassArticulation articulation = BassArticulation::Fingerstyle;
+    BassSynthesisModel synthesisModel = BassSynthesisModel::Wavetable;
+    float pitchBendRange = 2.0f;
+    float glideTime = 0.0f;
+    std::array<int, 17> modWheelValues {};  // Per MIDI channel (1-16), for notes started later
+    int polyphony = 8;
+    VoiceMode voiceMode = VoiceMode::Poly;
+
+    // Keys held in mono/legato modes, most recent last
+    struct HeldNote
+    {
+        int channel = 1;
+        int note = 0;
+        float velocity = 0.0f;
+    };
+
+    std::array<HeldNote, 128> heldNotes;
+    int numHeldNotes = 0;
+
+    BassVoice* monoVoice = nullptr;
+    int monoNote = -1;
+
+    int getVoiceLimit() const { return voiceMode == VoiceMode::Poly ? polyphony : 1; }
+    int countSoundingVoices() const;
+    BassVoice* findIdleVoice() const;
+    BassVoice* findQuietestVoice() const;
+    void fadeOutExcessVoices();
+    void startBassVoice(BassVoice* voice, juce::SynthesiserSound* sound,
+                        int midiChannel, int midiNoteNumber, float velocity);
+
+    juce::SynthesiserSound* findSound(int midiChannel, int midiNoteNumber) const;
+    void monoNoteOn(int midiChannel, int midiNoteNumber, float velocity);
+    void monoNoteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff);
+    void startMonoNote(int midiChannel, int midiNoteNumber, float velocity);
+    void removeHeldNote(int midiChannel, int midiNoteNumber);
+
+    void renderTableGroup(BassVoice* const* group, int numVoices, float* output, int numSamples);
+    void renderSourceGroup(BassVoice* const* group, int numVoices, float* output, int numSamples);
+
+    // Sums readLanes() (one source sample per voice) times each voice's envelope and velocity
+    template <typename ReadLanes>
+    void renderGroup(BassVoice* const* group, int numVoices, float* output, int numSamples, ReadLanes&& readLanes);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BassSynthesiser)
+};
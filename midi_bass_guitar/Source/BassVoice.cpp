@@ -1,16 +1,38 @@
 #include "BassVoice.h"
+#include "BassWavetableBank.h"
+#include "BassDiskStreamer.h"
+#include "BassStringModel.h"
 
 BassVoice::BassVoice()
+    : string(std::make_unique<BassStringModel>())
 {
     // Default ADSR for fingerstyle
-    updateADSRForArticulation();
+    updateEnvelope(true);
 }
 
+BassVoice::~BassVoice() = default;
+
 void BassVoice::prepare(double sampleRate, int samplesPerBlock)
 {
     juce::ignoreUnused(samplesPerBlock);
     currentSampleRate = sampleRate;
     adsr.setSampleRate(sampleRate);
+    string->prepare(sampleRate);
+    playingString = false;
+    sampleFrames.assign(static_cast<size_t>(sampleFramesSize), 0.0f);
+}
+
+void BassVoice::setWavetables(const BassWavetableBank* bank)
+{
+    wavetables = bank;
+    updateIncrements();
+}
+
+void BassVoice::setSampleStreaming(BassDiskStreamer* streamerToUse, BassSampleStream* streamToUse)
+{
+    stopSample();
+    streamer = streamerToUse;
+    stream = streamToUse;
 }
 
 bool BassVoice::canPlaySound(juce::SynthesiserSound* sound)
@@ -21,20 +43,55 @@ bool BassVoice::canPlaySound(juce::SynthesiserSound* sound)
 void BassVoice::startNote(int midiNoteNumber, float velocity,
                           juce::SynthesiserSound* sound, int currentPitchWheelPosition)
 {
-    juce::ignoreUnused(sound, currentPitchWheelPosition);
+    juce::ignoreUnused(sound);
+
+    // The articulation is fixed for the life of the note
+    currentArticulation = nextArticulation;
 
     // Store velocity for dynamics
     currentVelocity = velocity;
+    fadingOut = false;
 
     // Calculate frequency from MIDI note number
+    currentNote = midiNoteNumber;
     currentFrequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
-    angleDelta = currentFrequency * 2.0 * juce::MathConstants<double>::pi / currentSampleRate;
 
-    // Reset phase
-    currentAngle = 0.0;
+    // Reset phase, vibrato and slide; a bend already held applies straight away
+    phase = 0.0;
+    vibratoPhase = 0.0;
+    vibratoOffset = 0.0f;
+    glideOffset = 0.0f;
+    pitchWheelMoved(currentPitchWheelPosition);
+
+    // Play a recorded sample if the library has one for this note
+    stopSample();
+
+    if (streamer != nullptr && stream != nullptr)
+        currentZone = streamer->chooseZone(currentArticulation, midiNoteNumber, velocity);
+
+    if (currentZone != nullptr)
+    {
+        stream->start(*currentZone);
+        samplePosition = 0.0;
+        sampleLevel = 1.0f;
+    }
+
+    // Otherwise the string model, if that's what this note was started with
+    playingString = currentZone == nullptr && nextModel == BassSynthesisModel::String;
+
+    if (playingString)
+        string->start(currentArticulation, currentFrequency, velocity);
+
+    // Start at the target pitch rather than ramping up to it
+    pitchOffset = pitchBend;
+    updateIncrements();
+    phaseDelta = phaseDeltaTarget;
+    sampleDelta = sampleDeltaTarget;
+    phaseDeltaStep = 0.0;
+    sampleDeltaStep = 0.0;
 
     // Update ADSR based on articulation
-    updateADSRForArticulation();
+    updateEnvelope(false);
 
     // Start envelope
     adsr.noteOn();
@@ -44,6 +101,10 @@ void BassVoice::stopNote(float velocity, bool allowTailOff)
 {
     juce::ignoreUnused(velocity);
 
+    // A stolen voice keeps its short fade rather than the full release
+    if (fadingOut && allowTailOff)
+        return;
+
     if (allowTailOff)
     {
         adsr.noteOff();
@@ -52,163 +113,293 @@ void BassVoice::stopNote(float velocity, bool allowTailOff)
     {
         clearCurrentNote();
         adsr.reset();
+        stopSample();
+        playingString = false;
+    }
+}
+
+void BassVoice::startFadeOut()
+{
+    fadingOut = true;
+    adsr.fadeOut(stealFadeSeconds);
+}
+
+void BassVoice::glideToNote(int midiNoteNumber)
+{
+    // With a glide time, start from the pitch we're at and slide the rest of the way
+    if (glideTime > 0.0f)
+    {
+        glideOffset += static_cast<float>(currentNote - midiNoteNumber);
+        glideRate = std::abs(glideOffset) / (glideTime * static_cast<float>(currentSampleRate));
     }
+
+    currentNote = midiNoteNumber;
+    currentFrequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
+    pitchOffset = glideOffset + pitchBend + vibratoOffset;
+    updateIncrements();
 }
 
 void BassVoice::pitchWheelMoved(int newPitchWheelValue)
 {
-    juce::ignoreUnused(newPitchWheelValue);
-    // Could implement pitch bend here
+    // Centre is 8192; the next pitch update ramps to the new bend
+    pitchBend = static_cast<float>(newPitchWheelValue - 8192) / 8192.0f * pitchBendRange;
 }
 
 void BassVoice::controllerMoved(int controllerNumber, int newControllerValue)
 {
-    juce::ignoreUnused(controllerNumber, newControllerValue);
-    // Could implement CC modulation here
+    // Mod wheel sets the vibrato depth
+    if (controllerNumber == 1)
+        vibratoDepth = static_cast<float>(newControllerValue) / 127.0f * maxVibratoDepth;
+}
+
+void BassVoice::updatePitch(int numSamples)
+{
+    // Slide and vibrato move on by one control block
+    if (glideOffset != 0.0f)
+    {
+        const float step = glideRate * static_cast<float>(numSamples);
+        glideOffset = std::abs(glideOffset) <= step ? 0.0f : glideOffset - std::copysign(step, glideOffset);
+    }
+
+    vibratoOffset = 0.0f;
+
+    if (vibratoDepth > 0.0f)
+    {
+        vibratoPhase += vibratoRate * numSamples / currentSampleRate;
+        vibratoPhase -= std::floor(vibratoPhase);
+        vibratoOffset = vibratoDepth * std::sin(juce::MathConstants<float>::twoPi * static_cast<float>(vibratoPhase));
+    }
+
+    // This block starts where the last one ended
+    phaseDelta = phaseDeltaTarget;
+    sampleDelta = sampleDeltaTarget;
+
+    // Unmodulated notes never get past this check
+    const float offset = glideOffset + pitchBend + vibratoOffset;
+
+    if (offset != pitchOffset)
+    {
+        pitchOffset = offset;
+        updateIncrements();
+    }
+
+    phaseDeltaStep = (phaseDeltaTarget - phaseDelta) / numSamples;
+    sampleDeltaStep = (sampleDeltaTarget - sampleDelta) / numSamples;
+}
+
+void BassVoice::updateIncrements()
+{
+    // The one exp2 per control block; the render loops only add
+    const double frequency = currentFrequency * std::exp2(pitchOffset / 12.0);
+
+    if (wavetables != nullptr && frequency > 0.0)
+    {
+        // Mip level by the bent pitch, so a bend up never aliases
+        currentTable = wavetables->getTable(currentArticulation, frequency);
+        phaseDeltaTarget = wavetables->getPhaseDelta(frequency);
+    }
+
+    if (playingString)
+        string->setFrequency(frequency);
+
+    if (currentZone != nullptr)
+    {
+        // Repitch from the recorded note, and from the file's rate to ours
+        sampleDeltaTarget = frequency / juce::MidiMessage::getMidiNoteInHertz(currentZone->rootNote)
+                            * currentZone->sampleRate / currentSampleRate;
+    }
 }
 
 void BassVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
 {
-    if (!isVoiceActive())
+    // Pitch moves at control rate, in blocks of at most pitchUpdateInterval.
+    // Each block is rendered mono, shaped in one multiply and added to each channel once.
+    float* block = voiceBlock.data();
+    float* envelope = envelopeBlock.data();
+
+    while (numSamples > 0 && isVoiceActive())
+    {
+        const int blockSize = juce::jmin(numSamples, pitchUpdateInterval);
+        updatePitch(blockSize);
+
+        renderSource(block, blockSize);
+        adsr.getNextBlock(envelope, blockSize, currentVelocity);
+        juce::FloatVectorOperations::multiply(block, envelope, blockSize);
+
+        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::add(outputBuffer.getWritePointer(channel, startSample), block, blockSize);
+
+        if (!adsr.isActive() || hasSourceEnded())
+            endNote();
+
+        startSample += blockSize;
+        numSamples -= blockSize;
+    }
+}
+
+void BassVoice::renderSource(float* output, int numSamples)
+{
+    if (currentZone != nullptr)
+        renderSample(output, numSamples);
+    else if (playingString)
+        string->process(output, numSamples);  // The string decays by itself; the envelope only adds the release and steal fades
+    else
+        renderTable(output, numSamples);
+}
+
+void BassVoice::renderTable(float* output, int numSamples)
+{
+    if (currentTable == nullptr)
+    {
+        juce::FloatVectorOperations::clear(output, numSamples);
         return;
+    }
 
-    while (--numSamples >= 0)
+    const float* table = currentTable;
+    constexpr double tableLength = BassWavetableBank::tableSize;
+
+    for (int i = 0; i < numSamples; ++i)
     {
-        // Generate bass waveform based on articulation
-        float currentSample = generateBassWaveform();
+        // Read the band-limited table (the guard sample saves a wrap check)
+        const int index = static_cast<int>(phase);
+        const float fraction = static_cast<float>(phase - index);
+        output[i] = table[index] + fraction * (table[index + 1] - table[index]);
 
-        // Apply ADSR envelope
-        currentSample *= adsr.getNextSample();
+        phase += phaseDelta;
+        phaseDelta += phaseDeltaStep;
 
-        // Apply velocity
-        currentSample *= currentVelocity;
+        if (phase >= tableLength)
+            phase -= tableLength;
+    }
+}
 
-        // Write to all output channels
-        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+void BassVoice::renderSample(float* output, int numSamples)
+{
+    // Leave room to interpolate past the last output sample of a chunk. The
+    // increment ramps towards its target, so size chunks by the larger of the two.
+    const double maxDelta = juce::jmax(sampleDelta, sampleDeltaTarget);
+    const int maxChunk = juce::jmax(1, static_cast<int>((sampleFramesSize - 3) / maxDelta));
+
+    while (numSamples > 0)
+    {
+        // The recording has run out - silence until the voice is freed
+        if (hasSourceEnded())
         {
-            outputBuffer.addSample(channel, startSample, currentSample);
+            juce::FloatVectorOperations::clear(output, numSamples);
+            return;
         }
 
-        // Advance phase
-        currentAngle += angleDelta;
-        if (currentAngle > 2.0 * juce::MathConstants<double>::pi)
-            currentAngle -= 2.0 * juce::MathConstants<double>::pi;
+        const int chunk = juce::jmin(numSamples, maxChunk);
+        const auto firstFrame = static_cast<juce::int64>(samplePosition);
+        const auto lastFrame = static_cast<juce::int64>(samplePosition + (chunk - 1) * maxDelta) + 1;
 
-        ++startSample;
+        // Preload or ring buffer - never the disk
+        const int numFrames = static_cast<int>(lastFrame - firstFrame) + 1;
+        stream->read(firstFrame, sampleFrames.data(), numFrames);
 
-        // Stop voice when envelope is complete
-        if (!adsr.isActive())
+        const float* frames = sampleFrames.data();
+        const auto range = juce::FloatVectorOperations::findMinAndMax(frames, numFrames);
+        sampleLevel = juce::jmax(-range.getStart(), range.getEnd());
+        double position = samplePosition - static_cast<double>(firstFrame);
+
+        for (int i = 0; i < chunk; ++i)
         {
-            clearCurrentNote();
-            break;
+            const int index = static_cast<int>(position);
+            const float fraction = static_cast<float>(position - index);
+            output[i] = frames[index] + fraction * (frames[index + 1] - frames[index]);
+
+            position += sampleDelta;
+            sampleDelta += sampleDeltaStep;
         }
+
+        samplePosition = static_cast<double>(firstFrame) + position;
+        output += chunk;
+        numSamples -= chunk;
+
+        if (!hasSourceEnded())
+            stream->setConsumedFrame(static_cast<juce::int64>(samplePosition));
     }
 }
 
-void BassVoice::setArticulation(BassArticulation articulation)
+bool BassVoice::hasSourceEnded() const
 {
-    currentArticulation = articulation;
-    updateADSRForArticulation();
+    if (currentZone != nullptr)
+        return samplePosition >= static_cast<double>(currentZone->lengthInSamples);
+
+    return playingString && string->isSilent();
+}
+
+float BassVoice::getCurrentLevel() const
+{
+    // Strings and samples decay by themselves under a held envelope, so their own level counts too
+    float level = adsr.getLevel() * currentVelocity;
+
+    if (isPlayingSample())
+        level *= sampleLevel;
+    else if (playingString)
+        level *= string->getPeak();
+
+    return level;
 }
 
-void BassVoice::updateADSRForArticulation()
+void BassVoice::stopSample()
+{
+    if (currentZone == nullptr)
+        return;
+
+    currentZone = nullptr;
+    stream->stop();
+}
+
+void BassVoice::endNote()
+{
+    adsr.reset();
+    stopSample();
+    playingString = false;
+    clearCurrentNote();
+}
+
+juce::ADSR::Parameters BassVoice::getArticulationEnvelope(BassArticulation articulation)
 {
     // Different ADSR envelopes for each articulation
-    switch (currentArticulation)
+    switch (articulation)
     {
         case BassArticulation::Picked:
             // Fast attack, short decay, medium sustain, short release
-            adsrParams.attack = 0.001f;   // 1ms - sharp attack
-            adsrParams.decay = 0.1f;
-            adsrParams.sustain = 0.6f;
-            adsrParams.release = 0.1f;
-            break;
+            return { 0.001f, 0.1f, 0.6f, 0.1f };     // 1ms - sharp attack
 
         case BassArticulation::Fingerstyle:
             // Slower attack, longer decay, higher sustain, longer release
-            adsrParams.attack = 0.005f;   // 5ms - softer attack
-            adsrParams.decay = 0.15f;
-            adsrParams.sustain = 0.8f;
-            adsrParams.release = 0.2f;
-            break;
+            return { 0.005f, 0.15f, 0.8f, 0.2f };    // 5ms - softer attack
 
         case BassArticulation::Slap:
             // Very fast attack, quick decay, low sustain, very short release
-            adsrParams.attack = 0.0005f;  // 0.5ms - percussive
-            adsrParams.decay = 0.05f;
-            adsrParams.sustain = 0.3f;
-            adsrParams.release = 0.05f;
-            break;
+            return { 0.0005f, 0.05f, 0.3f, 0.05f };  // 0.5ms - percussive
 
         case BassArticulation::Muted:
             // Fast attack, very quick decay, very low sustain, very short release
-            adsrParams.attack = 0.001f;
-            adsrParams.decay = 0.02f;
-            adsrParams.sustain = 0.1f;
-            adsrParams.release = 0.02f;
-            break;
-    }
-
-    adsr.setParameters(adsrParams);
-}
-
-float BassVoice::generateBassWaveform()
-{
-    // Generate appropriate waveform based on articulation
-    switch (currentArticulation)
-    {
-        case BassArticulation::Picked:
-            return generatePickedTone();
-        case BassArticulation::Fingerstyle:
-            return generateFingerstyleTone();
-        case BassArticulation::Slap:
-            return generateSlapTone();
-        case BassArticulation::Muted:
-            return generateMutedTone();
-        default:
-            return 0.0f;
+            return { 0.001f, 0.02f, 0.1f, 0.02f };
     }
-}
-
-float BassVoice::generatePickedTone()
-{
-    // Bright, punchy tone - more harmonics
-    // Mix of sine and triangle wave for brightness
-    float fundamental = std::sin(currentAngle);
-    float harmonic2 = std::sin(currentAngle * 2.0) * 0.3f;
-    float harmonic3 = std::sin(currentAngle * 3.0) * 0.15f;
 
-    return (fundamental + harmonic2 + harmonic3) * 0.6f;
+    return {};
 }
 
-float BassVoice::generateFingerstyleTone()
+void BassVoice::updateEnvelope(bool forceUpdate)
 {
-    // Warm, smooth tone - more fundamental, fewer harmonics
-    // Mostly sine wave with slight 2nd harmonic
-    float fundamental = std::sin(currentAngle);
-    float harmonic2 = std::sin(currentAngle * 2.0) * 0.15f;
+    const bool releaseOnly = currentZone != nullptr || playingString;
 
-    return (fundamental + harmonic2) * 0.7f;
-}
+    // Most notes repeat the last one's articulation - nothing to recalculate
+    if (!forceUpdate && currentArticulation == envelopeArticulation && releaseOnly == envelopeReleaseOnly)
+        return;
 
-float BassVoice::generateSlapTone()
-{
-    // Percussive, bright tone - lots of high harmonics
-    // Mix of multiple harmonics for aggressive character
-    float fundamental = std::sin(currentAngle);
-    float harmonic2 = std::sin(currentAngle * 2.0) * 0.4f;
-    float harmonic3 = std::sin(currentAngle * 3.0) * 0.25f;
-    float harmonic4 = std::sin(currentAngle * 4.0) * 0.15f;
-    float harmonic5 = std::sin(currentAngle * 5.0) * 0.1f;
+    envelopeArticulation = currentArticulation;
+    envelopeReleaseOnly = releaseOnly;
 
-    return (fundamental + harmonic2 + harmonic3 + harmonic4 + harmonic5) * 0.5f;
-}
+    const auto parameters = getArticulationEnvelope(currentArticulation);
 
-float BassVoice::generateMutedTone()
-{
-    // Dull, short tone - very few harmonics, low-passed
-    // Mostly fundamental with quick decay
-    float fundamental = std::sin(currentAngle);
-
-    return fundamental * 0.4f;
+    // Recordings and the string carry their own attack and decay; the envelope only shapes the release
+    if (releaseOnly)
+        adsr.setParameters({ 0.0f, 0.0f, 1.0f, parameters.release });
+    else
+        adsr.setParameters(parameters);
 }
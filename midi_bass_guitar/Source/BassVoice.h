@@ -1,5 +1,12 @@
 #pragma once
 #include <JuceHeader.h>
+#include "BassEnvelope.h"
+
+class BassWavetableBank;
+class BassDiskStreamer;
+class BassSampleStream;
+class BassStringModel;
+struct BassSampleZone;
 
 /**
  * Bass Articulations - Different playing techniques
@@ -13,10 +20,19 @@ enum class BassArticulation
 };
 
 /**
- * BassSound - Describes the sound/sample that can be played
+ * How a voice synthesises notes the sample library doesn't cover
+ */
+enum class BassSynthesisModel
+{
+    Wavetable,   // Band-limited tables with an ADSR
+    String       // Waveguide string (BassStringModel)
+};
+
+/**
+ * BassSound - Describes the range of notes that can be played
  *
- * In a full implementation, this would load actual audio samples.
- * For now, it defines the parameters for synthesis.
+ * What actually plays is up to the voice: a sample from the engine's
+ * library when one covers the note, the wavetable synth otherwise.
  */
 class BassSound : public juce::SynthesiserSound
 {
@@ -45,18 +61,24 @@ private:
  * Handles:
  * - MIDI note on/off
  * - Velocity sensitivity
- * - Different articulations
- * - ADSR envelope
- * - Realistic bass tone generation
- *
- * NOTE: Currently synthesizes bass tones. Can be extended to play
- * actual audio samples by loading them in startNote() and playing
- * them back instead of synthesis.
+ * - Different articulations, latched when a note starts - changing the
+ *   articulation never alters a note that is already sounding
+ * - ADSR envelope (linear segments, so BassSynthesiser can batch voices)
+ * - Pitch wheel bends, mod wheel (CC1) vibrato and legato slides. These are
+ *   summed in semitones and turned into a phase increment once per control
+ *   block of pitchUpdateInterval samples - one exp2() - and the increment
+ *   ramps linearly across the block, so there's no per-sample pow() and no
+ *   zipper noise. An unmodulated note skips even that.
+ * - Sample playback from the engine's library, streamed from disk by
+ *   BassDiskStreamer. When no library is loaded or it doesn't cover the
+ *   note, the shared wavetables or the voice's own waveguide string play it,
+ *   per the synthesis model latched at note start.
  */
 class BassVoice : public juce::SynthesiserVoice
 {
 public:
     BassVoice();
+    ~BassVoice() override;
 
     bool canPlaySound(juce::SynthesiserSound* sound) override;
     void startNote(int midiNoteNumber, float velocity,
@@ -66,36 +88,118 @@ public:
     void controllerMoved(int controllerNumber, int newControllerValue) override;
     void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override;
 
-    // Set current articulation
-    void setArticulation(BassArticulation articulation);
+    // Articulation the next startNote() plays; a sounding note keeps its own
+    void setNextArticulation(BassArticulation articulation) { nextArticulation = articulation; }
+    BassArticulation getArticulation() const { return currentArticulation; }
+
+    // Likewise for the synthesis model
+    void setNextSynthesisModel(BassSynthesisModel model) { nextModel = model; }
 
     // Prepare for playback
     void prepare(double sampleRate, int samplesPerBlock);
 
+    // Band-limited tables shared by all voices (owned by the engine)
+    void setWavetables(const BassWavetableBank* bank);
+
+    // Sample library and this voice's own disk stream (owned by the engine)
+    void setSampleStreaming(BassDiskStreamer* streamerToUse, BassSampleStream* streamToUse);
+    bool isPlayingSample() const { return currentZone != nullptr; }
+    bool isPlayingString() const { return playingString; }
+
+    // Pitch modulation settings (BassSynthesiser)
+    void setPitchBendRange(float semitones) { pitchBendRange = semitones; }
+    void setGlideTime(float seconds) { glideTime = juce::jmax(0.0f, seconds); }
+
+    // Samples between pitch updates; renderers step updatePitch() at this rate
+    static constexpr int pitchUpdateInterval = 64;
+
+    // Voice allocation (BassSynthesiser)
+    void startFadeOut();                   // Short fade instead of a click when stolen
+    bool isFadingOut() const { return fadingOut; }
+    float getCurrentLevel() const;         // For stealing: the envelope, velocity and source level together
+    void glideToNote(int midiNoteNumber);  // Legato: new pitch (sliding if a glide time is set), envelope carries on
+
 private:
-    // Current articulation
+    // Articulation of the sounding note, and of the next one
     BassArticulation currentArticulation = BassArticulation::Fingerstyle;
+    BassArticulation nextArticulation = BassArticulation::Fingerstyle;
 
-    // Sound generation
-    double currentAngle = 0.0;
-    double angleDelta = 0.0;
+    // Sound generation - phase accumulator over the current table
+    const BassWavetableBank* wavetables = nullptr;
+    const float* currentTable = nullptr;
+    double phase = 0.0;        // In table samples
+    double phaseDelta = 0.0;   // Per sample, ramping by phaseDeltaStep to phaseDeltaTarget
+    double phaseDeltaStep = 0.0;
+    double phaseDeltaTarget = 0.0;
     double currentSampleRate = 44100.0;
-    double currentFrequency = 0.0;
+    double currentFrequency = 0.0;  // The note's own pitch, before modulation
+    int currentNote = 0;
     float currentVelocity = 0.0f;
+    bool fadingOut = false;
+
+    static constexpr float stealFadeSeconds = 0.005f;
+
+    // Sample playback - position in frames of the zone's file
+    BassDiskStreamer* streamer = nullptr;
+    BassSampleStream* stream = nullptr;
+    const BassSampleZone* currentZone = nullptr;
+    double samplePosition = 0.0;
+    double sampleDelta = 1.0;
+    double sampleDeltaStep = 0.0;
+    double sampleDeltaTarget = 1.0;
+    std::vector<float> sampleFrames;  // Source frames for one chunk of output
+    float sampleLevel = 1.0f;         // Peak of the frames last read
 
-    // ADSR envelope
-    juce::ADSR adsr;
-    juce::ADSR::Parameters adsrParams;
+    static constexpr int sampleFramesSize = 1024;
+
+    // Waveguide string, when the note isn't sampled and the model asks for it
+    std::unique_ptr<BassStringModel> string;
+    BassSynthesisModel nextModel = BassSynthesisModel::Wavetable;
+    bool playingString = false;
+
+    // ADSR envelope, and what its parameters were last set for
+    BassEnvelope adsr;
+    BassArticulation envelopeArticulation = BassArticulation::Fingerstyle;
+    bool envelopeReleaseOnly = false;
 
     // Articulation-specific parameters
-    void updateADSRForArticulation();
-
-    // Tone generation (synthesis - can be replaced with sample playback)
-    float generateBassWaveform();
-    float generatePickedTone();
-    float generateFingerstyleTone();
-    float generateSlapTone();
-    float generateMutedTone();
+    static juce::ADSR::Parameters getArticulationEnvelope(BassArticulation articulation);
+    void updateEnvelope(bool forceUpdate);
+
+    // Pitch modulation, in semitones from the note's own pitch
+    float pitchBendRange = 2.0f;
+    float pitchBend = 0.0f;
+    float vibratoDepth = 0.0f;      // Peak, from the mod wheel
+    float vibratoOffset = 0.0f;
+    double vibratoPhase = 0.0;      // In cycles
+    float glideTime = 0.0f;         // Seconds
+    float glideOffset = 0.0f;       // Still to slide; decays to zero
+    float glideRate = 0.0f;         // Semitones per sample
+    float pitchOffset = 0.0f;       // What the increment targets were computed for
+
+    static constexpr double vibratoRate = 5.5;    // Hz
+    static constexpr float maxVibratoDepth = 0.5f; // Semitones, mod wheel fully up
+
+    // Advance bend, vibrato and slide by one control block and set up the increment ramps
+    void updatePitch(int numSamples);
+
+    // Increment targets and table (mip level by pitch) for the current pitch offset
+    void updateIncrements();
+
+    // Mono, before the envelope and velocity: the table, the string or the sample
+    void renderSource(float* output, int numSamples);
+    void renderTable(float* output, int numSamples);
+    void renderSample(float* output, int numSamples);
+    bool hasSourceEnded() const;  // The string died away or the recording ran out
+    void stopSample();
+    void endNote();               // Frees the voice, whatever it was playing
+
+    // renderNextBlock()'s mono block and the envelope times velocity for it
+    std::array<float, pitchUpdateInterval> voiceBlock {};
+    std::array<float, pitchUpdateInterval> envelopeBlock {};
+
+    // Renders active voices in SIMD batches straight from this state
+    friend class BassSynthesiser;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BassVoice)
 };
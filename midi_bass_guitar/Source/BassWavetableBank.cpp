@@ -0,0 +1,105 @@
+#include "BassWavetableBank.h"
+#include "SharedAssetCache.h"
+
+namespace
+{
+    // Harmonic amplitudes (fundamental first, zero-padded) and output level per articulation
+    struct HarmonicRecipe
+    {
+        std::array<float, 5> harmonics;
+        float gain;
+    };
+
+    HarmonicRecipe getRecipe(BassArticulation articulation)
+    {
+        switch (articulation)
+        {
+            // Bright, punchy tone - more harmonics
+            case BassArticulation::Picked:      return { { 1.0f, 0.3f, 0.15f }, 0.6f };
+
+            // Warm, smooth tone - mostly fundamental with a slight 2nd harmonic
+            case BassArticulation::Fingerstyle: return { { 1.0f, 0.15f }, 0.7f };
+
+            // Percussive, bright tone - lots of upper harmonics
+            case BassArticulation::Slap:        return { { 1.0f, 0.4f, 0.25f, 0.15f, 0.1f }, 0.5f };
+
+            // Dull, short tone - fundamental only
+            case BassArticulation::Muted:
+            default:                            return { { 1.0f }, 0.4f };
+        }
+    }
+}
+
+void BassWavetableBank::prepare(double sampleRate)
+{
+    if (sampleRate == currentSampleRate)
+        return;
+
+    currentSampleRate = sampleRate;
+    tables.setSize(numArticulations * numLevels, tableSize + 1);
+
+    for (int articulation = 0; articulation < numArticulations; ++articulation)
+        for (int level = 0; level < numLevels; ++level)
+            buildTable(tables.getWritePointer(articulation * numLevels + level),
+                       static_cast<BassArticulation>(articulation), level);
+}
+
+std::shared_ptr<const BassWavetableBank> BassWavetableBank::getShared(double sampleRate)
+{
+    // The recipes are compiled in, so the tables depend only on the rate and layout
+    auto hash = SharedAssetCache::hashValue(sampleRate);
+    hash = SharedAssetCache::hashValue(tableSize, hash);
+    hash = SharedAssetCache::hashValue(numLevels, hash);
+
+    const auto key = SharedAssetCache::makeKey("BassWavetableBank", hash);
+
+    return SharedAssetCache::getInstance().getOrCreate<BassWavetableBank>(key, [sampleRate]()
+    {
+        auto bank = std::make_shared<BassWavetableBank>();
+        bank->prepare(sampleRate);
+        return bank;
+    });
+}
+
+const float* BassWavetableBank::getTable(BassArticulation articulation, double frequency) const
+{
+    jassert(currentSampleRate > 0.0); // prepare() first
+    return tables.getReadPointer(static_cast<int>(articulation) * numLevels + getLevel(frequency));
+}
+
+int BassWavetableBank::getLevel(double frequency)
+{
+    // Level n serves fundamentals up to lowestLevelTop * 2^n
+    const int level = static_cast<int>(std::ceil(std::log2(juce::jmax(1.0, frequency) / lowestLevelTop)));
+    return juce::jlimit(0, numLevels - 1, level);
+}
+
+void BassWavetableBank::buildTable(float* table, BassArticulation articulation, int level) const
+{
+    const auto recipe = getRecipe(articulation);
+    const double highestFundamental = lowestLevelTop * std::exp2(level);
+    const double nyquist = currentSampleRate * 0.5;
+
+    juce::FloatVectorOperations::clear(table, tableSize + 1);
+
+    for (size_t index = 0; index < recipe.harmonics.size(); ++index)
+    {
+        const float amplitude = recipe.harmonics[index] * recipe.gain;
+        const int harmonic = static_cast<int>(index) + 1;
+
+        // Everything from here up would alias for the top note of the level
+        if (harmonic * highestFundamental >= nyquist)
+            break;
+
+        if (amplitude == 0.0f)
+            continue;
+
+        const double phaseStep = juce::MathConstants<double>::twoPi * harmonic / tableSize;
+
+        for (int sample = 0; sample < tableSize; ++sample)
+            table[sample] += amplitude * static_cast<float>(std::sin(phaseStep * sample));
+    }
+
+    // Guard sample so interpolation never has to wrap
+    table[tableSize] = table[0];
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BassVoice.h"
+
+/**
+ * BassWavetableBank - Band-limited single-cycle tables for every articulation
+ *
+ * Each articulation's harmonic recipe is rendered once per sample rate into
+ * a set of mip levels, one per octave of fundamental frequency. A level
+ * only contains the harmonics that stay below Nyquist for the highest note
+ * it serves, so high notes never alias. Sampler engines take theirs from
+ * getShared(), so every instance at the same rate plays one read-only copy;
+ * voices play it back with a phase accumulator and linear interpolation.
+ */
+class BassWavetableBank
+{
+public:
+    static constexpr int tableSize = 2048;  // Power of two, plus one guard sample per table
+    static constexpr int numLevels = 10;    // Octaves of fundamental above lowestLevelTop
+
+    // Not real-time safe. Rebuilds only when the sample rate changes.
+    void prepare(double sampleRate);
+
+    // Not real-time safe. The process-wide bank for this rate, built on first use.
+    static std::shared_ptr<const BassWavetableBank> getShared(double sampleRate);
+
+    // Table for a note at the given fundamental (tableSize + 1 samples, last = first)
+    const float* getTable(BassArticulation articulation, double frequency) const;
+
+    // Phase increment in table samples per output sample
+    double getPhaseDelta(double frequency) const { return frequency * tableSize / currentSampleRate; }
+
+private:
+    static constexpr int numArticulations = 4;
+    static constexpr double lowestLevelTop = 32.0; // Highest fundamental served by level 0 (Hz)
+
+    double currentSampleRate = 0.0;
+
+    // One channel per articulation/level pair
+    juce::AudioBuffer<float> tables;
+
+    static int getLevel(double frequency);
+    void buildTable(float* table, BassArticulation articulation, int level) const;
+};
@@ -3,10 +3,10 @@
 
 MIDIBassGuitarAudioProcessorEditor::MIDIBassGuitarAudioProcessorEditor(
     MIDIBassGuitarAudioProcessor& p)
-    : AudioProcessorEditor(&p), audioProcessor(p)
+    : AudioProcessorEditor(&p), audioProcessor(p), loadMeter(p.getLoadMonitor())
 {
     // Set window size - bass instrument panel
-    setSize(650, 450);
+    setSize(650, 610);
 
     // Articulation selector
     articulationLabel.setText("ARTICULATION", juce::dontSendNotification);
@@ -102,6 +102,83 @@ MIDIBassGuitarAudioProcessorEditor::MIDIBassGuitarAudioProcessorEditor(
     outputGainSlider.addListener(this);
     addAndMakeVisible(outputGainSlider);
 
+    // Voice mode selector
+    voiceModeLabel.setText("VOICE MODE", juce::dontSendNotification);
+    voiceModeLabel.setColour(juce::Label::textColourId, bassTextColor);
+    voiceModeLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(voiceModeLabel);
+
+    voiceModeSelector.addItem("Poly", 1);
+    voiceModeSelector.addItem("Mono", 2);
+    voiceModeSelector.addItem("Legato", 3);
+    voiceModeSelector.setSelectedId(audioProcessor.voiceModeParam->getIndex() + 1);
+    voiceModeSelector.addListener(this);
+    addAndMakeVisible(voiceModeSelector);
+
+    // Polyphony slider
+    polyphonyLabel.setText("POLYPHONY", juce::dontSendNotification);
+    polyphonyLabel.setColour(juce::Label::textColourId, bassTextColor);
+    polyphonyLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(polyphonyLabel);
+
+    polyphonySlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    polyphonySlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 40, 20);
+    polyphonySlider.setRange(1.0, BassSynthesiser::maxPolyphony, 1.0);
+    polyphonySlider.setValue(audioProcessor.polyphonyParam->get());
+    polyphonySlider.addListener(this);
+    addAndMakeVisible(polyphonySlider);
+
+    // Pitch bend range slider
+    pitchBendRangeLabel.setText("BEND RANGE", juce::dontSendNotification);
+    pitchBendRangeLabel.setColour(juce::Label::textColourId, bassTextColor);
+    pitchBendRangeLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(pitchBendRangeLabel);
+
+    pitchBendRangeSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    pitchBendRangeSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 40, 20);
+    pitchBendRangeSlider.setRange(0.0, 12.0, 1.0);
+    pitchBendRangeSlider.setValue(audioProcessor.pitchBendRangeParam->get());
+    pitchBendRangeSlider.addListener(this);
+    addAndMakeVisible(pitchBendRangeSlider);
+
+    // Glide time slider
+    glideTimeLabel.setText("GLIDE", juce::dontSendNotification);
+    glideTimeLabel.setColour(juce::Label::textColourId, bassTextColor);
+    glideTimeLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(glideTimeLabel);
+
+    glideTimeSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    glideTimeSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 40, 20);
+    glideTimeSlider.setRange(0.0, 1.0, 0.01);
+    glideTimeSlider.setValue(*audioProcessor.glideTimeParam);
+    glideTimeSlider.addListener(this);
+    addAndMakeVisible(glideTimeSlider);
+
+    // Synthesis model selector
+    synthesisModelLabel.setText("SYNTH MODEL", juce::dontSendNotification);
+    synthesisModelLabel.setColour(juce::Label::textColourId, bassTextColor);
+    synthesisModelLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(synthesisModelLabel);
+
+    synthesisModelSelector.addItem("Wavetable", 1);
+    synthesisModelSelector.addItem("String", 2);
+    synthesisModelSelector.setSelectedId(audioProcessor.synthesisModelParam->getIndex() + 1);
+    synthesisModelSelector.addListener(this);
+    addAndMakeVisible(synthesisModelSelector);
+
+    // Sample library
+    loadSamplesButton.setColour(juce::TextButton::buttonColourId, bassHighlightColor);
+    loadSamplesButton.setColour(juce::TextButton::textColourOffId, bassTextColor);
+    loadSamplesButton.onClick = [this]() { chooseSampleLibrary(); };
+    addAndMakeVisible(loadSamplesButton);
+
+    sampleLibraryLabel.setColour(juce::Label::textColourId, bassTextColor.withAlpha(0.7f));
+    sampleLibraryLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(sampleLibraryLabel);
+
+    loadMeter.setAccentColour(bassLogoColor);
+    addAndMakeVisible(loadMeter);
+
     // Start timer for parameter updates
     startTimerHz(30);
 }
@@ -185,6 +262,8 @@ void MIDIBassGuitarAudioProcessorEditor::resized()
     bounds.removeFromTop(120);  // Skip header
     bounds.removeFromBottom(30); // Skip footer
 
+    loadMeter.setBounds(getWidth() - 110, 86, 90, 20);
+
     // Top section - Articulation and Tone selectors
     auto topSection = bounds.removeFromTop(100);
 
@@ -230,6 +309,45 @@ void MIDIBassGuitarAudioProcessorEditor::resized()
     auto outputArea = eqSection.withX(startX + (knobWidth + spacing) * 4).withWidth(knobWidth);
     outputGainLabel.setBounds(outputArea.removeFromTop(20));
     outputGainSlider.setBounds(outputArea);
+
+    bounds.removeFromTop(15); // Spacing
+
+    // Voice allocation row
+    auto voiceSection = bounds.removeFromTop(30).reduced(30, 0);
+
+    auto voiceModeArea = voiceSection.removeFromLeft(voiceSection.getWidth() / 2);
+    voiceModeLabel.setBounds(voiceModeArea.removeFromLeft(100));
+    voiceModeSelector.setBounds(voiceModeArea.reduced(10, 2));
+
+    polyphonyLabel.setBounds(voiceSection.removeFromLeft(100));
+    polyphonySlider.setBounds(voiceSection.reduced(10, 2));
+
+    bounds.removeFromTop(10); // Spacing
+
+    // Pitch row
+    auto pitchSection = bounds.removeFromTop(30).reduced(30, 0);
+
+    auto bendArea = pitchSection.removeFromLeft(pitchSection.getWidth() / 2);
+    pitchBendRangeLabel.setBounds(bendArea.removeFromLeft(100));
+    pitchBendRangeSlider.setBounds(bendArea.reduced(10, 2));
+
+    glideTimeLabel.setBounds(pitchSection.removeFromLeft(100));
+    glideTimeSlider.setBounds(pitchSection.reduced(10, 2));
+
+    bounds.removeFromTop(10); // Spacing
+
+    // Synthesis model row
+    auto modelSection = bounds.removeFromTop(30).reduced(30, 0);
+    modelSection = modelSection.removeFromLeft(modelSection.getWidth() / 2);
+    synthesisModelLabel.setBounds(modelSection.removeFromLeft(100));
+    synthesisModelSelector.setBounds(modelSection.reduced(10, 2));
+
+    bounds.removeFromTop(10); // Spacing
+
+    // Sample library row
+    auto sampleSection = bounds.removeFromTop(25).reduced(30, 0);
+    loadSamplesButton.setBounds(sampleSection.removeFromLeft(110));
+    sampleLibraryLabel.setBounds(sampleSection.withTrimmedLeft(10));
 }
 
 void MIDIBassGuitarAudioProcessorEditor::timerCallback()
@@ -237,6 +355,17 @@ void MIDIBassGuitarAudioProcessorEditor::timerCallback()
     // Sync GUI with parameters (for DAW automation)
     articulationSelector.setSelectedId(audioProcessor.articulationParam->getIndex() + 1, juce::dontSendNotification);
     toneSelector.setSelectedId(audioProcessor.toneParam->getIndex() + 1, juce::dontSendNotification);
+    voiceModeSelector.setSelectedId(audioProcessor.voiceModeParam->getIndex() + 1, juce::dontSendNotification);
+    polyphonySlider.setValue(audioProcessor.polyphonyParam->get(), juce::dontSendNotification);
+    pitchBendRangeSlider.setValue(audioProcessor.pitchBendRangeParam->get(), juce::dontSendNotification);
+    glideTimeSlider.setValue(*audioProcessor.glideTimeParam, juce::dontSendNotification);
+    synthesisModelSelector.setSelectedId(audioProcessor.synthesisModelParam->getIndex() + 1, juce::dontSendNotification);
+
+    // Pick up libraries restored from a saved session
+    const auto libraryFile = audioProcessor.getSampleLibraryFile();
+    sampleLibraryLabel.setText(libraryFile == juce::File() ? juce::String("NO SAMPLES - SYNTH VOICES")
+                                                           : libraryFile.getFileName().toUpperCase(),
+                               juce::dontSendNotification);
 
     bassSlider.setValue(*audioProcessor.bassParam, juce::dontSendNotification);
     midSlider.setValue(*audioProcessor.midParam, juce::dontSendNotification);
@@ -257,6 +386,16 @@ void MIDIBassGuitarAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboBo
         int index = toneSelector.getSelectedId() - 1;
         audioProcessor.toneParam->setValueNotifyingHost(index / 4.0f);
     }
+    else if (comboBoxThatHasChanged == &voiceModeSelector)
+    {
+        int index = voiceModeSelector.getSelectedId() - 1;
+        audioProcessor.voiceModeParam->setValueNotifyingHost(index / 2.0f);
+    }
+    else if (comboBoxThatHasChanged == &synthesisModelSelector)
+    {
+        int index = synthesisModelSelector.getSelectedId() - 1;
+        audioProcessor.synthesisModelParam->setValueNotifyingHost(static_cast<float>(index));
+    }
 }
 
 void MIDIBassGuitarAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
@@ -271,4 +410,31 @@ void MIDIBassGuitarAudioProcessorEditor::sliderValueChanged(juce::Slider* slider
         audioProcessor.compressionParam->setValueNotifyingHost(compressionSlider.getValue());
     else if (slider == &outputGainSlider)
         audioProcessor.outputGainParam->setValueNotifyingHost(outputGainSlider.getValue());
+    else if (slider == &polyphonySlider)
+        audioProcessor.polyphonyParam->setValueNotifyingHost(
+            audioProcessor.polyphonyParam->convertTo0to1(static_cast<float>(polyphonySlider.getValue())));
+    else if (slider == &pitchBendRangeSlider)
+        audioProcessor.pitchBendRangeParam->setValueNotifyingHost(
+            audioProcessor.pitchBendRangeParam->convertTo0to1(static_cast<float>(pitchBendRangeSlider.getValue())));
+    else if (slider == &glideTimeSlider)
+        audioProcessor.glideTimeParam->setValueNotifyingHost(
+            audioProcessor.glideTimeParam->convertTo0to1(static_cast<float>(glideTimeSlider.getValue())));
+}
+
+void MIDIBassGuitarAudioProcessorEditor::chooseSampleLibrary()
+{
+    sampleLibraryChooser = std::make_unique<juce::FileChooser>("Load bass sample library folder or packed library",
+                                                               audioProcessor.getSampleLibraryFile(),
+                                                               "*.bbsl");
+
+    const auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles
+                     | juce::FileBrowserComponent::canSelectDirectories;
+
+    sampleLibraryChooser->launchAsync(flags, [this](const juce::FileChooser& chooser)
+    {
+        const auto result = chooser.getResult();
+
+        if (result.exists())
+            audioProcessor.loadSampleLibrary(result);
+    });
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "DspLoadMeter.h"
 
 /**
  * MIDIBassGuitarAudioProcessorEditor
@@ -8,9 +9,14 @@
  * GUI for MIDI bass guitar virtual instrument featuring:
  * - Articulation selection (Picked, Fingerstyle, Slap, Muted)
  * - Tone preset selection (DI, Amp Sim, Compressed, Bright, Vintage)
+ * - Voice mode (Poly, Mono, Legato) and polyphony
+ * - Pitch bend range and legato glide time
+ * - Synthesis model (Wavetable, String) for notes without samples
+ * - Sample library folder
  * - EQ controls (Bass, Mid, Treble)
  * - Compression control
  * - Output gain control
+ * - DSP load meter under the header
  * - Bass-themed visual design
  */
 class MIDIBassGuitarAudioProcessorEditor : public juce::AudioProcessorEditor,
@@ -29,6 +35,7 @@ private:
     void timerCallback() override;
     void comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) override;
     void sliderValueChanged(juce::Slider* slider) override;
+    void chooseSampleLibrary();
 
     MIDIBassGuitarAudioProcessor& audioProcessor;
 
@@ -40,6 +47,29 @@ private:
     juce::ComboBox toneSelector;
     juce::Label toneLabel;
 
+    // Voice allocation
+    juce::ComboBox voiceModeSelector;
+    juce::Label voiceModeLabel;
+
+    juce::Slider polyphonySlider;
+    juce::Label polyphonyLabel;
+
+    // Pitch
+    juce::Slider pitchBendRangeSlider;
+    juce::Label pitchBendRangeLabel;
+
+    juce::Slider glideTimeSlider;
+    juce::Label glideTimeLabel;
+
+    // Synthesis model
+    juce::ComboBox synthesisModelSelector;
+    juce::Label synthesisModelLabel;
+
+    // Sample library
+    juce::TextButton loadSamplesButton { "LOAD SAMPLES" };
+    juce::Label sampleLibraryLabel;
+    std::unique_ptr<juce::FileChooser> sampleLibraryChooser;
+
     // EQ controls
     juce::Slider bassSlider;
     juce::Label bassLabel;
@@ -58,6 +88,8 @@ private:
     juce::Slider outputGainSlider;
     juce::Label outputGainLabel;
 
+    DspLoadMeter loadMeter;
+
     // Colors - Bass guitar themed (deep blue/black)
     const juce::Colour bassPanelColor = juce::Colour(0xFF1A1A2E);      // Dark blue-black
     const juce::Colour bassAccentColor = juce::Colour(0xFF16213E);     // Slightly lighter blue
@@ -19,6 +19,39 @@ MIDIBassGuitarAudioProcessor::MIDIBassGuitarAudioProcessor()
         juce::StringArray{"DI", "Amp Sim", "Compressed", "Bright", "Vintage"},
         0)); // Default to DI
 
+    // Voice allocation parameters
+    addParameter(voiceModeParam = new juce::AudioParameterChoice(
+        "voiceMode",
+        "Voice Mode",
+        juce::StringArray{"Poly", "Mono", "Legato"},
+        0)); // Default to Poly
+
+    addParameter(polyphonyParam = new juce::AudioParameterInt(
+        "polyphony",
+        "Polyphony",
+        1, BassSynthesiser::maxPolyphony,
+        8));
+
+    // Pitch parameters
+    addParameter(pitchBendRangeParam = new juce::AudioParameterInt(
+        "pitchBendRange",
+        "Pitch Bend Range",
+        0, 12,
+        2)); // Semitones
+
+    addParameter(glideTimeParam = new juce::AudioParameterFloat(
+        "glideTime",
+        "Glide Time",
+        0.0f, 1.0f,
+        0.0f)); // Seconds; legato notes jump by default
+
+    // Synthesis for notes without samples
+    addParameter(synthesisModelParam = new juce::AudioParameterChoice(
+        "synthesisModel",
+        "Synth Model",
+        juce::StringArray{"Wavetable", "String"},
+        0)); // Default to Wavetable
+
     // EQ parameters
     addParameter(bassParam = new juce::AudioParameterFloat(
         "bass",
@@ -112,6 +145,15 @@ void MIDIBassGuitarAudioProcessor::prepareToPlay(double sampleRate, int samplesP
 {
     // Prepare sampler engine
     sampler.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    loadMonitor.prepare(sampleRate);
+    sampler.setLoadMonitor(&loadMonitor);
+}
+
+void MIDIBassGuitarAudioProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    // Hosts switch this outside the audio callback, before an offline bounce
+    juce::AudioProcessor::setNonRealtime(isNonRealtime);
+    sampler.setNonRealtime(isNonRealtime);
 }
 
 void MIDIBassGuitarAudioProcessor::releaseResources()
@@ -132,28 +174,26 @@ void MIDIBassGuitarAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
                                                 juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-
-    // Update sampler parameters from plugin parameters
-    // Articulation
-    int articulationIndex = articulationParam->getIndex();
-    BassArticulation articulation = static_cast<BassArticulation>(articulationIndex);
-    sampler.setArticulation(articulation);
-
-    // Tone preset
-    int toneIndex = toneParam->getIndex();
-    BassTone tone = static_cast<BassTone>(toneIndex);
-    sampler.setTone(tone);
-
-    // EQ
-    sampler.setBass(*bassParam);
-    sampler.setMid(*midParam);
-    sampler.setTreble(*trebleParam);
-
-    // Dynamics
-    sampler.setCompression(*compressionParam);
-
-    // Output
-    sampler.setOutputGain(*outputGainParam);
+    DspLoadMonitor::ScopedBlock loadTiming(loadMonitor, buffer.getNumSamples());
+
+    // Update sampler parameters from plugin parameters. The host only gives
+    // us values per block, so changes land at the start of this one; the
+    // sampler ignores values that haven't moved, which keeps keyswitched
+    // articulations in place.
+    BassSamplerEngine::Parameters parameters;
+    parameters.articulation = articulationParam->getIndex();
+    parameters.tone = toneParam->getIndex();
+    parameters.voiceMode = voiceModeParam->getIndex();
+    parameters.polyphony = polyphonyParam->get();
+    parameters.pitchBendRange = pitchBendRangeParam->get();
+    parameters.glideTime = *glideTimeParam;
+    parameters.synthesisModel = synthesisModelParam->getIndex();
+    parameters.bass = *bassParam;
+    parameters.mid = *midParam;
+    parameters.treble = *trebleParam;
+    parameters.compression = *compressionParam;
+    parameters.outputGain = *outputGainParam;
+    sampler.setParameters(parameters);
 
     // Process MIDI and generate audio through sampler
     // This calls the synthesiser's renderNextBlock with MIDI, then applies effects
@@ -165,6 +205,16 @@ bool MIDIBassGuitarAudioProcessor::hasEditor() const
     return true;
 }
 
+bool MIDIBassGuitarAudioProcessor::loadSampleLibrary(const juce::File& folderOrPackedFile)
+{
+    return sampler.loadSampleLibrary(folderOrPackedFile);
+}
+
+juce::File MIDIBassGuitarAudioProcessor::getSampleLibraryFile() const
+{
+    return sampler.getSampleLibraryFile();
+}
+
 juce::AudioProcessorEditor* MIDIBassGuitarAudioProcessor::createEditor()
 {
     return new MIDIBassGuitarAudioProcessorEditor(*this);
@@ -182,6 +232,12 @@ void MIDIBassGuitarAudioProcessor::getStateInformation(juce::MemoryBlock& destDa
     stream.writeFloat(*trebleParam);
     stream.writeFloat(*compressionParam);
     stream.writeFloat(*outputGainParam);
+    stream.writeInt(voiceModeParam->getIndex());
+    stream.writeInt(polyphonyParam->get());
+    stream.writeString(sampler.getSampleLibraryFile().getFullPathName());
+    stream.writeInt(pitchBendRangeParam->get());
+    stream.writeFloat(*glideTimeParam);
+    stream.writeInt(synthesisModelParam->getIndex());
 }
 
 void MIDIBassGuitarAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -196,6 +252,33 @@ void MIDIBassGuitarAudioProcessor::setStateInformation(const void* data, int siz
     trebleParam->setValueNotifyingHost(stream.readFloat());
     compressionParam->setValueNotifyingHost(stream.readFloat());
     outputGainParam->setValueNotifyingHost(stream.readFloat());
+
+    // Voice allocation was added later - older sessions keep the defaults
+    if (!stream.isExhausted())
+    {
+        voiceModeParam->setValueNotifyingHost(voiceModeParam->convertTo0to1(stream.readInt()));
+        polyphonyParam->setValueNotifyingHost(polyphonyParam->convertTo0to1(static_cast<float>(stream.readInt())));
+    }
+
+    // Then the sample library
+    if (!stream.isExhausted())
+    {
+        const juce::File libraryFile(stream.readString());
+
+        if (!libraryFile.exists() || !sampler.loadSampleLibrary(libraryFile))
+            sampler.clearSampleLibrary();
+    }
+
+    // Pitch parameters came after that
+    if (!stream.isExhausted())
+    {
+        pitchBendRangeParam->setValueNotifyingHost(pitchBendRangeParam->convertTo0to1(static_cast<float>(stream.readInt())));
+        glideTimeParam->setValueNotifyingHost(glideTimeParam->convertTo0to1(stream.readFloat()));
+    }
+
+    // Then the synthesis model
+    if (!stream.isExhausted())
+        synthesisModelParam->setValueNotifyingHost(synthesisModelParam->convertTo0to1(static_cast<float>(stream.readInt())));
 }
 
 // This creates new instances of the plugin
@@ -23,6 +23,7 @@ public:
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime(bool isNonRealtime) noexcept override;
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
@@ -47,18 +48,31 @@ public:
     // Public parameters for editor
     juce::AudioParameterChoice* articulationParam;
     juce::AudioParameterChoice* toneParam;
+    juce::AudioParameterChoice* voiceModeParam;
+    juce::AudioParameterInt* polyphonyParam;
+    juce::AudioParameterInt* pitchBendRangeParam;
+    juce::AudioParameterFloat* glideTimeParam;
+    juce::AudioParameterChoice* synthesisModelParam;
     juce::AudioParameterFloat* bassParam;
     juce::AudioParameterFloat* midParam;
     juce::AudioParameterFloat* trebleParam;
     juce::AudioParameterFloat* compressionParam;
     juce::AudioParameterFloat* outputGainParam;
 
+    // Multisample library folder or packed .bbsl file (message thread)
+    bool loadSampleLibrary(const juce::File& folderOrPackedFile);
+    juce::File getSampleLibraryFile() const;
+
     // Access to sampler for GUI
     BassSamplerEngine& getSampler() { return sampler; }
 
+    // Per-block and per-stage timings for the editor's load meter
+    DspLoadMonitor& getLoadMonitor() { return loadMonitor; }
+
 private:
     // Bass sampler engine
     BassSamplerEngine sampler;
+    DspLoadMonitor loadMonitor { BassSamplerEngine::getLoadStageNames() };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MIDIBassGuitarAudioProcessor)
 };
@@ -1,7 +1,9 @@
 #include "AmpSimDSP.h"
 
 AmpSimDSP::AmpSimDSP()
+    : driveCurve(WaveshaperKernels::ampStageCurve, 3.0f) // Preamp tanh is flat beyond +/-3
 {
+    driveCurve.setParameter(getDriveGain());
 }
 
 AmpSimDSP::~AmpSimDSP()
@@ -12,34 +14,50 @@ void AmpSimDSP::prepare(double sampleRate, int samplesPerBlock, int numChannels)
 {
     currentSampleRate = sampleRate;
 
-    // Prepare all filters with proper spec
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = numChannels;
+    inputGate.prepare(sampleRate, samplesPerBlock, numChannels);
 
-    bassFilter.prepare(spec);
-    middleFilter.prepare(spec);
-    trebleFilter.prepare(spec);
-    presenceFilter.prepare(spec);
-    dcBlocker.prepare(spec);
+    // Push current settings first so the tone stack starts on them
+    updateToneStack();
 
-    // Initialize DC blocker (high-pass at 20Hz)
-    *dcBlocker.state = *FilterCoefs::makeHighPass(sampleRate, 20.0);
+    // DC blocker (high-pass at 20Hz) runs as the last tone stack section
+    toneStack.setSection(dcBlockerSection, CascadedBiquad::SectionType::HighPass, 20.0);
+    toneStack.prepare(sampleRate, numChannels);
 
-    // Initialize filters with current parameter values
-    updateFilters();
+    // Allocate one oversampler per quality mode up front.
+    // Polyphase IIR half-band filters keep the added latency low, and integer
+    // latency lets us report an exact value to the host.
+    for (int stage = 0; stage < maxOversamplingStages; ++stage)
+    {
+        oversamplers[stage] = std::make_unique<juce::dsp::Oversampling<float>>(
+            static_cast<size_t>(numChannels),
+            static_cast<size_t>(stage + 1),
+            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+            true,   // Max quality filters
+            true);  // Integer latency
+
+        oversamplers[stage]->initProcessing(static_cast<size_t>(samplesPerBlock));
+    }
+
+    // Build the drive curve for the current setting before audio starts
+    driveCurve.prepare(getProcessingSampleRate());
+
+    cabinet.prepare(sampleRate, samplesPerBlock, numChannels);
 
     reset();
 }
 
 void AmpSimDSP::reset()
 {
-    bassFilter.reset();
-    middleFilter.reset();
-    trebleFilter.reset();
-    presenceFilter.reset();
-    dcBlocker.reset();
+    inputGate.reset();
+    toneStack.reset();
+    driveCurve.reset();
+    cabinet.reset();
+
+    for (auto& oversampler : oversamplers)
+    {
+        if (oversampler != nullptr)
+            oversampler->reset();
+    }
 }
 
 void AmpSimDSP::processBlock(juce::AudioBuffer<float>& buffer)
@@ -50,125 +68,124 @@ void AmpSimDSP::processBlock(juce::AudioBuffer<float>& buffer)
     // Convert to JUCE DSP block for filter processing
     juce::dsp::AudioBlock<float> block(buffer);
     juce::dsp::ProcessContextReplacing<float> context(block);
+    markLoadStage(setupLoadStage);
 
-    // Calculate actual gain values from normalized parameters
-    const float preampGainLinear = 1.0f + (preampGain * 9.0f); // 1-10 range
-    const float driveAmount = drive * 10.0f; // 0-10 range
-    const float outputGain = masterVolume * masterVolume; // Squared for better taper
-
-    // Process each sample
-    for (int channel = 0; channel < numChannels; ++channel)
-    {
-        float* channelData = buffer.getWritePointer(channel);
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            float inputSample = channelData[sample];
+    // Stage 0: Noise gate - cut hiss and hum before the preamp amplifies it
+    if (gateEnabled)
+        inputGate.process(block);
 
-            // Stage 1: Preamp gain
-            float preampOut = inputSample * preampGainLinear;
-            preampOut = softClip(preampOut); // Soft clip at preamp stage
+    markLoadStage(gateLoadStage);
 
-            // Stage 2: Drive/Saturation
-            float driveOut = applySaturation(preampOut, driveAmount);
+    // Stages 1-2: Preamp and drive - run at the oversampled rate when enabled
+    auto* oversampler = oversamplingIndex > 0 ? oversamplers[oversamplingIndex - 1].get() : nullptr;
 
-            // Output
-            channelData[sample] = driveOut * outputGain;
-        }
+    if (oversampler != nullptr)
+    {
+        auto oversampledBlock = oversampler->processSamplesUp(context.getInputBlock());
+        processNonlinearStages(oversampledBlock);
+        oversampler->processSamplesDown(block);
+    }
+    else
+    {
+        processNonlinearStages(block);
     }
 
-    // Stage 3: Tone Stack (EQ) - apply to entire block efficiently
-    bassFilter.process(context);
-    middleFilter.process(context);
-    trebleFilter.process(context);
-    presenceFilter.process(context);
+    markLoadStage(driveLoadStage);
 
+    // Stage 3: Tone Stack (EQ)
     // Stage 4: DC blocker to remove any DC offset
-    dcBlocker.process(context);
+    // Both run together in a single pass over the block
+    toneStack.process(block);
+    markLoadStage(toneStackLoadStage);
 
     // Final soft limiting to prevent clipping
     for (int channel = 0; channel < numChannels; ++channel)
-    {
-        float* channelData = buffer.getWritePointer(channel);
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            channelData[sample] = softClip(channelData[sample]);
-        }
-    }
-}
+        WaveshaperKernels::softClip(buffer.getWritePointer(channel), numSamples);
 
-void AmpSimDSP::updateFilters()
-{
-    const double sampleRate = currentSampleRate;
+    markLoadStage(limiterLoadStage);
 
-    // Bass - Low shelf at 120Hz
-    // Range: -12dB to +12dB
-    float bassGainDb = (bass - 0.5f) * 24.0f;
-    *bassFilter.state = *FilterCoefs::makeLowShelf(sampleRate, 120.0, 0.7,
-                                                     juce::Decibels::decibelsToGain(bassGainDb));
+    // Stage 5: Speaker cabinet
+    if (cabinetEnabled)
+        cabinet.process(block);
 
-    // Middle - Peaking filter at 800Hz (critical guitar frequency)
-    // Range: -12dB to +12dB
-    float middleGainDb = (middle - 0.5f) * 24.0f;
-    *middleFilter.state = *FilterCoefs::makePeakFilter(sampleRate, 800.0, 1.5,
-                                                         juce::Decibels::decibelsToGain(middleGainDb));
+    markLoadStage(cabinetLoadStage);
+}
 
-    // Treble - High shelf at 3kHz
-    // Range: -12dB to +12dB
-    float trebleGainDb = (treble - 0.5f) * 24.0f;
-    *trebleFilter.state = *FilterCoefs::makeHighShelf(sampleRate, 3000.0, 0.7,
-                                                        juce::Decibels::decibelsToGain(trebleGainDb));
+void AmpSimDSP::processNonlinearStages(juce::dsp::AudioBlock<float>& block)
+{
+    // Calculate actual gain values from normalized parameters
+    const float preampGainLinear = 1.0f + (preampGain * 9.0f); // 1-10 range
+    const float outputGain = masterVolume * masterVolume; // Squared for better taper
 
-    // Presence - High shelf at 6kHz (amp-like presence control)
-    // Range: -6dB to +6dB
-    float presenceGainDb = (presence - 0.5f) * 12.0f;
-    *presenceFilter.state = *FilterCoefs::makeHighShelf(sampleRate, 6000.0, 0.5,
-                                                          juce::Decibels::decibelsToGain(presenceGainDb));
+    // Stage 1: Preamp gain + soft clip
+    // Stage 2: Asymmetric tube drive + power amp compression
+    // Both are a fixed curve for a given drive setting, so this is one table lookup per sample
+    driveCurve.process(block, preampGainLinear, outputGain);
 }
 
-float AmpSimDSP::applySaturation(float input, float driveAmount)
+float AmpSimDSP::getDriveGain() const
 {
-    // Apply drive gain
-    float driven = input * (1.0f + driveAmount * 2.0f);
-
-    // Asymmetric waveshaping (tube-like)
-    // Positive and negative cycles clip differently (like real tubes)
-    if (driven > 0.0f)
-    {
-        // Positive cycle - softer clipping
-        driven = tanh_approx(driven * 0.8f) * 1.25f;
-    }
-    else
-    {
-        // Negative cycle - harder clipping (more harmonics)
-        driven = tanh_approx(driven * 1.2f) * 0.83f;
-    }
+    const float driveAmount = drive * 10.0f; // 0-10 range
+    return 1.0f + driveAmount * 2.0f;
+}
 
-    // Power amp compression (subtle)
-    driven = tanh_approx(driven * 0.9f) * 1.1f;
+juce::StringArray AmpSimDSP::getLoadStageNames()
+{
+    return { "Setup", "Gate", "Preamp/Drive", "Tone stack", "Limiter", "Cabinet" };
+}
 
-    return driven;
+void AmpSimDSP::markLoadStage(LoadStage stage)
+{
+    if (loadMonitor != nullptr)
+        loadMonitor->markStage(stage);
 }
 
-float AmpSimDSP::softClip(float input)
+double AmpSimDSP::getProcessingSampleRate() const
 {
-    // Soft clipping using tanh
-    // Keeps signal in safe range while adding gentle harmonic content
-    return tanh_approx(input);
+    // Rate the nonlinear stages run at, including oversampling
+    return currentSampleRate * static_cast<double>(1 << oversamplingIndex);
 }
 
-float AmpSimDSP::tanh_approx(float x)
+void AmpSimDSP::updateToneStack()
 {
-    // Fast tanh approximation for real-time audio
-    // Accurate enough for audio, much faster than std::tanh
-    if (x > 3.0f) return 1.0f;
-    if (x < -3.0f) return -1.0f;
+    // Only bands whose gain actually changed get redesigned
 
-    float x2 = x * x;
-    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    // Bass - Low shelf at 120Hz
+    // Range: -12dB to +12dB
+    toneStack.setSection(bassSection, CascadedBiquad::SectionType::LowShelf, 120.0, 0.7,
+                         (bass - 0.5f) * 24.0f);
+
+    // Middle - Peaking filter at 800Hz (critical guitar frequency)
+    // Range: -12dB to +12dB
+    toneStack.setSection(middleSection, CascadedBiquad::SectionType::Peak, 800.0, 1.5,
+                         (middle - 0.5f) * 24.0f);
+
+    // Treble - High shelf at 3kHz
+    // Range: -12dB to +12dB
+    toneStack.setSection(trebleSection, CascadedBiquad::SectionType::HighShelf, 3000.0, 0.7,
+                         (treble - 0.5f) * 24.0f);
+
+    // Presence - High shelf at 6kHz (amp-like presence control)
+    // Range: -6dB to +6dB
+    toneStack.setSection(presenceSection, CascadedBiquad::SectionType::HighShelf, 6000.0, 0.5,
+                         (presence - 0.5f) * 12.0f);
 }
 
 // Parameter setters
+void AmpSimDSP::setParameters(const Parameters& parameters)
+{
+    setPreampGain(parameters.preampGain);
+    setBass(parameters.bass);
+    setMiddle(parameters.middle);
+    setTreble(parameters.treble);
+    setDrive(parameters.drive);
+    setPresence(parameters.presence);
+    setMasterVolume(parameters.masterVolume);
+    setCabinetEnabled(parameters.cabinetEnabled);
+    setGateEnabled(parameters.gateEnabled);
+    setGateThreshold(parameters.gateThreshold);
+}
+
 void AmpSimDSP::setPreampGain(float gain)
 {
     preampGain = juce::jlimit(0.0f, 1.0f, gain);
@@ -177,33 +194,97 @@ void AmpSimDSP::setPreampGain(float gain)
 void AmpSimDSP::setBass(float bassValue)
 {
     bass = juce::jlimit(0.0f, 1.0f, bassValue);
-    updateFilters();
+    updateToneStack();
 }
 
 void AmpSimDSP::setMiddle(float middleValue)
 {
     middle = juce::jlimit(0.0f, 1.0f, middleValue);
-    updateFilters();
+    updateToneStack();
 }
 
 void AmpSimDSP::setTreble(float trebleValue)
 {
     treble = juce::jlimit(0.0f, 1.0f, trebleValue);
-    updateFilters();
+    updateToneStack();
 }
 
 void AmpSimDSP::setDrive(float driveValue)
 {
     drive = juce::jlimit(0.0f, 1.0f, driveValue);
+    driveCurve.setParameter(getDriveGain());
 }
 
 void AmpSimDSP::setPresence(float presenceValue)
 {
     presence = juce::jlimit(0.0f, 1.0f, presenceValue);
-    updateFilters();
+    updateToneStack();
 }
 
 void AmpSimDSP::setMasterVolume(float volume)
 {
     masterVolume = juce::jlimit(0.0f, 1.0f, volume);
 }
+
+void AmpSimDSP::setGateEnabled(bool shouldBeEnabled)
+{
+    // Start closed rather than replaying stale envelope state
+    if (shouldBeEnabled && !gateEnabled)
+        inputGate.reset();
+
+    gateEnabled = shouldBeEnabled;
+}
+
+void AmpSimDSP::setGateThreshold(float threshold)
+{
+    inputGate.setThreshold((juce::jlimit(0.0f, 1.0f, threshold) - 1.0f) * 60.0f);
+}
+
+void AmpSimDSP::setOversampling(int qualityIndex)
+{
+    const int newIndex = juce::jlimit(0, maxOversamplingStages, qualityIndex);
+
+    if (newIndex == oversamplingIndex)
+        return;
+
+    oversamplingIndex = newIndex;
+    driveCurve.setSampleRate(getProcessingSampleRate());
+
+    // Clear filter history so the newly selected engine doesn't
+    // play out stale samples from the last time it was used
+    if (oversamplingIndex > 0 && oversamplers[oversamplingIndex - 1] != nullptr)
+        oversamplers[oversamplingIndex - 1]->reset();
+}
+
+int AmpSimDSP::getLatencySamples() const
+{
+    if (oversamplingIndex == 0 || oversamplers[oversamplingIndex - 1] == nullptr)
+        return 0;
+
+    return juce::roundToInt(oversamplers[oversamplingIndex - 1]->getLatencyInSamples());
+}
+
+void AmpSimDSP::setCabinetEnabled(bool shouldBeEnabled)
+{
+    cabinetEnabled = shouldBeEnabled;
+}
+
+bool AmpSimDSP::loadCabinetImpulseResponse(const juce::File& file)
+{
+    return cabinet.loadImpulseResponse(file);
+}
+
+void AmpSimDSP::clearCabinetImpulseResponse()
+{
+    cabinet.clearImpulseResponse();
+}
+
+juce::File AmpSimDSP::getCabinetImpulseResponseFile() const
+{
+    return cabinet.getImpulseResponseFile();
+}
+
+double AmpSimDSP::getCabinetTailSeconds() const
+{
+    return cabinetEnabled ? cabinet.getImpulseResponseSeconds() : 0.0;
+}
@@ -1,11 +1,17 @@
 #pragma once
 #include <JuceHeader.h>
+#include "CascadedBiquad.h"
+#include "WaveshaperKernels.h"
+#include "TransferCurveTable.h"
+#include "CabinetSimulator.h"
+#include "NoiseGate.h"
+#include "DspLoadMonitor.h"
 
 /**
  * AmpSimDSP - Core DSP engine for Orange-style tube amp simulation
  *
  * Signal chain:
- * Input -> Preamp Gain -> Tone Stack (EQ) -> Drive/Saturation -> Power Amp -> Output
+ * Input -> Noise Gate -> Preamp Gain -> Tone Stack (EQ) -> Drive/Saturation -> Power Amp -> Cabinet -> Output
  *
  * Features:
  * - Preamp gain stage with soft clipping
@@ -13,6 +19,10 @@
  * - Adjustable drive with multiple waveshaping algorithms
  * - Power amp compression and saturation
  * - Presence control for high-frequency character
+ * - Optional 2x/4x/8x oversampling around the nonlinear stages to keep
+ *   high drive settings from aliasing
+ * - Optional noise gate in front of the preamp to tame high-gain hiss
+ * - Speaker cabinet stage convolving with a loaded WAV impulse response
  */
 class AmpSimDSP
 {
@@ -37,6 +47,60 @@ public:
     void setDrive(float drive);          // Overdrive amount (0-10)
     void setPresence(float presence);    // High-frequency sparkle
     void setMasterVolume(float volume);  // Output volume
+    void setGateEnabled(bool shouldBeEnabled);
+    void setGateThreshold(float threshold); // Gate threshold (-60dB to 0dB)
+
+    // Every setting the plugin's parameters drive, bar oversampling (the
+    // processor picks the real-time or offline choice and reports its
+    // latency). The processor and render_cli both push them through
+    // setParameters(), so a render always sets what processBlock() sets.
+    struct Parameters
+    {
+        float preampGain = 0.5f;
+        float bass = 0.5f;
+        float middle = 0.5f;
+        float treble = 0.5f;
+        float drive = 0.3f;
+        float presence = 0.5f;
+        float masterVolume = 0.7f;
+        bool cabinetEnabled = true;
+        bool gateEnabled = false;
+        float gateThreshold = 0.333f;
+    };
+
+    void setParameters(const Parameters& parameters);
+
+    // Oversampling quality for the preamp/drive/power amp stages
+    // 0 = Off, 1 = 2x, 2 = 4x, 3 = 8x
+    void setOversampling(int qualityIndex);
+    int getOversampling() const { return oversamplingIndex; }
+
+    // Latency (in host-rate samples) added by the current oversampling mode
+    int getLatencySamples() const;
+
+    // Per-stage timing for the DSP load meter; the time before the chain
+    // starts (parameter updates in the processor) is charged to setup
+    enum LoadStage
+    {
+        setupLoadStage = 0,
+        gateLoadStage,
+        driveLoadStage,
+        toneStackLoadStage,
+        limiterLoadStage,
+        cabinetLoadStage
+    };
+
+    static juce::StringArray getLoadStageNames();
+    void setLoadMonitor(DspLoadMonitor* monitorToUse) { loadMonitor = monitorToUse; }
+
+    static constexpr int maxOversamplingStages = 3; // 2^3 = 8x
+
+    // Speaker cabinet (call loadCabinetImpulseResponse from the message thread)
+    void setCabinetEnabled(bool shouldBeEnabled);
+    bool loadCabinetImpulseResponse(const juce::File& file);
+    void clearCabinetImpulseResponse();
+    juce::File getCabinetImpulseResponseFile() const;
+    double getCabinetTailSeconds() const;
 
 private:
     // Sample rate
@@ -51,21 +115,46 @@ private:
     float presence = 0.5f;
     float masterVolume = 0.7f;
 
-    // EQ filters using JUCE DSP
-    using Filter = juce::dsp::IIR::Filter<float>;
-    using FilterCoefs = juce::dsp::IIR::Coefficients<float>;
+    // Noise gate ahead of the preamp (no lookahead, so no added latency)
+    NoiseGate inputGate;
+    bool gateEnabled = false;
+
+    // Oversampling engines, one per quality mode (index 0 = 2x).
+    // All of them are allocated in prepare() so switching quality
+    // on the audio thread never allocates.
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, maxOversamplingStages> oversamplers;
+    int oversamplingIndex = 0;
+
+    // Tone stack EQ (bass, middle, treble, presence) plus the DC blocker
+    // that removes DC offset from saturation, all fused into one pass.
+    // Only sections whose settings change get redesigned, with no allocation.
+    enum ToneStackSection
+    {
+        bassSection = 0,
+        middleSection,
+        trebleSection,
+        presenceSection,
+        dcBlockerSection
+    };
+
+    CascadedBiquad toneStack;
+
+    // Preamp clip -> asymmetric drive -> power amp as one lookup table per
+    // drive setting, rebuilt by the SIMD amp stage kernel as soon as the
+    // drive changes and crossfaded in
+    TransferCurveTable driveCurve;
 
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> bassFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> middleFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> trebleFilter;
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> presenceFilter;
+    // Speaker cabinet convolution, after the final soft limiter
+    CabinetSimulator cabinet;
+    bool cabinetEnabled = true;
 
-    // DC blocking filter to remove DC offset from saturation
-    juce::dsp::ProcessorDuplicator<Filter, FilterCoefs> dcBlocker;
+    // Owned by the processor, null when not measuring
+    DspLoadMonitor* loadMonitor = nullptr;
 
     // Helper functions
-    void updateFilters();
-    float applySaturation(float input, float driveAmount);
-    float softClip(float input);
-    float tanh_approx(float x);  // Fast tanh approximation
+    void updateToneStack();
+    void processNonlinearStages(juce::dsp::AudioBlock<float>& block);
+    float getDriveGain() const;
+    double getProcessingSampleRate() const;
+    void markLoadStage(LoadStage stage);
 };
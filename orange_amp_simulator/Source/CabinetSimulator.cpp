@@ -0,0 +1,319 @@
+#include "CabinetSimulator.h"
+#include "SharedAssetCache.h"
+
+namespace
+{
+    // Zeroth-order modified Bessel function, for the Kaiser window
+    double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x * 0.5 / k) * (x * 0.5 / k);
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    // Kaiser-windowed sinc, tabulated per resample and read with linear interpolation
+    constexpr int sincZeroCrossings = 32;      // Each side of the centre
+    constexpr int sincTableResolution = 512;   // Table points per zero crossing
+    constexpr double sincKaiserBeta = 8.0;     // Around 80 dB stopband
+    constexpr double sincCutoff = 0.95;        // Of the lower Nyquist, leaving room for the transition band
+
+    // Band-limited resampling, ratio being source samples per output sample. The
+    // low-pass sits under the lower of the two Nyquist frequencies, so going down
+    // in rate removes what the new rate can't hold instead of folding it back
+    // as aliasing - the kernel stretches with the ratio to do that.
+    void resampleImpulse(const float* source, int sourceLength, float* destination, int destinationLength, double ratio)
+    {
+        const double cutoff = sincCutoff * juce::jmin(1.0, 1.0 / ratio);  // Of the source Nyquist
+        const int tableSize = sincZeroCrossings * sincTableResolution;
+        std::vector<double> kernel(static_cast<size_t>(tableSize + 2), 0.0);
+
+        for (int i = 0; i <= tableSize; ++i)
+        {
+            const double t = static_cast<double>(i) / sincTableResolution;
+            const double x = juce::MathConstants<double>::pi * t;
+            const double sinc = i == 0 ? 1.0 : std::sin(x) / x;
+            const double w = juce::jmax(0.0, 1.0 - (t / sincZeroCrossings) * (t / sincZeroCrossings));
+
+            kernel[static_cast<size_t>(i)] = cutoff * sinc * besselI0(sincKaiserBeta * std::sqrt(w)) / besselI0(sincKaiserBeta);
+        }
+
+        const double halfWidth = sincZeroCrossings / cutoff;      // Source samples
+        const double tableStep = cutoff * sincTableResolution;    // Table points per source sample
+
+        for (int i = 0; i < destinationLength; ++i)
+        {
+            const double centre = i * ratio;
+            const int first = juce::jmax(0, static_cast<int>(std::ceil(centre - halfWidth)));
+            const int last = juce::jmin(sourceLength - 1, static_cast<int>(std::floor(centre + halfWidth)));
+            double sum = 0.0;
+
+            for (int k = first; k <= last; ++k)
+            {
+                const double position = juce::jmin(std::abs(k - centre) * tableStep, static_cast<double>(tableSize));
+                const auto index = static_cast<size_t>(position);
+                const double blend = position - static_cast<double>(index);
+
+                sum += source[k] * (kernel[index] + blend * (kernel[index + 1] - kernel[index]));
+            }
+
+            destination[i] = static_cast<float>(sum);
+        }
+    }
+}
+
+CabinetSimulator::CabinetSimulator()
+{
+}
+
+CabinetSimulator::~CabinetSimulator()
+{
+    stopTimer();
+    deleteRetiredEngines();
+}
+
+void CabinetSimulator::prepare(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    // Audio is stopped - rebuild directly instead of going through the hand-over
+    deleteRetiredEngines();
+
+    currentSampleRate = sampleRate;
+    maxBlockSize = samplesPerBlock;
+    numPreparedChannels = numChannels;
+
+    fadeLength = juce::jmax(1, juce::roundToInt(0.05 * sampleRate)); // 50ms
+    fadeBuffer.setSize(numChannels, samplesPerBlock);
+
+    fadingEngine.reset();
+    isFading = false;
+
+    // The engine built below already uses the latest IR
+    delete pendingEngine.exchange(nullptr);
+    pendingIsEmpty.store(false);
+
+    const juce::ScopedLock lock(sourceLock);
+    activeEngine = createEngine();
+}
+
+void CabinetSimulator::reset()
+{
+    if (activeEngine != nullptr)
+        activeEngine->reset();
+
+    // Drop any crossfade in progress
+    if (isFading)
+    {
+        isFading = false;
+        delete retiredEngine.exchange(fadingEngine.release());
+    }
+}
+
+void CabinetSimulator::process(juce::dsp::AudioBlock<float>& block)
+{
+    // Pick up a newly loaded IR, once the previous hand-over is fully cleaned up
+    if (!isFading && retiredEngine.load() == nullptr && (pendingEngine.load() != nullptr || pendingIsEmpty.load()))
+    {
+        pendingIsEmpty.store(false);
+        fadingEngine = std::move(activeEngine);
+        activeEngine.reset(pendingEngine.exchange(nullptr));
+        isFading = true;
+        fadePosition = 0;
+    }
+
+    if (!isFading)
+    {
+        if (activeEngine != nullptr)
+            activeEngine->process(block);
+
+        return;
+    }
+
+    // Crossfade old -> new. A missing engine counts as the dry signal.
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), fadeBuffer.getNumChannels());
+
+    for (int start = 0; start < numSamples; start += fadeBuffer.getNumSamples())
+    {
+        const int length = juce::jmin(fadeBuffer.getNumSamples(), numSamples - start);
+        auto newBlock = block.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(length));
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            fadeBuffer.copyFrom(channel, 0, newBlock.getChannelPointer(static_cast<size_t>(channel)), length);
+
+        juce::dsp::AudioBlock<float> oldBlock(fadeBuffer.getArrayOfWritePointers(),
+                                              static_cast<size_t>(numChannels), static_cast<size_t>(length));
+
+        if (fadingEngine != nullptr)
+            fadingEngine->process(oldBlock);
+
+        if (activeEngine != nullptr)
+            activeEngine->process(newBlock);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* output = newBlock.getChannelPointer(static_cast<size_t>(channel));
+            const float* oldOutput = fadeBuffer.getReadPointer(channel);
+
+            for (int sample = 0; sample < length; ++sample)
+            {
+                const float newAmount = juce::jmin(1.0f, static_cast<float>(fadePosition + sample) / static_cast<float>(fadeLength));
+                output[sample] = oldOutput[sample] + newAmount * (output[sample] - oldOutput[sample]);
+            }
+        }
+
+        fadePosition += length;
+    }
+
+    if (fadePosition >= fadeLength)
+    {
+        // Deleting an engine stops its worker thread, so leave that to the message thread
+        isFading = false;
+        retiredEngine.store(fadingEngine.release());
+    }
+}
+
+bool CabinetSimulator::loadImpulseResponse(const juce::File& file)
+{
+    // IR files are small, so read the whole thing once and decode from memory
+    juce::MemoryBlock fileData;
+
+    if (!file.loadFileAsData(fileData))
+        return false;
+
+    const auto hash = SharedAssetCache::hashBytes(fileData.getData(), fileData.getSize());
+    const auto key = SharedAssetCache::makeKey("CabinetImpulse", hash);
+
+    auto impulse = SharedAssetCache::getInstance().getOrCreate<ImpulseResponse>(key, [&fileData]()
+    {
+        std::shared_ptr<ImpulseResponse> decoded;
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        auto input = std::make_unique<juce::MemoryInputStream>(fileData, false);
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(std::move(input)));
+
+        if (reader == nullptr || reader->lengthInSamples <= 0)
+            return decoded;
+
+        const int numSamples = static_cast<int>(juce::jmin(reader->lengthInSamples,
+                                                          static_cast<juce::int64>(maxImpulseSeconds * reader->sampleRate)));
+        const int numChannels = static_cast<int>(juce::jmin(reader->numChannels, 2u));
+
+        decoded = std::make_shared<ImpulseResponse>();
+        decoded->samples.setSize(numChannels, numSamples);
+        decoded->sampleRate = reader->sampleRate;
+        reader->read(&decoded->samples, 0, numSamples, 0, true, numChannels > 1);
+        return decoded;
+    });
+
+    if (impulse == nullptr)
+        return false;
+
+    std::unique_ptr<PartitionedConvolver> engine;
+
+    {
+        const juce::ScopedLock lock(sourceLock);
+        sourceImpulse = std::move(impulse);
+        sourceFile = file;
+        engine = createEngine();
+    }
+
+    // Replace anything the audio thread hasn't picked up yet
+    pendingIsEmpty.store(false);
+    delete pendingEngine.exchange(engine.release());
+
+    startTimer(250); // Collects engines once they've faded out
+    return true;
+}
+
+void CabinetSimulator::clearImpulseResponse()
+{
+    {
+        const juce::ScopedLock lock(sourceLock);
+        sourceImpulse.reset();
+        sourceFile = juce::File();
+    }
+
+    delete pendingEngine.exchange(nullptr);
+    pendingIsEmpty.store(true);
+
+    startTimer(250);
+}
+
+juce::File CabinetSimulator::getImpulseResponseFile() const
+{
+    const juce::ScopedLock lock(sourceLock);
+    return sourceFile;
+}
+
+double CabinetSimulator::getImpulseResponseSeconds() const
+{
+    const juce::ScopedLock lock(sourceLock);
+
+    if (sourceImpulse == nullptr)
+        return 0.0;
+
+    return sourceImpulse->samples.getNumSamples() / sourceImpulse->sampleRate;
+}
+
+std::unique_ptr<PartitionedConvolver> CabinetSimulator::createEngine() const
+{
+    // Caller holds sourceLock
+    if (sourceImpulse == nullptr)
+        return nullptr;
+
+    const auto& source = sourceImpulse->samples;
+    const int numChannels = source.getNumChannels();
+    const double ratio = sourceImpulse->sampleRate / currentSampleRate;
+    const int numSamples = juce::jmax(1, static_cast<int>(std::ceil(source.getNumSamples() / ratio)));
+
+    // Resample to the session rate, band-limited so a high-rate IR doesn't alias
+    juce::AudioBuffer<float> impulse(numChannels, numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        if (ratio == 1.0)
+        {
+            impulse.copyFrom(channel, 0, source, channel, 0, numSamples);
+            continue;
+        }
+
+        resampleImpulse(source.getReadPointer(channel), source.getNumSamples(),
+                        impulse.getWritePointer(channel), numSamples, ratio);
+    }
+
+    // Normalise to unit energy so different IRs land at similar levels
+    double energy = 0.0;
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const float* data = impulse.getReadPointer(channel);
+        double channelEnergy = 0.0;
+
+        for (int sample = 0; sample < numSamples; ++sample)
+            channelEnergy += static_cast<double>(data[sample]) * data[sample];
+
+        energy = juce::jmax(energy, channelEnergy);
+    }
+
+    if (energy > 0.0)
+        impulse.applyGain(static_cast<float>(1.0 / std::sqrt(energy)));
+
+    return std::make_unique<PartitionedConvolver>(impulse, numPreparedChannels);
+}
+
+void CabinetSimulator::deleteRetiredEngines()
+{
+    delete retiredEngine.exchange(nullptr);
+}
+
+void CabinetSimulator::timerCallback()
+{
+    deleteRetiredEngines();
+}
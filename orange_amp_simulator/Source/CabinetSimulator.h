@@ -0,0 +1,71 @@
+#pragma once
+#include <JuceHeader.h>
+#include "PartitionedConvolver.h"
+
+/**
+ * CabinetSimulator - Speaker cabinet stage driven by a WAV impulse response
+ *
+ * Loading happens off the audio thread: the file is read, resampled to the
+ * current rate, normalised and turned into a PartitionedConvolver, which is
+ * then handed to the audio thread through an atomic pointer and crossfaded
+ * in. Engines that have faded out are deleted later on the message thread.
+ * The decoded file is kept in SharedAssetCache, keyed by a hash of its
+ * bytes, so every cabinet in the process loading the same IR shares it.
+ *
+ * With no impulse response loaded the stage passes audio through untouched.
+ */
+class CabinetSimulator : private juce::Timer
+{
+public:
+    CabinetSimulator();
+    ~CabinetSimulator() override;
+
+    // Rebuilds the engine for the new rate (not real-time safe)
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
+    void reset();
+
+    void process(juce::dsp::AudioBlock<float>& block);
+
+    // Message thread. Returns false if the file couldn't be read.
+    bool loadImpulseResponse(const juce::File& file);
+    void clearImpulseResponse();
+
+    juce::File getImpulseResponseFile() const;
+    double getImpulseResponseSeconds() const;
+
+    static constexpr double maxImpulseSeconds = 10.0;
+
+private:
+    // Settings the engine is built for
+    double currentSampleRate = 44100.0;
+    int numPreparedChannels = 2;
+    int maxBlockSize = 512;
+
+    // Last loaded impulse response, at its original sample rate
+    struct ImpulseResponse
+    {
+        juce::AudioBuffer<float> samples;
+        double sampleRate = 0.0;
+    };
+
+    std::shared_ptr<const ImpulseResponse> sourceImpulse;
+    juce::File sourceFile;
+    mutable juce::CriticalSection sourceLock;
+
+    // Audio thread engines
+    std::unique_ptr<PartitionedConvolver> activeEngine;
+    std::unique_ptr<PartitionedConvolver> fadingEngine;
+    bool isFading = false;
+    int fadePosition = 0;
+    int fadeLength = 2048;
+    juce::AudioBuffer<float> fadeBuffer;
+
+    // Hand-over between the loader and the audio thread
+    std::atomic<PartitionedConvolver*> pendingEngine { nullptr };
+    std::atomic<PartitionedConvolver*> retiredEngine { nullptr };
+    std::atomic<bool> pendingIsEmpty { false };  // Pending change is "no IR at all"
+
+    std::unique_ptr<PartitionedConvolver> createEngine() const;
+    void deleteRetiredEngines();
+    void timerCallback() override;
+};
@@ -11,7 +11,9 @@ OrangeAmpSimulatorAudioProcessorEditor::OrangeAmpSimulatorAudioProcessorEditor(
       trebleKnob("TREBLE"),
       driveKnob("DRIVE"),
       presenceKnob("PRESENCE"),
-      masterVolumeKnob("MASTER")
+      masterVolumeKnob("MASTER"),
+      gateThresholdKnob("GATE"),
+      loadMeter(p.getLoadMonitor())
 {
     // Set plugin window size - amp panel dimensions
     setSize(700, 350);
@@ -24,6 +26,7 @@ OrangeAmpSimulatorAudioProcessorEditor::OrangeAmpSimulatorAudioProcessorEditor(
     driveKnob.setDisplayRange(0.0f, 10.0f, "");
     presenceKnob.setDisplayRange(-6.0f, 6.0f, "dB");
     masterVolumeKnob.setDisplayRange(0.0f, 10.0f, "");
+    gateThresholdKnob.setDisplayRange(-60.0f, 0.0f, "dB");
 
     // Wire up knobs to processor parameters
     preampGainKnob.onValueChange = [this](float value)
@@ -61,6 +64,68 @@ OrangeAmpSimulatorAudioProcessorEditor::OrangeAmpSimulatorAudioProcessorEditor(
         audioProcessor.masterVolumeParam->setValueNotifyingHost(value);
     };
 
+    gateThresholdKnob.onValueChange = [this](float value)
+    {
+        audioProcessor.gateThresholdParam->setValueNotifyingHost(value);
+    };
+
+    // Oversampling quality selectors
+    for (auto* selector : {&oversamplingSelector, &offlineOversamplingSelector})
+    {
+        selector->addItemList(audioProcessor.oversamplingParam->choices, 1);
+        selector->setColour(juce::ComboBox::backgroundColourId, accentColor);
+        selector->setColour(juce::ComboBox::textColourId, textColor);
+        selector->setColour(juce::ComboBox::outlineColourId, orangeColor.withAlpha(0.5f));
+        addAndMakeVisible(selector);
+    }
+
+    oversamplingSelector.setSelectedItemIndex(audioProcessor.oversamplingParam->getIndex(),
+                                              juce::dontSendNotification);
+    offlineOversamplingSelector.setSelectedItemIndex(audioProcessor.offlineOversamplingParam->getIndex(),
+                                                     juce::dontSendNotification);
+
+    oversamplingSelector.onChange = [this]()
+    {
+        auto* param = audioProcessor.oversamplingParam;
+        param->setValueNotifyingHost(param->convertTo0to1(oversamplingSelector.getSelectedItemIndex()));
+    };
+
+    offlineOversamplingSelector.onChange = [this]()
+    {
+        auto* param = audioProcessor.offlineOversamplingParam;
+        param->setValueNotifyingHost(param->convertTo0to1(offlineOversamplingSelector.getSelectedItemIndex()));
+    };
+
+    // Speaker cabinet controls
+    for (auto* button : {&loadImpulseButton, &cabinetButton, &gateButton})
+    {
+        button->setColour(juce::TextButton::buttonColourId, accentColor);
+        button->setColour(juce::TextButton::buttonOnColourId, orangeColor.withAlpha(0.7f));
+        button->setColour(juce::TextButton::textColourOffId, textColor);
+        button->setColour(juce::TextButton::textColourOnId, logoColor);
+        addAndMakeVisible(button);
+    }
+
+    loadImpulseButton.onClick = [this]() { chooseImpulseResponse(); };
+
+    cabinetButton.setClickingTogglesState(true);
+    cabinetButton.setToggleState(audioProcessor.cabinetParam->get(), juce::dontSendNotification);
+    cabinetButton.onClick = [this]()
+    {
+        audioProcessor.cabinetParam->setValueNotifyingHost(cabinetButton.getToggleState() ? 1.0f : 0.0f);
+    };
+
+    gateButton.setClickingTogglesState(true);
+    gateButton.setToggleState(audioProcessor.gateParam->get(), juce::dontSendNotification);
+    gateButton.onClick = [this]()
+    {
+        audioProcessor.gateParam->setValueNotifyingHost(gateButton.getToggleState() ? 1.0f : 0.0f);
+    };
+
+    addAndMakeVisible(loadMeter);
+
+    impulseName = audioProcessor.getCabinetImpulseResponseFile().getFileNameWithoutExtension();
+
     // Add all knobs to editor
     addAndMakeVisible(preampGainKnob);
     addAndMakeVisible(bassKnob);
@@ -69,6 +134,7 @@ OrangeAmpSimulatorAudioProcessorEditor::OrangeAmpSimulatorAudioProcessorEditor(
     addAndMakeVisible(driveKnob);
     addAndMakeVisible(presenceKnob);
     addAndMakeVisible(masterVolumeKnob);
+    addAndMakeVisible(gateThresholdKnob);
 
     // Start timer to sync GUI with parameter changes (e.g., from DAW automation)
     startTimerHz(30); // 30 FPS update rate
@@ -103,6 +169,12 @@ void OrangeAmpSimulatorAudioProcessorEditor::paint(juce::Graphics& g)
         g.setColour(logoColor);
         g.setFont(juce::Font("Arial", 32.0f, juce::Font::bold));
         g.drawText("ORANGE", topBar, juce::Justification::centred);
+
+        // Oversampling selector captions
+        g.setColour(textColor.withAlpha(0.6f));
+        g.setFont(10.0f);
+        g.drawText("QUALITY", 30, 12, 90, 14, juce::Justification::centredLeft);
+        g.drawText("OFFLINE", getWidth() - 120, 12, 90, 14, juce::Justification::centredLeft);
     }
 
     // Draw section labels
@@ -148,6 +220,12 @@ void OrangeAmpSimulatorAudioProcessorEditor::paint(juce::Graphics& g)
         g.setFont(juce::Font("Arial", 14.0f, juce::Font::bold));
         auto bottomArea = getLocalBounds().removeFromBottom(30);
         g.drawText("TUBE AMP SIMULATOR", bottomArea, juce::Justification::centred);
+
+        // Loaded cabinet impulse response
+        g.setColour(textColor.withAlpha(0.6f));
+        g.setFont(10.0f);
+        g.drawText(impulseName.isEmpty() ? juce::String("NO CABINET IR") : impulseName.toUpperCase(),
+                   115, getHeight() - 27, 150, 20, juce::Justification::centredLeft, true);
     }
 }
 
@@ -157,18 +235,32 @@ void OrangeAmpSimulatorAudioProcessorEditor::resized()
     bounds.removeFromTop(100);  // Skip header area
     bounds.removeFromBottom(30); // Skip footer area
 
+    // Oversampling selectors in the top bar corners
+    oversamplingSelector.setBounds(30, 28, 90, 22);
+    offlineOversamplingSelector.setBounds(getWidth() - 120, 28, 90, 22);
+    loadMeter.setBounds(130, 28, 90, 22);
+
+    // Cabinet controls in the footer corners
+    loadImpulseButton.setBounds(30, getHeight() - 27, 80, 20);
+    cabinetButton.setBounds(getWidth() - 110, getHeight() - 27, 80, 20);
+    gateButton.setBounds(getWidth() - 200, getHeight() - 27, 80, 20);
+
     const int knobWidth = 80;
     const int knobHeight = 100;
     const int spacing = 20;
 
     // Layout knobs in sections
 
-    // Preamp section (left)
+    // Preamp section (left) - gate threshold stacked under gain
     auto preampSection = bounds.removeFromLeft(170);
     preampGainKnob.setBounds(preampSection.getCentreX() - knobWidth / 2,
-                             preampSection.getCentreY() - knobHeight / 2,
+                             preampSection.getCentreY() - knobHeight - 10,
                              knobWidth, knobHeight);
 
+    gateThresholdKnob.setBounds(preampSection.getCentreX() - knobWidth / 2,
+                                preampSection.getCentreY() + 10,
+                                knobWidth, knobHeight);
+
     bounds.removeFromLeft(30); // Spacing
 
     // Tone stack section (center) - 2 rows
@@ -216,4 +308,36 @@ void OrangeAmpSimulatorAudioProcessorEditor::timerCallback()
     driveKnob.setValue(*audioProcessor.driveParam);
     presenceKnob.setValue(*audioProcessor.presenceParam);
     masterVolumeKnob.setValue(*audioProcessor.masterVolumeParam);
+    gateThresholdKnob.setValue(*audioProcessor.gateThresholdParam);
+    oversamplingSelector.setSelectedItemIndex(audioProcessor.oversamplingParam->getIndex(),
+                                              juce::dontSendNotification);
+    offlineOversamplingSelector.setSelectedItemIndex(audioProcessor.offlineOversamplingParam->getIndex(),
+                                                     juce::dontSendNotification);
+    cabinetButton.setToggleState(audioProcessor.cabinetParam->get(), juce::dontSendNotification);
+    gateButton.setToggleState(audioProcessor.gateParam->get(), juce::dontSendNotification);
+
+    // Pick up IRs restored from a saved session
+    const auto currentImpulseName = audioProcessor.getCabinetImpulseResponseFile().getFileNameWithoutExtension();
+    if (currentImpulseName != impulseName)
+    {
+        impulseName = currentImpulseName;
+        repaint();
+    }
+}
+
+void OrangeAmpSimulatorAudioProcessorEditor::chooseImpulseResponse()
+{
+    impulseChooser = std::make_unique<juce::FileChooser>("Load cabinet impulse response",
+                                                         audioProcessor.getCabinetImpulseResponseFile(),
+                                                         "*.wav;*.aif;*.aiff");
+
+    const auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
+
+    impulseChooser->launchAsync(flags, [this](const juce::FileChooser& chooser)
+    {
+        const auto file = chooser.getResult();
+
+        if (file.existsAsFile())
+            audioProcessor.loadCabinetImpulseResponse(file);
+    });
 }
@@ -2,6 +2,7 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "CustomKnob.h"
+#include "DspLoadMeter.h"
 
 /**
  * OrangeAmpSimulatorAudioProcessorEditor
@@ -10,6 +11,9 @@
  * - Orange amp-style visual design
  * - Interactive knobs for all parameters
  * - Amp-like layout and aesthetics
+ * - Oversampling quality selectors and a DSP load meter in the top bar
+ * - Cabinet impulse response loader and on/off switch in the footer
+ * - Noise gate threshold in the preamp section, gate switch in the footer
  * - Real-time parameter updates
  */
 class OrangeAmpSimulatorAudioProcessorEditor : public juce::AudioProcessorEditor,
@@ -35,6 +39,22 @@ private:
     CustomKnob driveKnob;
     CustomKnob presenceKnob;
     CustomKnob masterVolumeKnob;
+    CustomKnob gateThresholdKnob;
+
+    // Oversampling quality selectors (live and offline render)
+    juce::ComboBox oversamplingSelector;
+    juce::ComboBox offlineOversamplingSelector;
+
+    DspLoadMeter loadMeter;
+
+    // Speaker cabinet controls
+    juce::TextButton loadImpulseButton { "LOAD IR" };
+    juce::TextButton cabinetButton { "CAB" };
+    juce::TextButton gateButton { "GATE" };
+    std::unique_ptr<juce::FileChooser> impulseChooser;
+    juce::String impulseName;
+
+    void chooseImpulseResponse();
 
     // Colors for amp aesthetic
     const juce::Colour orangeColor = juce::Colour(0xFFFF8C00);
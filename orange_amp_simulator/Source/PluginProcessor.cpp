@@ -50,6 +50,38 @@ OrangeAmpSimulatorAudioProcessor::OrangeAmpSimulatorAudioProcessor()
         "Master Volume",
         0.0f, 1.0f,
         0.7f));                 // Default 70% volume
+
+    // Oversampling quality for the nonlinear stages
+    // Offline renders can afford a higher setting than live playback
+    addParameter(oversamplingParam = new juce::AudioParameterChoice(
+        "oversampling",
+        "Oversampling",
+        juce::StringArray{"Off", "2x", "4x", "8x"},
+        1));                    // Default 2x
+
+    addParameter(offlineOversamplingParam = new juce::AudioParameterChoice(
+        "offlineOversampling",
+        "Offline Oversampling",
+        juce::StringArray{"Off", "2x", "4x", "8x"},
+        2));                    // Default 4x
+
+    // Speaker cabinet stage - passes audio through until an IR is loaded
+    addParameter(cabinetParam = new juce::AudioParameterBool(
+        "cabinet",
+        "Cabinet",
+        true));
+
+    // Noise gate in front of the preamp - off by default
+    addParameter(gateParam = new juce::AudioParameterBool(
+        "gate",
+        "Noise Gate",
+        false));
+
+    addParameter(gateThresholdParam = new juce::AudioParameterFloat(
+        "gateThreshold",
+        "Gate Threshold",
+        0.0f, 1.0f,
+        0.333f));               // -40dB
 }
 
 OrangeAmpSimulatorAudioProcessor::~OrangeAmpSimulatorAudioProcessor()
@@ -78,7 +110,7 @@ bool OrangeAmpSimulatorAudioProcessor::isMidiEffect() const
 
 double OrangeAmpSimulatorAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return ampSim.getCabinetTailSeconds();
 }
 
 int OrangeAmpSimulatorAudioProcessor::getNumPrograms()
@@ -111,6 +143,33 @@ void OrangeAmpSimulatorAudioProcessor::prepareToPlay(double sampleRate, int samp
 {
     // Prepare DSP engine
     ampSim.prepare(sampleRate, samplesPerBlock, getTotalNumInputChannels());
+    loadMonitor.prepare(sampleRate);
+    ampSim.setLoadMonitor(&loadMonitor);
+
+    // Safe to tell the host directly here, and nothing is left to report later
+    updateOversampling();
+    cancelPendingUpdate();
+    setLatencySamples(ampSim.getLatencySamples());
+}
+
+bool OrangeAmpSimulatorAudioProcessor::updateOversampling()
+{
+    const int qualityIndex = isNonRealtime() ? offlineOversamplingParam->getIndex()
+                                             : oversamplingParam->getIndex();
+
+    if (qualityIndex == ampSim.getOversampling())
+        return false;
+
+    // The oversamplers are all allocated in prepare(), so switching is
+    // audio-thread safe; only the host notification has to wait
+    ampSim.setOversampling(qualityIndex);
+    pendingLatencySamples = ampSim.getLatencySamples();
+    return true;
+}
+
+void OrangeAmpSimulatorAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(pendingLatencySamples.load());
 }
 
 void OrangeAmpSimulatorAudioProcessor::releaseResources()
@@ -138,16 +197,26 @@ void OrangeAmpSimulatorAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
     juce::ignoreUnused(midiMessages);
 
     juce::ScopedNoDenormals noDenormals;
+    DspLoadMonitor::ScopedBlock loadTiming(loadMonitor, buffer.getNumSamples());
 
     // Update DSP parameters from plugin parameters
     // These are read from the parameter pointers (set by DAW or GUI)
-    ampSim.setPreampGain(*preampGainParam);
-    ampSim.setBass(*bassParam);
-    ampSim.setMiddle(*middleParam);
-    ampSim.setTreble(*trebleParam);
-    ampSim.setDrive(*driveParam);
-    ampSim.setPresence(*presenceParam);
-    ampSim.setMasterVolume(*masterVolumeParam);
+    AmpSimDSP::Parameters parameters;
+    parameters.preampGain = *preampGainParam;
+    parameters.bass = *bassParam;
+    parameters.middle = *middleParam;
+    parameters.treble = *trebleParam;
+    parameters.drive = *driveParam;
+    parameters.presence = *presenceParam;
+    parameters.masterVolume = *masterVolumeParam;
+    parameters.cabinetEnabled = *cabinetParam;
+    parameters.gateEnabled = *gateParam;
+    parameters.gateThreshold = *gateThresholdParam;
+    ampSim.setParameters(parameters);
+
+    // Changing the reported latency isn't safe from the audio callback
+    if (updateOversampling())
+        triggerAsyncUpdate();
 
     // Process audio through amp simulator
     ampSim.processBlock(buffer);
@@ -158,6 +227,16 @@ bool OrangeAmpSimulatorAudioProcessor::hasEditor() const
     return true;
 }
 
+bool OrangeAmpSimulatorAudioProcessor::loadCabinetImpulseResponse(const juce::File& file)
+{
+    return ampSim.loadCabinetImpulseResponse(file);
+}
+
+juce::File OrangeAmpSimulatorAudioProcessor::getCabinetImpulseResponseFile() const
+{
+    return ampSim.getCabinetImpulseResponseFile();
+}
+
 juce::AudioProcessorEditor* OrangeAmpSimulatorAudioProcessor::createEditor()
 {
     return new OrangeAmpSimulatorAudioProcessorEditor(*this);
@@ -175,6 +254,12 @@ void OrangeAmpSimulatorAudioProcessor::getStateInformation(juce::MemoryBlock& de
     stream.writeFloat(*driveParam);
     stream.writeFloat(*presenceParam);
     stream.writeFloat(*masterVolumeParam);
+    stream.writeInt(oversamplingParam->getIndex());
+    stream.writeInt(offlineOversamplingParam->getIndex());
+    stream.writeBool(*cabinetParam);
+    stream.writeString(ampSim.getCabinetImpulseResponseFile().getFullPathName());
+    stream.writeBool(*gateParam);
+    stream.writeFloat(*gateThresholdParam);
 }
 
 void OrangeAmpSimulatorAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -189,6 +274,32 @@ void OrangeAmpSimulatorAudioProcessor::setStateInformation(const void* data, int
     driveParam->setValueNotifyingHost(stream.readFloat());
     presenceParam->setValueNotifyingHost(stream.readFloat());
     masterVolumeParam->setValueNotifyingHost(stream.readFloat());
+
+    // Oversampling settings were added later - older sessions keep the defaults
+    if (!stream.isExhausted())
+    {
+        oversamplingParam->setValueNotifyingHost(oversamplingParam->convertTo0to1(stream.readInt()));
+        offlineOversamplingParam->setValueNotifyingHost(offlineOversamplingParam->convertTo0to1(stream.readInt()));
+    }
+
+    // Cabinet settings were added after that
+    if (!stream.isExhausted())
+    {
+        cabinetParam->setValueNotifyingHost(stream.readBool() ? 1.0f : 0.0f);
+
+        const juce::File impulseFile(stream.readString());
+        if (impulseFile.existsAsFile())
+            ampSim.loadCabinetImpulseResponse(impulseFile);
+        else
+            ampSim.clearCabinetImpulseResponse();
+    }
+
+    // Then the noise gate
+    if (!stream.isExhausted())
+    {
+        gateParam->setValueNotifyingHost(stream.readBool() ? 1.0f : 0.0f);
+        gateThresholdParam->setValueNotifyingHost(stream.readFloat());
+    }
 }
 
 // This creates new instances of the plugin
@@ -11,7 +11,8 @@
  * - State save/load for DAW projects
  * - Editor creation
  */
-class OrangeAmpSimulatorAudioProcessor : public juce::AudioProcessor
+class OrangeAmpSimulatorAudioProcessor : public juce::AudioProcessor,
+                                         private juce::AsyncUpdater
 {
 public:
     OrangeAmpSimulatorAudioProcessor();
@@ -48,10 +49,32 @@ public:
     juce::AudioParameterFloat* driveParam;
     juce::AudioParameterFloat* presenceParam;
     juce::AudioParameterFloat* masterVolumeParam;
+    juce::AudioParameterChoice* oversamplingParam;         // Real-time quality
+    juce::AudioParameterChoice* offlineOversamplingParam;  // Quality used for offline renders
+    juce::AudioParameterBool* cabinetParam;                // Speaker cabinet on/off
+    juce::AudioParameterBool* gateParam;                   // Noise gate before the preamp
+    juce::AudioParameterFloat* gateThresholdParam;
+
+    // Cabinet impulse response (message thread)
+    bool loadCabinetImpulseResponse(const juce::File& file);
+    juce::File getCabinetImpulseResponseFile() const;
+
+    // Per-block and per-stage timings for the editor's load meter
+    DspLoadMonitor& getLoadMonitor() { return loadMonitor; }
 
 private:
     // DSP engine
     AmpSimDSP ampSim;
+    DspLoadMonitor loadMonitor { AmpSimDSP::getLoadStageNames() };
+
+    // Pick the oversampling mode for the current render context. Returns
+    // true if the mode (and so the latency) changed.
+    bool updateOversampling();
+
+    // Latency changes found on the audio thread are reported to the host
+    // from the message thread
+    std::atomic<int> pendingLatencySamples { 0 };
+    void handleAsyncUpdate() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OrangeAmpSimulatorAudioProcessor)
 };
@@ -0,0 +1,244 @@
+#include <JuceHeader.h>
+#include <iostream>
+#include "RenderJob.h"
+#include "BassSampleLibrary.h"
+
+/**
+ * plugin_render - Offline, headless rendering through the plugins' DSP
+ *
+ * Batch-reamps audio files (or plays MIDI files, for the bass) through one
+ * of the plugins with a JSON preset/automation file, spreading the files
+ * over a pool of worker threads. See printUsage() for the options.
+ */
+namespace
+{
+    void printUsage()
+    {
+        std::cout
+            << "Usage: plugin_render --plugin=<name> [options] <input files or directories...>\n"
+               "\n"
+               "Plugins: " << RenderEngine::getPluginNames().joinIntoString(", ") << "\n"
+               "  Effects read audio files, \"bass\" reads MIDI files.\n"
+               "\n"
+               "Options:\n"
+               "  --plugin=<name>          Plugin to render through (or set \"plugin\" in the preset)\n"
+               "  --preset=<file.json>     Parameter values and automation\n"
+               "  --output=<directory>     Where to write results (default: next to each input)\n"
+               "  --suffix=<text>          Appended to output file names (default: _<plugin>)\n"
+               "  --jobs=<n>               Files rendered in parallel (default: number of CPUs)\n"
+               "  --block=<samples>        Processing block size (default: 8192)\n"
+               "  --automation-interval=<samples>\n"
+               "                           Automation resolution (default: 64)\n"
+               "  --rate=<hz>              Sample rate for MIDI renders (default: 48000)\n"
+               "  --bits=<16|24|32>        Output WAV bit depth (default: 24)\n"
+               "  --tail=<seconds>         Extra time rendered after the input ends (default: 0)\n"
+               "\n"
+               "Packing a bass sample library (loads instantly, shared between instances):\n"
+               "  plugin_render --pack-bass-samples=<folder> [--output=<file.bbsl>] [--bits=<16|24|32>]\n"
+               "\n"
+               "Preset file:\n"
+               "  { \"plugin\": \"orange\",\n"
+               "    \"parameters\": { \"drive\": 0.6, \"offlineOversampling\": \"8x\" },\n"
+               "    \"automation\": { \"masterVolume\": [[0.0, 0.7], [10.0, 0.0]] } }\n";
+    }
+
+    int getIntOption(const juce::ArgumentList& args, const juce::String& option, int defaultValue)
+    {
+        const auto value = args.getValueForOption(option);
+        return value.isEmpty() ? defaultValue : value.getIntValue();
+    }
+
+    double getDoubleOption(const juce::ArgumentList& args, const juce::String& option, double defaultValue)
+    {
+        const auto value = args.getValueForOption(option);
+        return value.isEmpty() ? defaultValue : value.getDoubleValue();
+    }
+
+    int packBassSamples(const juce::ArgumentList& args)
+    {
+        const auto workingDirectory = juce::File::getCurrentWorkingDirectory();
+        const auto folder = workingDirectory.getChildFile(args.getValueForOption("--pack-bass-samples"));
+        const auto outputOption = args.getValueForOption("--output");
+
+        // Next to the folder unless told otherwise
+        const auto outputFile = (outputOption.isEmpty() ? folder : workingDirectory.getChildFile(outputOption))
+                                    .withFileExtension("bbsl");
+
+        const auto result = BassSampleLibrary::writePackedFile(folder, outputFile, getIntOption(args, "--bits", 24));
+
+        if (result.failed())
+        {
+            std::cerr << result.getErrorMessage() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Wrote " << outputFile.getFullPathName() << std::endl;
+        return 0;
+    }
+
+    // Positional arguments, with directories expanded to the files inside them
+    juce::Array<juce::File> findInputFiles(const juce::ArgumentList& args, bool instrument)
+    {
+        const juce::String wildcard = instrument ? "*.mid;*.midi"
+                                                 : "*.wav;*.aif;*.aiff;*.flac;*.ogg";
+        juce::Array<juce::File> files;
+
+        for (const auto& argument : args.arguments)
+        {
+            if (argument.isOption())
+                continue;
+
+            const auto file = argument.resolveAsFile();
+
+            if (file.isDirectory())
+            {
+                auto found = file.findChildFiles(juce::File::findFiles, false, wildcard);
+                found.sort();
+                files.addArray(found);
+            }
+            else
+            {
+                files.add(file);
+            }
+        }
+
+        return files;
+    }
+
+    int runRenders(const juce::ArgumentList& args)
+    {
+        RenderPreset preset;
+        const auto presetPath = args.getValueForOption("--preset");
+
+        if (presetPath.isNotEmpty())
+        {
+            const auto presetResult = preset.loadFromFile(juce::File::getCurrentWorkingDirectory().getChildFile(presetPath));
+
+            if (presetResult.failed())
+            {
+                std::cerr << "Couldn't load preset: " << presetResult.getErrorMessage() << std::endl;
+                return 1;
+            }
+        }
+
+        RenderJob::Settings settings;
+        settings.pluginName = args.getValueForOption("--plugin");
+
+        if (settings.pluginName.isEmpty())
+            settings.pluginName = preset.getPluginName();
+
+        const auto engine = RenderEngine::create(settings.pluginName);
+
+        if (engine == nullptr)
+        {
+            std::cerr << "Unknown plugin \"" << settings.pluginName << "\" - choose one of: "
+                      << RenderEngine::getPluginNames().joinIntoString(", ") << std::endl;
+            return 1;
+        }
+
+        settings.preset = presetPath.isNotEmpty() ? &preset : nullptr;
+        settings.midiSampleRate = getDoubleOption(args, "--rate", settings.midiSampleRate);
+        settings.blockSize = juce::jmax(32, getIntOption(args, "--block", settings.blockSize));
+        settings.automationInterval = juce::jmax(1, getIntOption(args, "--automation-interval", settings.automationInterval));
+        settings.extraTailSeconds = juce::jmax(0.0, getDoubleOption(args, "--tail", settings.extraTailSeconds));
+        settings.bitsPerSample = getIntOption(args, "--bits", settings.bitsPerSample);
+
+        const auto inputFiles = findInputFiles(args, engine->isInstrument());
+
+        if (inputFiles.isEmpty())
+        {
+            std::cerr << "No input files" << std::endl;
+            return 1;
+        }
+
+        const auto outputOption = args.getValueForOption("--output");
+        const auto outputDirectory = outputOption.isEmpty() ? juce::File()
+                                                            : juce::File::getCurrentWorkingDirectory().getChildFile(outputOption);
+
+        if (outputDirectory != juce::File() && !outputDirectory.createDirectory())
+        {
+            std::cerr << "Couldn't create " << outputDirectory.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        const auto suffix = args.containsOption("--suffix") ? args.getValueForOption("--suffix")
+                                                             : "_" + settings.pluginName.toLowerCase();
+
+        // Every job owns its engine, so files can render side by side
+        const int numThreads = juce::jlimit(1, inputFiles.size(), getIntOption(args, "--jobs", juce::SystemStats::getNumCpus()));
+        juce::OwnedArray<RenderJob> jobs;
+
+        for (const auto& inputFile : inputFiles)
+        {
+            const auto directory = outputDirectory == juce::File() ? inputFile.getParentDirectory() : outputDirectory;
+            const auto outputFile = directory.getChildFile(inputFile.getFileNameWithoutExtension() + suffix + ".wav");
+
+            if (outputFile == inputFile)
+            {
+                std::cerr << "Refusing to overwrite the input " << inputFile.getFullPathName() << std::endl;
+                return 1;
+            }
+
+            jobs.add(new RenderJob(inputFile, outputFile, settings));
+        }
+
+        // Declared after the jobs so it's destroyed (and stopped) before them
+        juce::ThreadPool pool(numThreads);
+
+        for (auto* job : jobs)
+            pool.addJob(job, false);
+
+        int numFailed = 0;
+        double totalRendered = 0.0;
+        const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+        for (auto* job : jobs)
+        {
+            pool.waitForJobToFinish(job, -1);
+
+            const auto result = job->getResult();
+
+            if (result.failed())
+            {
+                ++numFailed;
+                std::cerr << job->getInputFile().getFileName() << ": " << result.getErrorMessage() << std::endl;
+                continue;
+            }
+
+            totalRendered += job->getRenderedSeconds();
+            std::cout << job->getInputFile().getFileName() << " -> " << job->getOutputFile().getFullPathName()
+                      << " (" << juce::String(job->getRenderedSeconds(), 1) << "s of audio in "
+                      << juce::String(job->getElapsedSeconds(), 2) << "s)" << std::endl;
+        }
+
+        const double elapsed = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+        std::cout << jobs.size() - numFailed << " of " << jobs.size() << " files rendered, "
+                  << juce::String(totalRendered / juce::jmax(elapsed, 0.001), 1) << "x real time on "
+                  << numThreads << " threads" << std::endl;
+
+        return numFailed == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.size() == 0 || args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    // Some DSP classes hand clean-up to the message thread. Nothing runs the
+    // loop here - the manager just has to exist while the renders run.
+    juce::MessageManager::getInstance();
+
+    const int exitCode = args.containsOption("--pack-bass-samples") ? packBassSamples(args)
+                                                                    : runRenders(args);
+
+    juce::DeletedAtShutdown::deleteAll();
+    juce::MessageManager::deleteInstance();
+
+    return exitCode;
+}
@@ -0,0 +1,380 @@
+#include "RenderEngine.h"
+#include "AmpSimDSP.h"
+#include "JazzChorusDSP.h"
+#include "BassSamplerEngine.h"
+
+namespace
+{
+    //==============================================================================
+    // Orange Amp Simulator - pushes AmpSimDSP::Parameters like
+    // OrangeAmpSimulatorAudioProcessor::processBlock
+    class OrangeAmpEngine : public RenderEngine
+    {
+    public:
+        OrangeAmpEngine()
+        {
+            const juce::StringArray oversamplingChoices { "Off", "2x", "4x", "8x" };
+            const AmpSimDSP::Parameters defaults;
+
+            preampGain = addParameter("preampGain", 0.0f, 1.0f, defaults.preampGain);
+            bass = addParameter("bass", 0.0f, 1.0f, defaults.bass);
+            middle = addParameter("middle", 0.0f, 1.0f, defaults.middle);
+            treble = addParameter("treble", 0.0f, 1.0f, defaults.treble);
+            drive = addParameter("drive", 0.0f, 1.0f, defaults.drive);
+            presence = addParameter("presence", 0.0f, 1.0f, defaults.presence);
+            masterVolume = addParameter("masterVolume", 0.0f, 1.0f, defaults.masterVolume);
+
+            // Offline renders use the plugin's offline quality setting
+            oversampling = addChoiceParameter("offlineOversampling", oversamplingChoices, 2);
+
+            cabinet = addBoolParameter("cabinet", defaults.cabinetEnabled);
+            gate = addBoolParameter("gate", defaults.gateEnabled);
+            gateThreshold = addParameter("gateThreshold", 0.0f, 1.0f, defaults.gateThreshold);
+        }
+
+        bool setParameter(const juce::String& parameterID, const juce::var& value) override
+        {
+            if (parameterID != "cabinetImpulseResponse")
+                return RenderEngine::setParameter(parameterID, value);
+
+            if (value.toString().isEmpty())
+            {
+                ampSim.clearCabinetImpulseResponse();
+                return true;
+            }
+
+            return ampSim.loadCabinetImpulseResponse(resolveAsset(value.toString()));
+        }
+
+        void prepare(double sampleRate, int maximumBlockSize, int numChannels) override
+        {
+            pushParameters();
+            ampSim.prepare(sampleRate, maximumBlockSize, numChannels);
+        }
+
+        void process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override
+        {
+            pushParameters();
+            ampSim.processBlock(buffer);
+        }
+
+        int getLatencySamples() const override
+        {
+            return ampSim.getLatencySamples();
+        }
+
+        double getTailSeconds() const override
+        {
+            return ampSim.getCabinetTailSeconds();
+        }
+
+    private:
+        AmpSimDSP ampSim;
+
+        int preampGain, bass, middle, treble, drive, presence, masterVolume;
+        int oversampling, cabinet, gate, gateThreshold;
+
+        void pushParameters()
+        {
+            AmpSimDSP::Parameters parameters;
+            parameters.preampGain = getValue(preampGain);
+            parameters.bass = getValue(bass);
+            parameters.middle = getValue(middle);
+            parameters.treble = getValue(treble);
+            parameters.drive = getValue(drive);
+            parameters.presence = getValue(presence);
+            parameters.masterVolume = getValue(masterVolume);
+            parameters.cabinetEnabled = getBool(cabinet);
+            parameters.gateEnabled = getBool(gate);
+            parameters.gateThreshold = getValue(gateThreshold);
+            ampSim.setParameters(parameters);
+
+            // Not part of Parameters: the processor chooses it, as here for a non-realtime render
+            ampSim.setOversampling(getIndex(oversampling));
+        }
+    };
+
+    //==============================================================================
+    // Jazz Chorus Amp - pushes JazzChorusDSP::Parameters like
+    // JazzChorusAmpAudioProcessor::processBlock
+    class JazzChorusEngine : public RenderEngine
+    {
+    public:
+        JazzChorusEngine()
+        {
+            const JazzChorusDSP::Parameters defaults;
+
+            volume = addParameter("volume", 0.0f, 1.0f, defaults.volume);
+            bass = addParameter("bass", 0.0f, 1.0f, defaults.bass);
+            middle = addParameter("middle", 0.0f, 1.0f, defaults.middle);
+            treble = addParameter("treble", 0.0f, 1.0f, defaults.treble);
+            bright = addParameter("bright", 0.0f, 1.0f, defaults.bright);
+            chorusRate = addParameter("chorusRate", 0.0f, 1.0f, defaults.chorusRate);
+            chorusDepth = addParameter("chorusDepth", 0.0f, 1.0f, defaults.chorusDepth);
+            chorusMix = addParameter("chorusMix", 0.0f, 1.0f, defaults.chorusMix);
+            chorusEnabled = addBoolParameter("chorusEnabled", defaults.chorusEnabled);
+            chorusVoices = addParameter("chorusVoices", 1.0f, static_cast<float>(ChorusEffect::maxVoices),
+                                        static_cast<float>(defaults.chorusVoices));
+            chorusInterpolation = addChoiceParameter("chorusInterpolation", { "Linear", "Hermite", "Lagrange", "Allpass", "Sinc" },
+                                                     defaults.chorusInterpolation);
+            chorusBucketBrigade = addBoolParameter("chorusBBD", defaults.chorusBucketBrigade);
+        }
+
+        void prepare(double sampleRate, int maximumBlockSize, int numChannels) override
+        {
+            pushParameters();
+            jazzChorusDSP.prepare(sampleRate, maximumBlockSize, numChannels);
+        }
+
+        void process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override
+        {
+            pushParameters();
+            jazzChorusDSP.processBlock(buffer);
+        }
+
+        double getTailSeconds() const override
+        {
+            return 0.05; // Longest chorus delay
+        }
+
+    private:
+        JazzChorusDSP jazzChorusDSP;
+
+        int volume, bass, middle, treble, bright;
+        int chorusRate, chorusDepth, chorusMix, chorusEnabled, chorusVoices, chorusInterpolation, chorusBucketBrigade;
+
+        void pushParameters()
+        {
+            JazzChorusDSP::Parameters parameters;
+            parameters.volume = getValue(volume);
+            parameters.bass = getValue(bass);
+            parameters.middle = getValue(middle);
+            parameters.treble = getValue(treble);
+            parameters.bright = getValue(bright);
+            parameters.chorusRate = getValue(chorusRate);
+            parameters.chorusDepth = getValue(chorusDepth);
+            parameters.chorusMix = getValue(chorusMix);
+            parameters.chorusEnabled = getBool(chorusEnabled);
+            parameters.chorusVoices = juce::roundToInt(getValue(chorusVoices));
+            parameters.chorusInterpolation = getIndex(chorusInterpolation);
+            parameters.chorusBucketBrigade = getBool(chorusBucketBrigade);
+            jazzChorusDSP.setParameters(parameters);
+        }
+    };
+
+    //==============================================================================
+    // MIDI Bass Guitar - pushes BassSamplerEngine::Parameters like
+    // MIDIBassGuitarAudioProcessor::processBlock
+    class BassGuitarEngine : public RenderEngine
+    {
+    public:
+        BassGuitarEngine()
+        {
+            const BassSamplerEngine::Parameters defaults;
+
+            articulation = addChoiceParameter("articulation", { "Picked", "Fingerstyle", "Slap", "Muted" }, defaults.articulation);
+            tone = addChoiceParameter("tone", { "DI", "Amp Sim", "Compressed", "Bright", "Vintage" }, defaults.tone);
+            voiceMode = addChoiceParameter("voiceMode", { "Poly", "Mono", "Legato" }, defaults.voiceMode);
+            polyphony = addParameter("polyphony", 1.0f, static_cast<float>(BassSynthesiser::maxPolyphony),
+                                     static_cast<float>(defaults.polyphony));
+            pitchBendRange = addParameter("pitchBendRange", 0.0f, 12.0f, static_cast<float>(defaults.pitchBendRange));
+            glideTime = addParameter("glideTime", 0.0f, 1.0f, defaults.glideTime);
+            synthesisModel = addChoiceParameter("synthesisModel", { "Wavetable", "String" }, defaults.synthesisModel);
+            bass = addParameter("bass", 0.0f, 1.0f, defaults.bass);
+            mid = addParameter("mid", 0.0f, 1.0f, defaults.mid);
+            treble = addParameter("treble", 0.0f, 1.0f, defaults.treble);
+            compression = addParameter("compression", 0.0f, 1.0f, defaults.compression);
+            outputGain = addParameter("outputGain", 0.0f, 1.0f, defaults.outputGain);
+
+            // Sample voices wait for the disk rather than drop out
+            sampler.setNonRealtime(true);
+        }
+
+        bool setParameter(const juce::String& parameterID, const juce::var& value) override
+        {
+            if (parameterID != "sampleLibrary")
+                return RenderEngine::setParameter(parameterID, value);
+
+            if (value.toString().isEmpty())
+            {
+                sampler.clearSampleLibrary();
+                return true;
+            }
+
+            return sampler.loadSampleLibrary(resolveAsset(value.toString()));
+        }
+
+        bool isInstrument() const override
+        {
+            return true;
+        }
+
+        void prepare(double sampleRate, int maximumBlockSize, int numChannels) override
+        {
+            pushParameters();
+            sampler.prepare(sampleRate, maximumBlockSize, numChannels);
+        }
+
+        void process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) override
+        {
+            pushParameters();
+            sampler.processBlock(buffer, midiMessages);
+        }
+
+        double getTailSeconds() const override
+        {
+            return 0.5; // Longest release plus the compressor letting go
+        }
+
+    private:
+        BassSamplerEngine sampler;
+
+        int articulation, tone, voiceMode, polyphony, pitchBendRange, glideTime, synthesisModel, bass, mid, treble, compression, outputGain;
+
+        void pushParameters()
+        {
+            BassSamplerEngine::Parameters parameters;
+            parameters.articulation = getIndex(articulation);
+            parameters.tone = getIndex(tone);
+            parameters.voiceMode = getIndex(voiceMode);
+            parameters.polyphony = juce::roundToInt(getValue(polyphony));
+            parameters.pitchBendRange = juce::roundToInt(getValue(pitchBendRange));
+            parameters.glideTime = getValue(glideTime);
+            parameters.synthesisModel = getIndex(synthesisModel);
+            parameters.bass = getValue(bass);
+            parameters.mid = getValue(mid);
+            parameters.treble = getValue(treble);
+            parameters.compression = getValue(compression);
+            parameters.outputGain = getValue(outputGain);
+            sampler.setParameters(parameters);
+        }
+    };
+
+    //==============================================================================
+    // Simple Gain Plugin - the plugin has no separate DSP class, so this is
+    // SimpleGainPluginAudioProcessor::processBlock restated
+    class SimpleGainEngine : public RenderEngine
+    {
+    public:
+        SimpleGainEngine()
+        {
+            gain = addParameter("gain", -60.0f, 12.0f, 0.0f);
+        }
+
+        void prepare(double, int, int) override
+        {
+        }
+
+        void process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override
+        {
+            buffer.applyGain(juce::Decibels::decibelsToGain(getValue(gain)));
+        }
+
+    private:
+        int gain;
+    };
+}
+
+//==============================================================================
+std::unique_ptr<RenderEngine> RenderEngine::create(const juce::String& pluginName)
+{
+    const auto name = pluginName.toLowerCase();
+
+    if (name == "orange")
+        return std::make_unique<OrangeAmpEngine>();
+
+    if (name == "jazz")
+        return std::make_unique<JazzChorusEngine>();
+
+    if (name == "bass")
+        return std::make_unique<BassGuitarEngine>();
+
+    if (name == "gain")
+        return std::make_unique<SimpleGainEngine>();
+
+    return nullptr;
+}
+
+juce::StringArray RenderEngine::getPluginNames()
+{
+    return { "orange", "jazz", "bass", "gain" };
+}
+
+bool RenderEngine::setParameter(const juce::String& parameterID, const juce::var& value)
+{
+    for (auto& parameter : parameters)
+    {
+        if (parameter.parameterID != parameterID)
+            continue;
+
+        float newValue = 0.0f;
+
+        if (value.isString() && !parameter.choices.isEmpty())
+        {
+            // Choices can be given by name ("4x", "Slap", ...)
+            const int index = parameter.choices.indexOf(value.toString(), true);
+
+            if (index < 0)
+                return false;
+
+            newValue = static_cast<float>(index);
+        }
+        else if (value.isBool() || value.isInt() || value.isInt64() || value.isDouble())
+        {
+            newValue = static_cast<float>(value);
+        }
+        else
+        {
+            return false;
+        }
+
+        parameter.value = juce::jlimit(parameter.minimum, parameter.maximum, newValue);
+        return true;
+    }
+
+    return false;
+}
+
+juce::StringArray RenderEngine::getParameterIDs() const
+{
+    juce::StringArray parameterIDs;
+
+    for (const auto& parameter : parameters)
+        parameterIDs.add(parameter.parameterID);
+
+    return parameterIDs;
+}
+
+int RenderEngine::addParameter(const juce::String& parameterID, float minimum, float maximum, float defaultValue)
+{
+    Parameter parameter;
+    parameter.parameterID = parameterID;
+    parameter.minimum = minimum;
+    parameter.maximum = maximum;
+    parameter.value = defaultValue;
+
+    parameters.add(parameter);
+    return parameters.size() - 1;
+}
+
+int RenderEngine::addBoolParameter(const juce::String& parameterID, bool defaultValue)
+{
+    return addParameter(parameterID, 0.0f, 1.0f, defaultValue ? 1.0f : 0.0f);
+}
+
+int RenderEngine::addChoiceParameter(const juce::String& parameterID, const juce::StringArray& choices, int defaultIndex)
+{
+    const int index = addParameter(parameterID, 0.0f, static_cast<float>(choices.size() - 1),
+                                   static_cast<float>(defaultIndex));
+    parameters.getReference(index).choices = choices;
+    return index;
+}
+
+juce::File RenderEngine::resolveAsset(const juce::String& path) const
+{
+    if (juce::File::isAbsolutePath(path))
+        return juce::File(path);
+
+    return (assetDirectory == juce::File() ? juce::File::getCurrentWorkingDirectory() : assetDirectory)
+               .getChildFile(path);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * RenderEngine - One plugin's DSP, driven without a host
+ *
+ * Each engine wraps the same DSP class its plugin uses and pushes parameter
+ * values into it through that class's setParameters(), the same call the
+ * plugin's processBlock() makes, so an offline render sounds the same as a
+ * bounce from a DAW.
+ *
+ * Parameters are addressed by the plugin's parameter IDs and take values in
+ * the plugin's own units (normalised 0-1 for the amps, dB for the gain
+ * plugin). Choice parameters accept an index or the choice name, booleans
+ * accept true/false or a number.
+ *
+ * Engines:
+ * - "orange" - Orange Amp Simulator (AmpSimDSP)
+ * - "jazz"   - Jazz Chorus Amp (JazzChorusDSP)
+ * - "bass"   - MIDI Bass Guitar (BassSamplerEngine), renders from MIDI
+ * - "gain"   - Simple Gain Plugin
+ */
+class RenderEngine
+{
+public:
+    virtual ~RenderEngine() = default;
+
+    // Returns nullptr for an unknown plugin name
+    static std::unique_ptr<RenderEngine> create(const juce::String& pluginName);
+    static juce::StringArray getPluginNames();
+
+    // Instruments render from a MIDI file, effects from an audio file
+    virtual bool isInstrument() const { return false; }
+
+    // Returns false for an unknown parameter ID or an unusable value
+    virtual bool setParameter(const juce::String& parameterID, const juce::var& value);
+    juce::StringArray getParameterIDs() const;
+
+    // Relative file paths in parameter values (e.g. an impulse response)
+    // are resolved against this directory
+    void setAssetDirectory(const juce::File& directory) { assetDirectory = directory; }
+
+    virtual void prepare(double sampleRate, int maximumBlockSize, int numChannels) = 0;
+    virtual void process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) = 0;
+
+    virtual int getLatencySamples() const { return 0; }
+    virtual double getTailSeconds() const { return 0.0; }
+
+protected:
+    // Engines register their parameters in the constructor and read them
+    // back by the returned index
+    int addParameter(const juce::String& parameterID, float minimum, float maximum, float defaultValue);
+    int addBoolParameter(const juce::String& parameterID, bool defaultValue);
+    int addChoiceParameter(const juce::String& parameterID, const juce::StringArray& choices, int defaultIndex);
+
+    float getValue(int index) const { return parameters.getReference(index).value; }
+    bool getBool(int index) const { return getValue(index) >= 0.5f; }
+    int getIndex(int index) const { return juce::roundToInt(getValue(index)); }
+
+    juce::File resolveAsset(const juce::String& path) const;
+
+private:
+    struct Parameter
+    {
+        juce::String parameterID;
+        float minimum = 0.0f;
+        float maximum = 1.0f;
+        float value = 0.0f;
+        juce::StringArray choices;  // Empty for float/bool parameters
+    };
+
+    juce::Array<Parameter> parameters;
+    juce::File assetDirectory;
+};
@@ -0,0 +1,214 @@
+#include "RenderJob.h"
+
+RenderJob::RenderJob(const juce::File& inputFileToUse, const juce::File& outputFileToUse, const Settings& settingsToUse)
+    : juce::ThreadPoolJob("Render " + inputFileToUse.getFileName()),
+      inputFile(inputFileToUse),
+      outputFile(outputFileToUse),
+      settings(settingsToUse)
+{
+}
+
+juce::ThreadPoolJob::JobStatus RenderJob::runJob()
+{
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+    result = render();
+
+    elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    return jobHasFinished;
+}
+
+juce::Result RenderJob::render()
+{
+    auto engine = RenderEngine::create(settings.pluginName);
+
+    if (engine == nullptr)
+        return juce::Result::fail("Unknown plugin \"" + settings.pluginName + "\"");
+
+    const auto* preset = settings.preset;
+    juce::NamedValueSet appliedValues;
+
+    if (preset != nullptr)
+    {
+        engine->setAssetDirectory(preset->getDirectory());
+
+        auto parameterResult = applyParameters(*engine, preset->getParameters(), appliedValues);
+
+        if (parameterResult.failed())
+            return parameterResult;
+
+        juce::NamedValueSet automationValues;
+        preset->getAutomationValues(0.0, automationValues);
+        parameterResult = applyParameters(*engine, automationValues, appliedValues);
+
+        if (parameterResult.failed())
+            return parameterResult;
+    }
+
+    // Source - audio for effects, MIDI for instruments
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::MidiBuffer midiEvents;
+    double sampleRate = settings.midiSampleRate;
+    int numChannels = 2;
+    juce::int64 sourceLength = 0;
+
+    if (engine->isInstrument())
+    {
+        const auto midiResult = readMidiFile(inputFile, sampleRate, midiEvents);
+
+        if (midiResult.failed())
+            return midiResult;
+
+        sourceLength = midiEvents.isEmpty() ? 0 : midiEvents.getLastEventTime() + 1;
+    }
+    else
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        reader.reset(formatManager.createReaderFor(inputFile));
+
+        if (reader == nullptr)
+            return juce::Result::fail("Couldn't read audio from " + inputFile.getFullPathName());
+
+        sampleRate = reader->sampleRate;
+        numChannels = static_cast<int>(juce::jlimit(1u, 2u, reader->numChannels));
+        sourceLength = reader->lengthInSamples;
+    }
+
+    engine->prepare(sampleRate, settings.blockSize, numChannels);
+
+    // Render the tail past the end of the source, plus enough extra to cover the latency we trim off the front
+    const int latency = engine->getLatencySamples();
+    const auto tailLength = static_cast<juce::int64>(std::ceil((engine->getTailSeconds() + settings.extraTailSeconds) * sampleRate));
+    const juce::int64 outputLength = sourceLength + tailLength;
+    const juce::int64 totalLength = outputLength + latency;
+
+    // Write to a temporary file next to the output and move it into place when done
+    juce::TemporaryFile temporaryFile(outputFile);
+    std::unique_ptr<juce::OutputStream> stream(temporaryFile.getFile().createOutputStream());
+
+    if (stream == nullptr)
+        return juce::Result::fail("Couldn't write to " + outputFile.getFullPathName());
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), sampleRate,
+                                                                              static_cast<unsigned int>(numChannels),
+                                                                              settings.bitsPerSample, {}, 0));
+
+    if (writer == nullptr)
+        return juce::Result::fail("Can't write a " + juce::String(settings.bitsPerSample) + "-bit WAV file");
+
+    stream.release(); // The writer owns the stream now
+
+    const bool automated = preset != nullptr && preset->hasAutomation();
+    const int sliceLength = automated ? juce::jlimit(1, settings.blockSize, settings.automationInterval)
+                                      : settings.blockSize;
+
+    juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+    juce::MidiBuffer sliceEvents;
+    juce::NamedValueSet automationValues;
+    auto nextEvent = midiEvents.cbegin();
+
+    for (juce::int64 position = 0; position < totalLength; position += settings.blockSize)
+    {
+        if (shouldExit())
+            return juce::Result::fail("Cancelled");
+
+        const int blockLength = static_cast<int>(juce::jmin(static_cast<juce::int64>(settings.blockSize), totalLength - position));
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, blockLength);
+
+        // Reading past the end of the file gives silence, which plays out the tail
+        if (reader != nullptr)
+            reader->read(&block, 0, blockLength, position, true, true);
+        else
+            block.clear();
+
+        for (int sliceStart = 0; sliceStart < blockLength; sliceStart += sliceLength)
+        {
+            const int length = juce::jmin(sliceLength, blockLength - sliceStart);
+            const juce::int64 slicePosition = position + sliceStart;
+
+            if (automated)
+            {
+                // Already validated at time zero
+                preset->getAutomationValues(static_cast<double>(slicePosition) / sampleRate, automationValues);
+                applyParameters(*engine, automationValues, appliedValues);
+            }
+
+            sliceEvents.clear();
+
+            for (; nextEvent != midiEvents.cend() && (*nextEvent).samplePosition < slicePosition + length; ++nextEvent)
+                sliceEvents.addEvent((*nextEvent).getMessage(), static_cast<int>((*nextEvent).samplePosition - slicePosition));
+
+            juce::AudioBuffer<float> slice(block.getArrayOfWritePointers(), numChannels, sliceStart, length);
+            engine->process(slice, sliceEvents);
+        }
+
+        // Drop the first latency samples so the output lines up with the source
+        const int skip = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(blockLength),
+                                                       latency - position));
+
+        if (!writer->writeFromAudioSampleBuffer(block, skip, blockLength - skip))
+            return juce::Result::fail("Couldn't write to " + outputFile.getFullPathName());
+    }
+
+    writer.reset(); // Finishes the WAV header and closes the file
+
+    if (!temporaryFile.overwriteTargetFileWithTemporary())
+        return juce::Result::fail("Couldn't replace " + outputFile.getFullPathName());
+
+    renderedSeconds = static_cast<double>(outputLength) / sampleRate;
+    return juce::Result::ok();
+}
+
+juce::Result RenderJob::applyParameters(RenderEngine& engine, const juce::NamedValueSet& values,
+                                        juce::NamedValueSet& appliedValues) const
+{
+    for (const auto& value : values)
+    {
+        // Only pass on changes - some parameters (impulse responses) are expensive to set
+        if (const auto* applied = appliedValues.getVarPointer(value.name))
+            if (*applied == value.value)
+                continue;
+
+        if (!engine.setParameter(value.name.toString(), value.value))
+            return juce::Result::fail("Can't set " + value.name.toString() + " to " + value.value.toString()
+                                      + " on " + settings.pluginName + " (parameters: "
+                                      + engine.getParameterIDs().joinIntoString(", ") + ")");
+
+        appliedValues.set(value.name, value.value);
+    }
+
+    return juce::Result::ok();
+}
+
+juce::Result RenderJob::readMidiFile(const juce::File& file, double sampleRate, juce::MidiBuffer& events)
+{
+    juce::FileInputStream input(file);
+
+    if (!input.openedOk())
+        return juce::Result::fail("Couldn't open " + file.getFullPathName());
+
+    juce::MidiFile midiFile;
+
+    if (!midiFile.readFrom(input))
+        return juce::Result::fail(file.getFileName() + " isn't a MIDI file");
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    // Every track merged into one stream, timed in samples
+    for (int track = 0; track < midiFile.getNumTracks(); ++track)
+    {
+        for (const auto* holder : *midiFile.getTrack(track))
+        {
+            const auto& message = holder->message;
+
+            if (message.isMetaEvent())
+                continue;
+
+            events.addEvent(message, juce::roundToInt(message.getTimeStamp() * sampleRate));
+        }
+    }
+
+    return juce::Result::ok();
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <JuceHeader.h>
+#include "RenderEngine.h"
+#include "RenderPreset.h"
+
+/**
+ * RenderJob - Renders one input file through one plugin engine
+ *
+ * Effects stream the input audio file through the engine; instruments play
+ * a MIDI file. Audio is read, processed and written in large blocks, split
+ * into shorter slices only where automation needs to be applied.
+ *
+ * The engine's latency is compensated (the output lines up with the input)
+ * and its tail is rendered past the end of the input. Output is written to
+ * a temporary file and moved into place once complete, so a cancelled or
+ * failed render never leaves a truncated file behind.
+ *
+ * Every job owns its own engine, so jobs run in parallel on a ThreadPool.
+ */
+class RenderJob : public juce::ThreadPoolJob
+{
+public:
+    struct Settings
+    {
+        juce::String pluginName;
+        const RenderPreset* preset = nullptr;   // Optional, shared between jobs
+        double midiSampleRate = 48000.0;        // Instruments have no input rate to follow
+        int blockSize = 8192;
+        int automationInterval = 64;            // Samples between automation updates
+        double extraTailSeconds = 0.0;
+        int bitsPerSample = 24;
+    };
+
+    RenderJob(const juce::File& inputFile, const juce::File& outputFile, const Settings& settings);
+
+    JobStatus runJob() override;
+
+    const juce::File& getInputFile() const { return inputFile; }
+    const juce::File& getOutputFile() const { return outputFile; }
+
+    // Valid once the job has finished
+    juce::Result getResult() const { return result; }
+    double getRenderedSeconds() const { return renderedSeconds; }
+    double getElapsedSeconds() const { return elapsedSeconds; }
+
+private:
+    const juce::File inputFile;
+    const juce::File outputFile;
+    const Settings settings;
+
+    juce::Result result { juce::Result::ok() };
+    double renderedSeconds = 0.0;
+    double elapsedSeconds = 0.0;
+
+    juce::Result render();
+    juce::Result applyParameters(RenderEngine& engine, const juce::NamedValueSet& values,
+                                 juce::NamedValueSet& appliedValues) const;
+    static juce::Result readMidiFile(const juce::File& file, double sampleRate, juce::MidiBuffer& events);
+};
@@ -0,0 +1,95 @@
+#include "RenderPreset.h"
+
+juce::Result RenderPreset::loadFromFile(const juce::File& file)
+{
+    juce::var json;
+    const auto parseResult = juce::JSON::parse(file.loadFileAsString(), json);
+
+    if (parseResult.failed())
+        return juce::Result::fail(file.getFileName() + ": " + parseResult.getErrorMessage());
+
+    auto* root = json.getDynamicObject();
+
+    if (root == nullptr)
+        return juce::Result::fail(file.getFileName() + ": expected a JSON object");
+
+    pluginName = root->getProperty("plugin").toString();
+    directory = file.getParentDirectory();
+    parameters.clear();
+    automation.clear();
+
+    if (auto* parameterObject = root->getProperty("parameters").getDynamicObject())
+        parameters = parameterObject->getProperties();
+
+    if (auto* automationObject = root->getProperty("automation").getDynamicObject())
+    {
+        for (const auto& property : automationObject->getProperties())
+        {
+            Lane lane;
+            lane.parameterID = property.name;
+
+            const auto* pointList = property.value.getArray();
+
+            if (pointList == nullptr)
+                return juce::Result::fail("Automation for " + property.name.toString() + " must be a list of [seconds, value] points");
+
+            for (const auto& pointValue : *pointList)
+            {
+                const auto* pair = pointValue.getArray();
+
+                if (pair == nullptr || pair->size() != 2)
+                    return juce::Result::fail("Automation for " + property.name.toString() + " must be a list of [seconds, value] points");
+
+                Point point;
+                point.seconds = pair->getReference(0);
+                point.value = pair->getReference(1);
+                lane.points.add(point);
+            }
+
+            if (lane.points.isEmpty())
+                continue;
+
+            std::stable_sort(lane.points.begin(), lane.points.end(),
+                             [](const Point& a, const Point& b) { return a.seconds < b.seconds; });
+
+            automation.add(lane);
+        }
+    }
+
+    return juce::Result::ok();
+}
+
+void RenderPreset::getAutomationValues(double seconds, juce::NamedValueSet& values) const
+{
+    for (const auto& lane : automation)
+        values.set(lane.parameterID, interpolate(lane.points, seconds));
+}
+
+juce::var RenderPreset::interpolate(const juce::Array<Point>& points, double seconds)
+{
+    if (seconds <= points.getFirst().seconds)
+        return points.getFirst().value;
+
+    for (int index = 1; index < points.size(); ++index)
+    {
+        const auto& next = points.getReference(index);
+
+        if (seconds >= next.seconds)
+            continue;
+
+        const auto& previous = points.getReference(index - 1);
+        const auto isNumber = [](const juce::var& value) { return value.isInt() || value.isInt64() || value.isDouble(); };
+
+        // Bools and choice names can't be blended - hold until the next point
+        if (!isNumber(previous.value) || !isNumber(next.value))
+            return previous.value;
+
+        const double proportion = (seconds - previous.seconds) / (next.seconds - previous.seconds);
+        const double start = previous.value;
+        const double end = next.value;
+
+        return start + proportion * (end - start);
+    }
+
+    return points.getLast().value;
+}
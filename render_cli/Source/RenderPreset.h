@@ -0,0 +1,56 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * RenderPreset - Parameter settings and automation for an offline render
+ *
+ * Loaded from a JSON file:
+ *
+ *   {
+ *       "plugin": "orange",
+ *       "parameters": { "drive": 0.6, "offlineOversampling": "8x",
+ *                       "cabinetImpulseResponse": "irs/4x12.wav" },
+ *       "automation": { "drive": [[0.0, 0.2], [4.0, 0.9]],
+ *                       "gate":  [[0.0, false], [12.5, true]] }
+ *   }
+ *
+ * Automation is a list of [seconds, value] points per parameter. Numbers
+ * ramp linearly between points, anything else (bools, choice names) steps.
+ * Before the first point and after the last one the value holds.
+ * Relative file paths are relative to the preset file.
+ */
+class RenderPreset
+{
+public:
+    juce::Result loadFromFile(const juce::File& file);
+
+    juce::String getPluginName() const { return pluginName; }
+    juce::File getDirectory() const { return directory; }
+
+    const juce::NamedValueSet& getParameters() const { return parameters; }
+
+    bool hasAutomation() const { return !automation.isEmpty(); }
+
+    // Automated parameter values at a time in the render
+    void getAutomationValues(double seconds, juce::NamedValueSet& values) const;
+
+private:
+    struct Point
+    {
+        double seconds = 0.0;
+        juce::var value;
+    };
+
+    struct Lane
+    {
+        juce::Identifier parameterID;
+        juce::Array<Point> points;  // Sorted by time
+    };
+
+    juce::String pluginName;
+    juce::File directory;
+    juce::NamedValueSet parameters;
+    juce::Array<Lane> automation;
+
+    static juce::var interpolate(const juce::Array<Point>& points, double seconds);
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * BiquadCoefficients - Plain-value biquad coefficients (normalised so a0 = 1)
+ *
+ * Same RBJ cookbook designs as juce::dsp::IIR::Coefficients::make*, but
+ * computed straight into a small struct instead of a heap-allocated,
+ * reference-counted object. Safe to call on the audio thread.
+ *
+ * Difference equation (transposed direct form II):
+ *   y = b0*x + s1
+ *   s1 = b1*x - a1*y + s2
+ *   s2 = b2*x - a2*y
+ */
+struct BiquadCoefficients
+{
+    float b0 = 1.0f;
+    float b1 = 0.0f;
+    float b2 = 0.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+
+    // Pass-through (unity gain, no filtering)
+    static BiquadCoefficients identity() { return {}; }
+
+    static BiquadCoefficients makeLowShelf(double sampleRate, double frequency, double q, float gainFactor)
+    {
+        const double A = std::sqrt(juce::jmax(0.0, static_cast<double>(gainFactor)));
+        const double aMinus1 = A - 1.0;
+        const double aPlus1 = A + 1.0;
+        const double omega = (2.0 * juce::MathConstants<double>::pi * juce::jmax(frequency, 2.0)) / sampleRate;
+        const double cosOmega = std::cos(omega);
+        const double beta = std::sin(omega) * std::sqrt(A) / q;
+        const double aMinus1TimesCos = aMinus1 * cosOmega;
+
+        return normalise(A * (aPlus1 - aMinus1TimesCos + beta),
+                         A * 2.0 * (aMinus1 - aPlus1 * cosOmega),
+                         A * (aPlus1 - aMinus1TimesCos - beta),
+                         aPlus1 + aMinus1TimesCos + beta,
+                         -2.0 * (aMinus1 + aPlus1 * cosOmega),
+                         aPlus1 + aMinus1TimesCos - beta);
+    }
+
+    static BiquadCoefficients makeHighShelf(double sampleRate, double frequency, double q, float gainFactor)
+    {
+        const double A = std::sqrt(juce::jmax(0.0, static_cast<double>(gainFactor)));
+        const double aMinus1 = A - 1.0;
+        const double aPlus1 = A + 1.0;
+        const double omega = (2.0 * juce::MathConstants<double>::pi * juce::jmax(frequency, 2.0)) / sampleRate;
+        const double cosOmega = std::cos(omega);
+        const double beta = std::sin(omega) * std::sqrt(A) / q;
+        const double aMinus1TimesCos = aMinus1 * cosOmega;
+
+        return normalise(A * (aPlus1 + aMinus1TimesCos + beta),
+                         A * -2.0 * (aMinus1 + aPlus1 * cosOmega),
+                         A * (aPlus1 + aMinus1TimesCos - beta),
+                         aPlus1 - aMinus1TimesCos + beta,
+                         2.0 * (aMinus1 - aPlus1 * cosOmega),
+                         aPlus1 - aMinus1TimesCos - beta);
+    }
+
+    static BiquadCoefficients makePeakFilter(double sampleRate, double frequency, double q, float gainFactor)
+    {
+        const double A = std::sqrt(juce::jmax(0.0, static_cast<double>(gainFactor)));
+        const double omega = (2.0 * juce::MathConstants<double>::pi * juce::jmax(frequency, 2.0)) / sampleRate;
+        const double alpha = std::sin(omega) / (q * 2.0);
+        const double c2 = -2.0 * std::cos(omega);
+        const double alphaTimesA = alpha * A;
+        const double alphaOverA = alpha / A;
+
+        return normalise(1.0 + alphaTimesA, c2, 1.0 - alphaTimesA,
+                         1.0 + alphaOverA, c2, 1.0 - alphaOverA);
+    }
+
+    static BiquadCoefficients makeHighPass(double sampleRate, double frequency,
+                                           double q = 1.0 / juce::MathConstants<double>::sqrt2)
+    {
+        const double n = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        const double nSquared = n * n;
+        const double invQ = 1.0 / q;
+        const double c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+        return normalise(c1, c1 * -2.0, c1,
+                         1.0, c1 * 2.0 * (nSquared - 1.0), c1 * (1.0 - invQ * n + nSquared));
+    }
+
+    // Linear interpolation between two coefficient sets. Stays stable for
+    // biquads since the (a1, a2) stability triangle is convex.
+    static BiquadCoefficients interpolate(const BiquadCoefficients& from, const BiquadCoefficients& to, float amount)
+    {
+        return { from.b0 + (to.b0 - from.b0) * amount,
+                 from.b1 + (to.b1 - from.b1) * amount,
+                 from.b2 + (to.b2 - from.b2) * amount,
+                 from.a1 + (to.a1 - from.a1) * amount,
+                 from.a2 + (to.a2 - from.a2) * amount };
+    }
+
+private:
+    static BiquadCoefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+    {
+        const double a0Inv = 1.0 / a0;
+        return { static_cast<float>(b0 * a0Inv),
+                 static_cast<float>(b1 * a0Inv),
+                 static_cast<float>(b2 * a0Inv),
+                 static_cast<float>(a1 * a0Inv),
+                 static_cast<float>(a2 * a0Inv) };
+    }
+};
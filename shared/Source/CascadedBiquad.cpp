@@ -0,0 +1,212 @@
+#include "CascadedBiquad.h"
+
+namespace
+{
+#if JUCE_USE_SIMD
+    // One SIMD register holds the same sample position from several channels
+    using Vec = juce::dsp::SIMDRegister<float>;
+    constexpr int lanes = static_cast<int>(Vec::SIMDNumElements);
+
+    inline Vec broadcast(float value) { return Vec::expand(value); }
+    inline Vec load(const float* source) { return Vec::fromRawArray(source); }
+    inline void store(Vec value, float* destination) { value.copyToRawArray(destination); }
+#else
+    // Scalar fallback - one channel per "register"
+    using Vec = float;
+    constexpr int lanes = 1;
+
+    inline Vec broadcast(float value) { return value; }
+    inline Vec load(const float* source) { return *source; }
+    inline void store(Vec value, float* destination) { *destination = value; }
+#endif
+}
+
+CascadedBiquad::CascadedBiquad()
+{
+}
+
+void CascadedBiquad::prepare(double sampleRate, int numChannels)
+{
+    currentSampleRate = sampleRate;
+    numPreparedChannels = juce::jlimit(1, maxChannels, numChannels);
+    setRampTime(rampTimeSeconds);
+
+    // Jump straight to the current designs - nothing to glide from yet
+    for (auto& section : sections)
+    {
+        section.target = design(section.design);
+        section.current = section.target;
+        section.rampStart = section.target;
+        section.rampSubBlocksRemaining = 0;
+        section.needsRedesign = false;
+    }
+
+    reset();
+}
+
+void CascadedBiquad::reset()
+{
+    filterState.fill(0.0f);
+    samplesUntilRampStep = 0;
+}
+
+void CascadedBiquad::setSection(int index, SectionType type, double frequency, double q, float gainDb)
+{
+    jassert(juce::isPositiveAndBelow(index, maxSections));
+
+    auto& section = sections[static_cast<size_t>(index)];
+    const SectionDesign newDesign { type, frequency, q, gainDb };
+
+    numActiveSections = juce::jmax(numActiveSections, index + 1);
+
+    if (newDesign == section.design)
+        return;
+
+    section.design = newDesign;
+    section.needsRedesign = true;
+}
+
+void CascadedBiquad::setRampTime(double seconds)
+{
+    rampTimeSeconds = seconds;
+    rampLengthSubBlocks = juce::jmax(1, juce::roundToInt(seconds * currentSampleRate / subBlockSize));
+}
+
+BiquadCoefficients CascadedBiquad::design(const SectionDesign& sectionDesign) const
+{
+    const float gain = juce::Decibels::decibelsToGain(sectionDesign.gainDb);
+
+    switch (sectionDesign.type)
+    {
+        case SectionType::LowShelf:
+            return BiquadCoefficients::makeLowShelf(currentSampleRate, sectionDesign.frequency, sectionDesign.q, gain);
+        case SectionType::HighShelf:
+            return BiquadCoefficients::makeHighShelf(currentSampleRate, sectionDesign.frequency, sectionDesign.q, gain);
+        case SectionType::Peak:
+            return BiquadCoefficients::makePeakFilter(currentSampleRate, sectionDesign.frequency, sectionDesign.q, gain);
+        case SectionType::HighPass:
+            return BiquadCoefficients::makeHighPass(currentSampleRate, sectionDesign.frequency, sectionDesign.q);
+        case SectionType::Bypass:
+        default:
+            return BiquadCoefficients::identity();
+    }
+}
+
+void CascadedBiquad::updateCoefficients()
+{
+    for (int index = 0; index < numActiveSections; ++index)
+    {
+        auto& section = sections[static_cast<size_t>(index)];
+
+        if (!section.needsRedesign)
+            continue;
+
+        // Start a fresh ramp from wherever we are now
+        section.target = design(section.design);
+        section.rampStart = section.current;
+        section.rampSubBlocksRemaining = rampLengthSubBlocks;
+        section.needsRedesign = false;
+    }
+}
+
+void CascadedBiquad::advanceRamps()
+{
+    for (int index = 0; index < numActiveSections; ++index)
+    {
+        auto& section = sections[static_cast<size_t>(index)];
+
+        if (section.rampSubBlocksRemaining <= 0)
+            continue;
+
+        --section.rampSubBlocksRemaining;
+        const float progress = 1.0f - static_cast<float>(section.rampSubBlocksRemaining)
+                                          / static_cast<float>(rampLengthSubBlocks);
+        section.current = BiquadCoefficients::interpolate(section.rampStart, section.target, progress);
+    }
+}
+
+void CascadedBiquad::process(juce::dsp::AudioBlock<float>& block)
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), numPreparedChannels);
+    const int numSections = numActiveSections;
+
+    if (numSections == 0 || numChannels == 0)
+        return;
+
+    updateCoefficients();
+
+    std::array<Vec, maxSections> b0, b1, b2, a1, a2;
+    std::array<Vec, maxSections> s1, s2;
+    std::array<float*, lanes> channelData {};
+    alignas(32) float frame[lanes] = {};
+
+    for (int start = 0; start < numSamples;)
+    {
+        // A sub-block cut short by the end of the last call finishes here first
+        if (samplesUntilRampStep == 0)
+        {
+            advanceRamps();
+            samplesUntilRampStep = subBlockSize;
+        }
+
+        const int subBlockLength = juce::jmin(samplesUntilRampStep, numSamples - start);
+        samplesUntilRampStep -= subBlockLength;
+
+        // Broadcast this sub-block's coefficients into every lane
+        for (int index = 0; index < numSections; ++index)
+        {
+            const auto& c = sections[static_cast<size_t>(index)].current;
+            b0[static_cast<size_t>(index)] = broadcast(c.b0);
+            b1[static_cast<size_t>(index)] = broadcast(c.b1);
+            b2[static_cast<size_t>(index)] = broadcast(c.b2);
+            a1[static_cast<size_t>(index)] = broadcast(c.a1);
+            a2[static_cast<size_t>(index)] = broadcast(c.a2);
+        }
+
+        for (int firstChannel = 0; firstChannel < numChannels; firstChannel += lanes)
+        {
+            const int channelsInGroup = juce::jmin(lanes, numChannels - firstChannel);
+            float* groupState = filterState.data() + firstChannel * maxSections * 2;
+
+            for (int lane = 0; lane < channelsInGroup; ++lane)
+                channelData[static_cast<size_t>(lane)] = block.getChannelPointer(static_cast<size_t>(firstChannel + lane)) + start;
+
+            for (int index = 0; index < numSections; ++index)
+            {
+                s1[static_cast<size_t>(index)] = load(groupState + (index * 2) * lanes);
+                s2[static_cast<size_t>(index)] = load(groupState + (index * 2 + 1) * lanes);
+            }
+
+            for (int sample = 0; sample < subBlockLength; ++sample)
+            {
+                for (int lane = 0; lane < channelsInGroup; ++lane)
+                    frame[lane] = channelData[static_cast<size_t>(lane)][sample];
+
+                Vec x = load(frame);
+
+                // Transposed direct form II, every section while x stays in a register
+                for (size_t index = 0; index < static_cast<size_t>(numSections); ++index)
+                {
+                    const Vec y = b0[index] * x + s1[index];
+                    s1[index] = b1[index] * x - a1[index] * y + s2[index];
+                    s2[index] = b2[index] * x - a2[index] * y;
+                    x = y;
+                }
+
+                store(x, frame);
+
+                for (int lane = 0; lane < channelsInGroup; ++lane)
+                    channelData[static_cast<size_t>(lane)][sample] = frame[lane];
+            }
+
+            for (int index = 0; index < numSections; ++index)
+            {
+                store(s1[static_cast<size_t>(index)], groupState + (index * 2) * lanes);
+                store(s2[static_cast<size_t>(index)], groupState + (index * 2 + 1) * lanes);
+            }
+        }
+
+        start += subBlockLength;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BiquadCoefficients.h"
+
+/**
+ * CascadedBiquad - A whole EQ chain (tone stack, DC blocker, ...) in one pass
+ *
+ * Replaces a row of ProcessorDuplicator<IIR::Filter> objects, which each walk
+ * the whole buffer once. Here every section runs back-to-back on a sample
+ * while it's still in a register, and channels are packed into the lanes of
+ * a SIMD register (a stereo pair shares one register).
+ *
+ * Each section is described by its design (type, frequency, Q, gain).
+ * A section is only redesigned when its description changes, the new
+ * coefficients are computed without touching the heap, and they glide in
+ * over a few 32-sample sub-blocks so automation doesn't click. The
+ * sub-blocks are counted in samples since reset(), not from the start of
+ * each process() call, so the ramp is the same whatever the block sizes.
+ */
+class CascadedBiquad
+{
+public:
+    enum class SectionType
+    {
+        Bypass,
+        LowShelf,
+        HighShelf,
+        Peak,
+        HighPass
+    };
+
+    static constexpr int maxSections = 8;
+    static constexpr int maxChannels = 8;
+    static constexpr int subBlockSize = 32;  // Samples per coefficient interpolation step
+
+    CascadedBiquad();
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    // Describe a section. Cheap to call every block - the redesign happens
+    // in process(), and only when something actually changed.
+    void setSection(int index, SectionType type, double frequency,
+                    double q = 1.0 / juce::MathConstants<double>::sqrt2, float gainDb = 0.0f);
+
+    // How long new coefficients take to glide in (default 5ms)
+    void setRampTime(double seconds);
+
+    void process(juce::dsp::AudioBlock<float>& block);
+
+private:
+    struct SectionDesign
+    {
+        SectionType type = SectionType::Bypass;
+        double frequency = 1000.0;
+        double q = 1.0 / juce::MathConstants<double>::sqrt2;
+        float gainDb = 0.0f;
+
+        bool operator==(const SectionDesign& other) const
+        {
+            return type == other.type && frequency == other.frequency
+                && q == other.q && gainDb == other.gainDb;
+        }
+    };
+
+    struct Section
+    {
+        SectionDesign design;
+        bool needsRedesign = true;
+
+        BiquadCoefficients current;
+        BiquadCoefficients target;
+        BiquadCoefficients rampStart;
+        int rampSubBlocksRemaining = 0;
+    };
+
+    double currentSampleRate = 44100.0;
+    double rampTimeSeconds = 0.005;
+    int rampLengthSubBlocks = 1;
+    int numActiveSections = 0;
+    int numPreparedChannels = 0;
+    int samplesUntilRampStep = 0;   // Carries the sub-block grid across process() calls
+
+    std::array<Section, maxSections> sections;
+
+    // Filter memory laid out as [channel group][section][s1, s2][SIMD lane]
+    alignas(32) std::array<float, maxChannels * maxSections * 2> filterState {};
+
+    BiquadCoefficients design(const SectionDesign& sectionDesign) const;
+    void updateCoefficients();
+    void advanceRamps();
+};
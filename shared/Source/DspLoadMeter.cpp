@@ -0,0 +1,94 @@
+#include "DspLoadMeter.h"
+
+DspLoadMeter::DspLoadMeter(DspLoadMonitor& monitorToUse)
+    : monitor(monitorToUse)
+{
+    setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    startTimerHz(15);
+}
+
+void DspLoadMeter::setAccentColour(juce::Colour newColour)
+{
+    accentColour = newColour;
+    repaint();
+}
+
+void DspLoadMeter::timerCallback()
+{
+    monitor.update();
+
+    const float newLoad = monitor.getCurrentLoad();
+    const auto newStatistics = monitor.getStatistics(-1);
+
+    if (newLoad == load && newStatistics.p99 == blockStatistics.p99 && newStatistics.max == blockStatistics.max)
+        return;
+
+    load = newLoad;
+    blockStatistics = newStatistics;
+    repaint();
+}
+
+void DspLoadMeter::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat().reduced(0.5f);
+
+    g.setColour(juce::Colours::black.withAlpha(0.5f));
+    g.fillRoundedRectangle(bounds, 3.0f);
+
+    // Over half the deadline leaves little headroom for the host; over all of it drops out
+    const juce::Colour barColour = load < 0.5f ? accentColour
+                                 : load < 1.0f ? juce::Colours::orange
+                                               : juce::Colours::red;
+
+    g.setColour(barColour.withAlpha(0.6f));
+    g.fillRoundedRectangle(bounds.withWidth(bounds.getWidth() * juce::jlimit(0.0f, 1.0f, load)), 3.0f);
+
+    // p99 and max of whole blocks since the last reset
+    const auto drawTick = [&](float value, float alpha)
+    {
+        if (value <= 0.0f)
+            return;
+
+        const float x = bounds.getX() + bounds.getWidth() * juce::jmin(1.0f, value);
+        g.setColour(juce::Colours::white.withAlpha(alpha));
+        g.drawVerticalLine(juce::roundToInt(x), bounds.getY(), bounds.getBottom());
+    };
+
+    drawTick(blockStatistics.p99, 0.8f);
+    drawTick(blockStatistics.max, 0.4f);
+
+    g.setColour(juce::Colours::white.withAlpha(0.35f));
+    g.drawRoundedRectangle(bounds, 3.0f, 1.0f);
+
+    g.setColour(juce::Colours::white);
+    g.setFont(10.0f);
+    g.drawText("DSP " + juce::String(juce::roundToInt(load * 100.0f)) + "%",
+               getLocalBounds(), juce::Justification::centred);
+}
+
+void DspLoadMeter::mouseDown(const juce::MouseEvent&)
+{
+    juce::PopupMenu menu;
+    menu.addSectionHeader("p99 " + juce::String(blockStatistics.p99 * 100.0f, 1)
+                          + "%, max " + juce::String(blockStatistics.max * 100.0f, 1) + "% of deadline");
+    menu.addItem(1, "Copy load report");
+    menu.addItem(2, "Reset statistics");
+
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this),
+                       [safeThis = juce::Component::SafePointer<DspLoadMeter>(this)](int result)
+                       {
+                           if (safeThis == nullptr)
+                               return;
+
+                           if (result == 1)
+                           {
+                               juce::SystemClipboard::copyTextToClipboard(safeThis->monitor.createReport());
+                           }
+                           else if (result == 2)
+                           {
+                               safeThis->monitor.resetStatistics();
+                               safeThis->blockStatistics = {};
+                               safeThis->repaint();
+                           }
+                       });
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <JuceHeader.h>
+#include "DspLoadMonitor.h"
+
+/**
+ * DspLoadMeter - Compact DSP load bar for plugin editors
+ *
+ * Polls a DspLoadMonitor from the message thread and draws the smoothed
+ * load as a bar with "DSP xx%", plus tick marks at the p99 and max seen so
+ * far. Clicking opens a menu to copy the full p50/p99/max report to the
+ * clipboard or reset the statistics.
+ */
+class DspLoadMeter : public juce::Component,
+                     private juce::Timer
+{
+public:
+    explicit DspLoadMeter(DspLoadMonitor& monitorToUse);
+
+    void setAccentColour(juce::Colour newColour);
+
+    void paint(juce::Graphics&) override;
+    void mouseDown(const juce::MouseEvent&) override;
+
+private:
+    void timerCallback() override;
+
+    DspLoadMonitor& monitor;
+
+    float load = 0.0f;
+    DspLoadMonitor::Statistics blockStatistics;
+
+    juce::Colour accentColour = juce::Colours::limegreen;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadMeter)
+};
@@ -0,0 +1,188 @@
+#include "DspLoadMonitor.h"
+
+DspLoadMonitor::DspLoadMonitor(const juce::StringArray& stageNamesToUse)
+    : stageNames(stageNamesToUse),
+      ticksPerSecond(static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()))
+{
+    jassert(stageNames.size() <= maxStages);
+}
+
+void DspLoadMonitor::prepare(double sampleRate)
+{
+    // The message thread may be reading, so leave the clearing to update()
+    currentSampleRate.store(sampleRate);
+    resetPending.store(true);
+}
+
+void DspLoadMonitor::beginBlock(int numSamples)
+{
+    currentBlock.numSamples = numSamples;
+    currentBlock.stageTicks.fill(0);
+
+    blockStartTicks = juce::Time::getHighResolutionTicks();
+    lastMarkTicks = blockStartTicks;
+}
+
+void DspLoadMonitor::markStage(int stageIndex)
+{
+    const auto now = juce::Time::getHighResolutionTicks();
+
+    if (juce::isPositiveAndBelow(stageIndex, maxStages))
+        currentBlock.stageTicks[static_cast<size_t>(stageIndex)] += now - lastMarkTicks;
+
+    lastMarkTicks = now;
+}
+
+void DspLoadMonitor::endBlock()
+{
+    currentBlock.totalTicks = juce::Time::getHighResolutionTicks() - blockStartTicks;
+
+    const auto write = writePosition.load(std::memory_order_relaxed);
+
+    if (write - readPosition.load(std::memory_order_acquire) >= static_cast<juce::uint32>(ringSize))
+    {
+        droppedBlocks.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring[write & ringMask] = currentBlock;
+    writePosition.store(write + 1, std::memory_order_release);
+}
+
+void DspLoadMonitor::update()
+{
+    const auto write = writePosition.load(std::memory_order_acquire);
+    auto read = readPosition.load(std::memory_order_relaxed);
+
+    // After a prepare, drop timings from the old configuration along with the statistics
+    if (resetPending.exchange(false))
+    {
+        resetStatistics();
+        read = write;
+    }
+
+    const double sampleRate = currentSampleRate.load();
+
+    for (; read != write; ++read)
+    {
+        const auto& block = ring[read & ringMask];
+
+        if (block.numSamples <= 0)
+            continue;
+
+        const double deadlineTicks = block.numSamples / sampleRate * ticksPerSecond;
+        const float load = static_cast<float>(block.totalTicks / deadlineTicks);
+
+        addToHistogram(0, load);
+
+        for (int stage = 0; stage < stageNames.size(); ++stage)
+            addToHistogram(stage + 1, static_cast<float>(block.stageTicks[static_cast<size_t>(stage)] / deadlineTicks));
+
+        // Meter ballistics: jump up, fall back gently
+        currentLoad = load > currentLoad ? load : currentLoad + 0.05f * (load - currentLoad);
+    }
+
+    readPosition.store(read, std::memory_order_release);
+}
+
+void DspLoadMonitor::resetStatistics()
+{
+    for (auto& histogram : histograms)
+        histogram.fill(0);
+
+    maxLoads.fill(0.0f);
+    blockCounts.fill(0);
+    currentLoad = 0.0f;
+    droppedBlocks.store(0);
+}
+
+void DspLoadMonitor::addToHistogram(int histogramIndex, float load)
+{
+    const int bin = juce::jlimit(0, numHistogramBins - 1, static_cast<int>(load * 100.0f));
+
+    ++histograms[static_cast<size_t>(histogramIndex)][static_cast<size_t>(bin)];
+    ++blockCounts[static_cast<size_t>(histogramIndex)];
+    maxLoads[static_cast<size_t>(histogramIndex)] = juce::jmax(maxLoads[static_cast<size_t>(histogramIndex)], load);
+}
+
+DspLoadMonitor::Statistics DspLoadMonitor::getStatistics(int stageIndex) const
+{
+    const auto index = static_cast<size_t>(stageIndex + 1);
+    jassert(index < histograms.size());
+
+    Statistics statistics;
+    statistics.numBlocks = blockCounts[index];
+    statistics.max = maxLoads[index];
+
+    if (statistics.numBlocks == 0)
+        return statistics;
+
+    // Percentiles to bin resolution (1% of the deadline), reported at the bin's upper edge
+    const auto& histogram = histograms[index];
+    const auto p50Count = (statistics.numBlocks + 1) / 2;
+    const auto p99Count = statistics.numBlocks - statistics.numBlocks / 100;
+    juce::uint64 count = 0;
+    bool foundP50 = false;
+
+    for (int bin = 0; bin < numHistogramBins; ++bin)
+    {
+        count += histogram[static_cast<size_t>(bin)];
+        const float upperEdge = juce::jmin(statistics.max, static_cast<float>(bin + 1) * 0.01f);
+
+        if (!foundP50 && count >= p50Count)
+        {
+            statistics.p50 = upperEdge;
+            foundP50 = true;
+        }
+
+        if (count >= p99Count)
+        {
+            statistics.p99 = upperEdge;
+            break;
+        }
+    }
+
+    return statistics;
+}
+
+juce::String DspLoadMonitor::createReport()
+{
+    update();
+
+    const auto percent = [](float load) { return (juce::String(load * 100.0f, 1) + "%").paddedLeft(' ', 9); };
+
+    juce::String report;
+    report << "DSP load relative to the block deadline ("
+           << juce::String(currentSampleRate.load(), 0) << " Hz)\n\n"
+           << juce::String("Stage").paddedRight(' ', 16)
+           << juce::String("p50").paddedLeft(' ', 9)
+           << juce::String("p99").paddedLeft(' ', 9)
+           << juce::String("max").paddedLeft(' ', 9)
+           << juce::String("blocks").paddedLeft(' ', 12) << "\n";
+
+    for (int stage = -1; stage < getNumStages(); ++stage)
+    {
+        const auto statistics = getStatistics(stage);
+
+        report << (stage < 0 ? juce::String("Whole block") : getStageName(stage)).paddedRight(' ', 16)
+               << percent(statistics.p50) << percent(statistics.p99) << percent(statistics.max)
+               << juce::String(static_cast<juce::int64>(statistics.numBlocks)).paddedLeft(' ', 12) << "\n";
+    }
+
+    report << "\nDropped (reader fell behind): " << static_cast<int>(getNumDroppedBlocks()) << " blocks\n"
+           << "\nWhole-block histogram:\n";
+
+    const auto& histogram = histograms[0];
+
+    for (int bin = 0; bin < numHistogramBins; ++bin)
+    {
+        if (histogram[static_cast<size_t>(bin)] == 0)
+            continue;
+
+        report << juce::String(bin).paddedLeft(' ', 4)
+               << (bin == numHistogramBins - 1 ? "%+ " : "%   ")
+               << static_cast<int>(histogram[static_cast<size_t>(bin)]) << "\n";
+    }
+
+    return report;
+}
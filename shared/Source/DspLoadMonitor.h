@@ -0,0 +1,108 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * DspLoadMonitor - Per-block and per-stage CPU load, measured on the audio thread
+ *
+ * The audio thread brackets each block with beginBlock()/endBlock() (or a
+ * ScopedBlock) and calls markStage() after each stage of its chain; the
+ * time since the previous mark is charged to that stage. A finished block's
+ * timings go into a single-producer/single-consumer ring, so the audio
+ * thread never locks or allocates - if the reader falls behind, blocks are
+ * dropped and counted.
+ *
+ * The message thread drains the ring with update() into load histograms,
+ * where load is time taken divided by the block's deadline (its length in
+ * real time). From those come the meter value and a p50/p99/max report per
+ * stage.
+ */
+class DspLoadMonitor
+{
+public:
+    static constexpr int maxStages = 8;
+
+    explicit DspLoadMonitor(const juce::StringArray& stageNames);
+
+    // Called from prepareToPlay; statistics are cleared on the next update()
+    void prepare(double sampleRate);
+
+    //==============================================================================
+    // Audio thread
+    void beginBlock(int numSamples);
+    void markStage(int stageIndex);
+    void endBlock();
+
+    struct ScopedBlock
+    {
+        ScopedBlock(DspLoadMonitor& monitorToUse, int numSamples) : monitor(monitorToUse) { monitor.beginBlock(numSamples); }
+        ~ScopedBlock() { monitor.endBlock(); }
+
+        DspLoadMonitor& monitor;
+    };
+
+    //==============================================================================
+    // Message thread
+    void update();
+    void resetStatistics();
+
+    int getNumStages() const { return stageNames.size(); }
+    const juce::String& getStageName(int stageIndex) const { return stageNames.getReference(stageIndex); }
+
+    // Smoothed load of whole blocks (1.0 = the full deadline)
+    float getCurrentLoad() const { return currentLoad; }
+
+    struct Statistics
+    {
+        float p50 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+        juce::uint64 numBlocks = 0;
+    };
+
+    // stageIndex -1 is the whole block
+    Statistics getStatistics(int stageIndex) const;
+
+    juce::uint32 getNumDroppedBlocks() const { return droppedBlocks.load(std::memory_order_relaxed); }
+
+    // Drains the ring and formats a p50/p99/max table plus the whole-block histogram
+    juce::String createReport();
+
+private:
+    struct BlockTiming
+    {
+        int numSamples = 0;
+        juce::int64 totalTicks = 0;
+        std::array<juce::int64, maxStages> stageTicks {};
+    };
+
+    // Load histogram with 1% bins; the last bin collects everything above
+    static constexpr int numHistogramBins = 400;
+    using Histogram = std::array<juce::uint32, numHistogramBins>;
+
+    static constexpr int ringSize = 1024;  // Power of two
+    static constexpr int ringMask = ringSize - 1;
+
+    const juce::StringArray stageNames;
+    const double ticksPerSecond;
+    std::atomic<double> currentSampleRate { 44100.0 };
+    std::atomic<bool> resetPending { false };
+
+    // Audio thread state
+    BlockTiming currentBlock;
+    juce::int64 blockStartTicks = 0;
+    juce::int64 lastMarkTicks = 0;
+
+    // Ring of finished blocks
+    std::array<BlockTiming, ringSize> ring;
+    std::atomic<juce::uint32> writePosition { 0 };
+    std::atomic<juce::uint32> readPosition { 0 };
+    std::atomic<juce::uint32> droppedBlocks { 0 };
+
+    // Message thread state - index 0 is the whole block, stages follow
+    std::array<Histogram, maxStages + 1> histograms {};
+    std::array<float, maxStages + 1> maxLoads {};
+    std::array<juce::uint64, maxStages + 1> blockCounts {};
+    float currentLoad = 0.0f;
+
+    void addToHistogram(int histogramIndex, float load);
+};
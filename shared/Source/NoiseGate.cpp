@@ -0,0 +1,266 @@
+#include "NoiseGate.h"
+
+namespace
+{
+    constexpr double detectorReleaseSeconds = 0.01;  // Peak detector fall time
+    constexpr double rmsWindowSeconds = 0.01;        // RMS averaging time
+}
+
+NoiseGate::NoiseGate()
+{
+    updateTimeConstants();
+}
+
+void NoiseGate::prepare(double sampleRate, int maximumBlockSize, int numChannels)
+{
+    juce::ignoreUnused(maximumBlockSize);
+
+    currentSampleRate = sampleRate;
+    numPreparedChannels = numChannels;
+
+    // Room for the longest lookahead plus one sub-block written ahead of the read point
+    const int maxLookaheadSamples = static_cast<int>(std::ceil(maxLookaheadMs * 0.001 * sampleRate));
+    const int delaySize = juce::nextPowerOfTwo(maxLookaheadSamples + detectionBlockSize + 1);
+
+    delayBuffer.setSize(numChannels, delaySize);
+    delayMask = delaySize - 1;
+
+    updateTimeConstants();
+    reset();
+}
+
+void NoiseGate::reset()
+{
+    state = GateState::Closed;
+    peakEnvelope = 0.0f;
+    meanSquare = 0.0f;
+    holdRemaining = 0;
+    currentGain = 0.0f;
+
+    delayBuffer.clear();
+    delayWriteIndex = 0;
+
+    keyLevelDb.store(-100.0f);
+    gainReductionDb.store(-100.0f);
+    gateOpen.store(false);
+}
+
+// Parameter setters
+void NoiseGate::setThreshold(float thresholdDb)
+{
+    threshold = juce::jlimit(-60.0f, 0.0f, thresholdDb);
+}
+
+void NoiseGate::setAttack(float attackMs)
+{
+    const float newAttack = juce::jlimit(0.1f, 50.0f, attackMs);
+
+    if (newAttack != attackTime)
+    {
+        attackTime = newAttack;
+        updateTimeConstants();
+    }
+}
+
+void NoiseGate::setRelease(float releaseMs)
+{
+    const float newRelease = juce::jlimit(10.0f, 2000.0f, releaseMs);
+
+    if (newRelease != releaseTime)
+    {
+        releaseTime = newRelease;
+        updateTimeConstants();
+    }
+}
+
+void NoiseGate::setHold(float holdMs)
+{
+    holdTime = juce::jlimit(0.0f, 500.0f, holdMs);
+    holdSamples = juce::roundToInt(holdTime * 0.001 * currentSampleRate);
+}
+
+void NoiseGate::setHysteresis(float hysteresisDb)
+{
+    hysteresis = juce::jlimit(0.0f, 12.0f, hysteresisDb);
+}
+
+void NoiseGate::setDetectionMode(DetectionMode mode)
+{
+    detectionMode = mode;
+}
+
+void NoiseGate::setLookahead(float lookaheadMs)
+{
+    lookaheadTime = juce::jlimit(0.0f, static_cast<float>(maxLookaheadMs), lookaheadMs);
+    lookaheadSamples = juce::roundToInt(lookaheadTime * 0.001 * currentSampleRate);
+}
+
+void NoiseGate::updateTimeConstants()
+{
+    // One-pole smoothing toward a constant target: after n samples the remaining
+    // distance is coeff^n, so a whole sub-block's gain curve can be precomputed
+    const double attackCoeff = std::exp(-1.0 / (attackTime * 0.001 * currentSampleRate));
+    const double releaseCoeff = std::exp(-1.0 / (releaseTime * 0.001 * currentSampleRate));
+
+    for (int i = 0; i < detectionBlockSize; ++i)
+    {
+        attackCurve[static_cast<size_t>(i)] = static_cast<float>(std::pow(attackCoeff, i + 1));
+        releaseCurve[static_cast<size_t>(i)] = static_cast<float>(std::pow(releaseCoeff, i + 1));
+    }
+
+    peakDecayPerBlock = static_cast<float>(std::exp(-detectionBlockSize / (detectorReleaseSeconds * currentSampleRate)));
+    rmsSmoothingPerBlock = static_cast<float>(1.0 - std::exp(-detectionBlockSize / (rmsWindowSeconds * currentSampleRate)));
+
+    holdSamples = juce::roundToInt(holdTime * 0.001 * currentSampleRate);
+    lookaheadSamples = juce::roundToInt(lookaheadTime * 0.001 * currentSampleRate);
+}
+
+void NoiseGate::process(juce::dsp::AudioBlock<float>& block)
+{
+    processInternal(block, juce::dsp::AudioBlock<const float>(block));
+}
+
+void NoiseGate::process(juce::dsp::AudioBlock<float>& block, const juce::dsp::AudioBlock<const float>& sidechain)
+{
+    // An unconnected sidechain falls back to keying from the input
+    if (sidechain.getNumChannels() == 0 || sidechain.getNumSamples() < block.getNumSamples())
+        processInternal(block, juce::dsp::AudioBlock<const float>(block));
+    else
+        processInternal(block, sidechain);
+}
+
+void NoiseGate::processInternal(juce::dsp::AudioBlock<float>& block, const juce::dsp::AudioBlock<const float>& key)
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), numPreparedChannels);
+    float levelDb = -100.0f;
+
+    for (int start = 0; start < numSamples; start += detectionBlockSize)
+    {
+        const int length = juce::jmin(detectionBlockSize, numSamples - start);
+
+        // Detect on the undelayed key, once per sub-block
+        levelDb = juce::Decibels::gainToDecibels(measureKey(key, start, length));
+        updateState(levelDb, length);
+
+        // Gain curve for this sub-block: target + (current - target) * coeff^(n+1)
+        const float target = state != GateState::Closed ? 1.0f : 0.0f;
+        const auto& curve = target > currentGain ? attackCurve : releaseCurve;
+
+        juce::FloatVectorOperations::copyWithMultiply(gainCurve.data(), curve.data(), currentGain - target, length);
+        juce::FloatVectorOperations::add(gainCurve.data(), target, length);
+        currentGain = gainCurve[static_cast<size_t>(length - 1)];
+
+        if (lookaheadSamples > 0)
+            delayAudio(block, start, length);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::multiply(block.getChannelPointer(static_cast<size_t>(channel)) + start,
+                                                  gainCurve.data(), length);
+    }
+
+    keyLevelDb.store(levelDb, std::memory_order_relaxed);
+    gainReductionDb.store(juce::Decibels::gainToDecibels(currentGain), std::memory_order_relaxed);
+    gateOpen.store(state != GateState::Closed, std::memory_order_relaxed);
+}
+
+float NoiseGate::measureKey(const juce::dsp::AudioBlock<const float>& key, int start, int length)
+{
+    const int numKeyChannels = static_cast<int>(key.getNumChannels());
+
+    if (detectionMode == DetectionMode::Peak)
+    {
+        // Loudest sample across all key channels
+        float blockPeak = 0.0f;
+
+        for (int channel = 0; channel < numKeyChannels; ++channel)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(key.getChannelPointer(static_cast<size_t>(channel)) + start, length);
+            blockPeak = juce::jmax(blockPeak, -range.getStart(), range.getEnd());
+        }
+
+        peakEnvelope = juce::jmax(blockPeak, peakEnvelope * peakDecayPerBlock);
+        return peakEnvelope;
+    }
+
+    // RMS: loudest channel's mean square, smoothed over the RMS window
+    float blockMeanSquare = 0.0f;
+
+    for (int channel = 0; channel < numKeyChannels; ++channel)
+    {
+        const float* data = key.getChannelPointer(static_cast<size_t>(channel)) + start;
+        float sums[4] = {};
+
+        // Independent partial sums so the loop isn't one long dependency chain
+        int i = 0;
+        for (; i + 4 <= length; i += 4)
+            for (int lane = 0; lane < 4; ++lane)
+                sums[lane] += data[i + lane] * data[i + lane];
+
+        for (; i < length; ++i)
+            sums[0] += data[i] * data[i];
+
+        const float meanSquareForChannel = (sums[0] + sums[1] + sums[2] + sums[3]) / static_cast<float>(length);
+        blockMeanSquare = juce::jmax(blockMeanSquare, meanSquareForChannel);
+    }
+
+    meanSquare += (blockMeanSquare - meanSquare) * rmsSmoothingPerBlock;
+    return std::sqrt(meanSquare);
+}
+
+void NoiseGate::updateState(float levelDb, int length)
+{
+    // Opens at the threshold, closes at threshold - hysteresis after the hold time
+    switch (state)
+    {
+        case GateState::Closed:
+            if (levelDb > threshold)
+                state = GateState::Open;
+            break;
+
+        case GateState::Open:
+            if (levelDb < threshold - hysteresis)
+            {
+                state = GateState::Holding;
+                holdRemaining = holdSamples;
+            }
+            break;
+
+        case GateState::Holding:
+            if (levelDb > threshold)
+            {
+                state = GateState::Open;
+                break;
+            }
+
+            holdRemaining -= length;
+            if (holdRemaining <= 0)
+                state = GateState::Closed;
+            break;
+    }
+}
+
+void NoiseGate::delayAudio(juce::dsp::AudioBlock<float>& block, int start, int length)
+{
+    const int delaySize = delayMask + 1;
+    const int readIndex = (delayWriteIndex - lookaheadSamples) & delayMask;
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), numPreparedChannels);
+
+    // Write first, then read - with short lookaheads the read overlaps what was just written
+    const int firstWrite = juce::jmin(length, delaySize - delayWriteIndex);
+    const int firstRead = juce::jmin(length, delaySize - readIndex);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* data = block.getChannelPointer(static_cast<size_t>(channel)) + start;
+        float* ring = delayBuffer.getWritePointer(channel);
+
+        juce::FloatVectorOperations::copy(ring + delayWriteIndex, data, firstWrite);
+        juce::FloatVectorOperations::copy(ring, data + firstWrite, length - firstWrite);
+
+        juce::FloatVectorOperations::copy(data, ring + readIndex, firstRead);
+        juce::FloatVectorOperations::copy(data + firstRead, ring, length - firstRead);
+    }
+
+    delayWriteIndex = (delayWriteIndex + length) & delayMask;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * NoiseGate - Threshold gate with hold, hysteresis and optional lookahead
+ *
+ * Detection runs on 16-sample sub-blocks: the key signal (the input, or a
+ * sidechain) is reduced to one peak or RMS level per sub-block, and the
+ * open/hold/closed state machine steps once per sub-block. Within a
+ * sub-block the attack/release curve has a closed form (the one-pole
+ * response to a constant target), so the per-sample work is plain vector
+ * arithmetic with no branches.
+ *
+ * Lookahead delays the audio (not the key) through a preallocated ring
+ * buffer so the gate is already open when a transient arrives. The delay
+ * is reported through getLatencySamples().
+ *
+ * All channels share one gain (linked detection on the loudest channel).
+ */
+class NoiseGate
+{
+public:
+    enum class DetectionMode
+    {
+        Peak,
+        RMS
+    };
+
+    static constexpr int detectionBlockSize = 16;
+    static constexpr double maxLookaheadMs = 10.0;
+
+    NoiseGate();
+
+    // Allocates the lookahead buffer - not real-time safe
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels);
+    void reset();
+
+    // Parameter setters (real-time safe)
+    void setThreshold(float thresholdDb);       // -60dB to 0dB
+    void setAttack(float attackMs);             // 0.1ms to 50ms
+    void setRelease(float releaseMs);           // 10ms to 2000ms
+    void setHold(float holdMs);                 // 0ms to 500ms
+    void setHysteresis(float hysteresisDb);     // 0dB to 12dB
+    void setDetectionMode(DetectionMode mode);
+    void setLookahead(float lookaheadMs);       // 0ms to maxLookaheadMs
+
+    // Gate the block in place, keyed from itself or from a sidechain block
+    void process(juce::dsp::AudioBlock<float>& block);
+    void process(juce::dsp::AudioBlock<float>& block, const juce::dsp::AudioBlock<const float>& sidechain);
+
+    int getLatencySamples() const { return lookaheadSamples; }
+
+    // Metering (safe to read from the message thread)
+    float getKeyLevelDb() const { return keyLevelDb.load(std::memory_order_relaxed); }
+    float getGainReductionDb() const { return gainReductionDb.load(std::memory_order_relaxed); }
+    bool isGateOpen() const { return gateOpen.load(std::memory_order_relaxed); }
+
+private:
+    enum class GateState
+    {
+        Closed,
+        Open,
+        Holding
+    };
+
+    double currentSampleRate = 44100.0;
+    int numPreparedChannels = 0;
+
+    // Parameters
+    float threshold = -40.0f;
+    float attackTime = 0.5f;
+    float releaseTime = 100.0f;
+    float holdTime = 50.0f;
+    float hysteresis = 3.0f;
+    float lookaheadTime = 0.0f;
+    DetectionMode detectionMode = DetectionMode::Peak;
+
+    // Derived from the parameters
+    int holdSamples = 0;
+    int lookaheadSamples = 0;
+    float peakDecayPerBlock = 0.0f;
+    float rmsSmoothingPerBlock = 0.0f;
+    std::array<float, detectionBlockSize> attackCurve {};   // Remaining distance to target after n+1 samples
+    std::array<float, detectionBlockSize> releaseCurve {};
+
+    // Detector and gate state
+    GateState state = GateState::Closed;
+    float peakEnvelope = 0.0f;
+    float meanSquare = 0.0f;
+    int holdRemaining = 0;
+    float currentGain = 0.0f;
+
+    // Lookahead ring buffer, [channel][position], power-of-two length
+    juce::AudioBuffer<float> delayBuffer;
+    int delayMask = 0;
+    int delayWriteIndex = 0;
+
+    std::array<float, detectionBlockSize> gainCurve {};
+
+    std::atomic<float> keyLevelDb { -100.0f };
+    std::atomic<float> gainReductionDb { 0.0f };
+    std::atomic<bool> gateOpen { false };
+
+    void updateTimeConstants();
+    void processInternal(juce::dsp::AudioBlock<float>& block, const juce::dsp::AudioBlock<const float>& key);
+    float measureKey(const juce::dsp::AudioBlock<const float>& key, int start, int length);
+    void updateState(float levelDb, int length);
+    void delayAudio(juce::dsp::AudioBlock<float>& block, int start, int length);
+};
@@ -0,0 +1,409 @@
+#include "PartitionedConvolver.h"
+
+namespace
+{
+    // Plain complex multiply-accumulate. std::complex operator* goes through the
+    // NaN/inf-safe library path without fast-math, which is far too slow here.
+    inline void multiplyAccumulate(std::complex<float>* accumulator, const std::complex<float>* a,
+                                   const std::complex<float>* b, int numBins)
+    {
+        auto* acc = reinterpret_cast<float*>(accumulator);
+        const auto* x = reinterpret_cast<const float*>(a);
+        const auto* h = reinterpret_cast<const float*>(b);
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const int re = bin * 2;
+            const int im = re + 1;
+            acc[re] += x[re] * h[re] - x[im] * h[im];
+            acc[im] += x[re] * h[im] + x[im] * h[re];
+        }
+    }
+}
+
+//==============================================================================
+class PartitionedConvolver::TailWorker : public juce::Thread
+{
+public:
+    explicit TailWorker(PartitionedConvolver& ownerToUse)
+        : juce::Thread("Convolution tail"),
+          owner(ownerToUse)
+    {
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            // Polled rather than woken: notify() takes a lock, which the audio
+            // thread mustn't, and a job has a whole long block to run in
+            wait(1);
+
+            // Everything published so far, oldest first
+            auto completed = owner.jobsCompleted.load(std::memory_order_relaxed);
+
+            while (completed != owner.jobsSubmitted.load(std::memory_order_acquire) && !threadShouldExit())
+            {
+                owner.runTailJob(owner.tailJobs[completed % numTailJobs]);
+                owner.jobsCompleted.store(++completed, std::memory_order_release);
+            }
+        }
+    }
+
+private:
+    PartitionedConvolver& owner;
+};
+
+//==============================================================================
+void PartitionedConvolver::Segment::prepare(const juce::AudioBuffer<float>& impulseResponse, int firstTap, int lastTap,
+                                            int blockSizeToUse, int numChannels)
+{
+    blockSize = blockSizeToUse;
+    numPartitions = (lastTap - firstTap + blockSize - 1) / blockSize;
+
+    const int fftSize = blockSize * 2;
+    const int numBins = blockSize + 1;
+    fft = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(static_cast<double>(fftSize))));
+
+    // Transform every partition of every IR channel once, up front
+    std::vector<float> buffer(static_cast<size_t>(fftSize * 2));
+    filterSpectra.assign(static_cast<size_t>(impulseResponse.getNumChannels()), {});
+
+    for (int irChannel = 0; irChannel < impulseResponse.getNumChannels(); ++irChannel)
+    {
+        const float* taps = impulseResponse.getReadPointer(irChannel);
+        auto& spectra = filterSpectra[static_cast<size_t>(irChannel)];
+        spectra.assign(static_cast<size_t>(numPartitions), Spectrum(static_cast<size_t>(numBins)));
+
+        for (int partition = 0; partition < numPartitions; ++partition)
+        {
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+
+            const int start = firstTap + partition * blockSize;
+            const int count = juce::jmin(blockSize, lastTap - start);
+            std::copy(taps + start, taps + start + count, buffer.begin());
+
+            fft->performRealOnlyForwardTransform(buffer.data(), true);
+
+            const auto* bins = reinterpret_cast<const std::complex<float>*>(buffer.data());
+            std::copy(bins, bins + numBins, spectra[static_cast<size_t>(partition)].begin());
+        }
+    }
+
+    channels.resize(static_cast<size_t>(numChannels));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto& state = channels[static_cast<size_t>(channel)];
+        state.inputWindow.assign(static_cast<size_t>(fftSize), 0.0f);
+        state.delayLine.assign(static_cast<size_t>(numPartitions), Spectrum(static_cast<size_t>(numBins)));
+        state.fftBuffer.assign(static_cast<size_t>(fftSize * 2), 0.0f);
+        state.output.assign(static_cast<size_t>(blockSize), 0.0f);
+        state.filterChannel = juce::jmin(channel, impulseResponse.getNumChannels() - 1);
+    }
+
+    delayLineIndex = 0;
+}
+
+void PartitionedConvolver::Segment::reset()
+{
+    for (auto& state : channels)
+    {
+        std::fill(state.inputWindow.begin(), state.inputWindow.end(), 0.0f);
+        std::fill(state.output.begin(), state.output.end(), 0.0f);
+
+        for (auto& spectrum : state.delayLine)
+            std::fill(spectrum.begin(), spectrum.end(), std::complex<float>());
+    }
+
+    delayLineIndex = 0;
+}
+
+void PartitionedConvolver::Segment::processBlock(int channel, const float* newInput)
+{
+    auto& state = channels[static_cast<size_t>(channel)];
+    const int fftSize = blockSize * 2;
+    const int numBins = blockSize + 1;
+
+    // Slide the overlap-save window along by one block
+    std::copy(state.inputWindow.begin() + blockSize, state.inputWindow.end(), state.inputWindow.begin());
+    std::copy(newInput, newInput + blockSize, state.inputWindow.begin() + blockSize);
+
+    // Transform it into the frequency-domain delay line
+    std::copy(state.inputWindow.begin(), state.inputWindow.end(), state.fftBuffer.begin());
+    std::fill(state.fftBuffer.begin() + fftSize, state.fftBuffer.end(), 0.0f);
+    fft->performRealOnlyForwardTransform(state.fftBuffer.data(), true);
+
+    auto* bins = reinterpret_cast<std::complex<float>*>(state.fftBuffer.data());
+    auto& newest = state.delayLine[static_cast<size_t>(delayLineIndex)];
+    std::copy(bins, bins + numBins, newest.begin());
+
+    // Sum every partition against the matching past input
+    std::fill(bins, bins + fftSize, std::complex<float>());
+    const auto& spectra = filterSpectra[static_cast<size_t>(state.filterChannel)];
+
+    for (int partition = 0; partition < numPartitions; ++partition)
+    {
+        const int index = (delayLineIndex - partition + numPartitions) % numPartitions;
+        multiplyAccumulate(bins, state.delayLine[static_cast<size_t>(index)].data(),
+                           spectra[static_cast<size_t>(partition)].data(), numBins);
+    }
+
+    // Real signal - fill in the negative frequencies before going back
+    for (int bin = 1; bin < blockSize; ++bin)
+        bins[fftSize - bin] = std::conj(bins[bin]);
+
+    fft->performRealOnlyInverseTransform(state.fftBuffer.data());
+
+    // The second half of the window is the part free of circular wrap-around
+    std::copy(state.fftBuffer.begin() + blockSize, state.fftBuffer.begin() + fftSize, state.output.begin());
+}
+
+void PartitionedConvolver::Segment::advance()
+{
+    delayLineIndex = (delayLineIndex + 1) % numPartitions;
+}
+
+//==============================================================================
+float PartitionedConvolver::Head::processSample(int channel, float input)
+{
+    auto& buffer = history[static_cast<size_t>(channel)];
+    int& index = writeIndex[static_cast<size_t>(channel)];
+
+    // Every sample is written twice so the newest `length` are always contiguous
+    buffer[static_cast<size_t>(index)] = input;
+    buffer[static_cast<size_t>(index + length)] = input;
+
+    const float* window = buffer.data() + index + 1;
+    const float* reversedTaps = taps[static_cast<size_t>(filterChannel[static_cast<size_t>(channel)])].data();
+
+    float sum = 0.0f;
+    for (int tap = 0; tap < length; ++tap)
+        sum += reversedTaps[tap] * window[tap];
+
+    index = (index + 1) % length;
+    return sum;
+}
+
+//==============================================================================
+PartitionedConvolver::PartitionedConvolver(const juce::AudioBuffer<float>& impulseResponse, int numChannelsToUse)
+    : numChannels(juce::jmax(1, numChannelsToUse)),
+      impulseLength(impulseResponse.getNumSamples())
+{
+    jassert(impulseResponse.getNumChannels() > 0 && impulseLength > 0);
+
+    const int numIRChannels = impulseResponse.getNumChannels();
+
+    // Head: first taps as a direct FIR, stored reversed for a forward dot product
+    head.length = juce::jmin(headLength, impulseLength);
+    head.taps.resize(static_cast<size_t>(numIRChannels));
+
+    for (int irChannel = 0; irChannel < numIRChannels; ++irChannel)
+    {
+        const float* taps = impulseResponse.getReadPointer(irChannel);
+        head.taps[static_cast<size_t>(irChannel)].assign(taps, taps + head.length);
+        std::reverse(head.taps[static_cast<size_t>(irChannel)].begin(), head.taps[static_cast<size_t>(irChannel)].end());
+    }
+
+    head.history.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(head.length * 2), 0.0f));
+    head.writeIndex.assign(static_cast<size_t>(numChannels), 0);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        head.filterChannel.push_back(juce::jmin(channel, numIRChannels - 1));
+
+    // Short FFT segment covers everything up to where the tail takes over
+    hasShortSegment = impulseLength > headLength;
+    if (hasShortSegment)
+        shortSegment.prepare(impulseResponse, headLength, juce::jmin(impulseLength, longSegmentStart),
+                             shortBlockSize, numChannels);
+
+    hasLongSegment = impulseLength > longSegmentStart;
+    if (hasLongSegment)
+        longSegment.prepare(impulseResponse, longSegmentStart, impulseLength, longBlockSize, numChannels);
+
+    shortInput.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(shortBlockSize), 0.0f));
+    longInput.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(longBlockSize), 0.0f));
+    longOutput.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(longBlockSize), 0.0f));
+
+    for (auto& job : tailJobs)
+    {
+        job.input.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(longBlockSize), 0.0f));
+        job.output.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(longBlockSize), 0.0f));
+    }
+
+    if (hasLongSegment)
+    {
+        // Above the message thread and other background work, so a tail job
+        // rarely misses its block
+        worker = std::make_unique<TailWorker>(*this);
+        worker->startThread(juce::Thread::Priority::high);
+    }
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+    if (worker != nullptr)
+        worker->stopThread(1000);
+}
+
+void PartitionedConvolver::reset()
+{
+    // Let any job in flight finish before clearing what it works on
+    waitForTailJobs();
+    tailJobDue = false;
+    tailHistoryDropped = false;
+
+    for (auto& buffer : head.history)
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+
+    std::fill(head.writeIndex.begin(), head.writeIndex.end(), 0);
+
+    if (hasShortSegment)
+        shortSegment.reset();
+
+    if (hasLongSegment)
+        longSegment.reset();
+
+    for (auto* buffers : {&shortInput, &longInput, &longOutput})
+        for (auto& buffer : *buffers)
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+
+    shortPosition = 0;
+    longPosition = 0;
+}
+
+void PartitionedConvolver::process(juce::dsp::AudioBlock<float>& block)
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int channelsToProcess = juce::jmin(static_cast<int>(block.getNumChannels()), numChannels);
+
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        // Never run past the next short block boundary (long boundaries line up with these)
+        const int chunk = juce::jmin(shortBlockSize - shortPosition, numSamples - done);
+
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+        {
+            float* data = block.getChannelPointer(static_cast<size_t>(channel)) + done;
+            float* shortIn = shortInput[static_cast<size_t>(channel)].data() + shortPosition;
+            float* longIn = longInput[static_cast<size_t>(channel)].data() + longPosition;
+            const float* shortOut = hasShortSegment ? shortSegment.channels[static_cast<size_t>(channel)].output.data() + shortPosition
+                                                    : nullptr;
+            const float* longOut = longOutput[static_cast<size_t>(channel)].data() + longPosition;
+
+            for (int sample = 0; sample < chunk; ++sample)
+            {
+                const float input = data[sample];
+                shortIn[sample] = input;
+                longIn[sample] = input;
+
+                float output = head.processSample(channel, input);
+
+                if (shortOut != nullptr)
+                    output += shortOut[sample];
+
+                data[sample] = output + longOut[sample];
+            }
+        }
+
+        done += chunk;
+        shortPosition += chunk;
+        longPosition += chunk;
+
+        if (shortPosition == shortBlockSize)
+        {
+            if (hasShortSegment)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                    shortSegment.processBlock(channel, shortInput[static_cast<size_t>(channel)].data());
+
+                shortSegment.advance();
+            }
+
+            shortPosition = 0;
+        }
+
+        if (longPosition == longBlockSize)
+        {
+            if (hasLongSegment)
+            {
+                // The job submitted one block ago is due now
+                collectTailJob();
+                submitTailJob();
+            }
+
+            longPosition = 0;
+        }
+    }
+}
+
+void PartitionedConvolver::runTailJob(TailJob& job)
+{
+    if (job.clearHistoryFirst)
+        longSegment.reset();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        longSegment.processBlock(channel, job.input[static_cast<size_t>(channel)].data());
+
+        const auto& result = longSegment.channels[static_cast<size_t>(channel)].output;
+        std::copy(result.begin(), result.end(), job.output[static_cast<size_t>(channel)].begin());
+    }
+
+    longSegment.advance();
+}
+
+void PartitionedConvolver::waitForTailJobs()
+{
+    while (jobsCompleted.load(std::memory_order_acquire) != jobsSubmitted.load(std::memory_order_relaxed))
+        juce::Thread::sleep(1);
+}
+
+void PartitionedConvolver::collectTailJob()
+{
+    // Nothing newer has been submitted, so if everything is done the due job
+    // is the last one and the worker is idle. Otherwise it's late: keep
+    // playing the previous block's tail rather than wait for it.
+    const auto submitted = jobsSubmitted.load(std::memory_order_relaxed);
+
+    if (!tailJobDue || jobsCompleted.load(std::memory_order_acquire) != submitted)
+        return;
+
+    const auto& job = tailJobs[(submitted - 1) % numTailJobs];
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto& result = job.output[static_cast<size_t>(channel)];
+        std::copy(result.begin(), result.end(), longOutput[static_cast<size_t>(channel)].begin());
+    }
+}
+
+void PartitionedConvolver::submitTailJob()
+{
+    const auto submitted = jobsSubmitted.load(std::memory_order_relaxed);
+
+    // Both slots still queued or running - drop this block, and have the
+    // worker start the tail's history afresh at the next one it gets
+    if (submitted - jobsCompleted.load(std::memory_order_acquire) >= numTailJobs)
+    {
+        tailJobDue = false;
+        tailHistoryDropped = true;
+        return;
+    }
+
+    auto& job = tailJobs[submitted % numTailJobs];
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto& input = longInput[static_cast<size_t>(channel)];
+        std::copy(input.begin(), input.end(), job.input[static_cast<size_t>(channel)].begin());
+    }
+
+    job.clearHistoryFirst = tailHistoryDropped;
+    tailHistoryDropped = false;
+    tailJobDue = true;
+
+    jobsSubmitted.store(submitted + 1, std::memory_order_release);
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * PartitionedConvolver - Zero-latency convolution for long impulse responses
+ *
+ * The impulse response is split into three segments with growing block sizes:
+ *
+ *   taps [0, 64)        direct-form FIR, sample by sample (no latency)
+ *   taps [64, 2048)     uniformly partitioned overlap-save, 64-sample blocks
+ *   taps [2048, end)    uniformly partitioned overlap-save, 1024-sample blocks,
+ *                       computed on a background thread
+ *
+ * Each FFT segment starts exactly where its own block latency is hidden by
+ * the segments before it, so the output is sample-for-sample the same as
+ * direct convolution with no added delay. The 1024-sample tail starts one
+ * block later than it has to, which gives the worker thread a whole block
+ * period to finish.
+ *
+ * The audio thread never waits for the worker. Tail jobs go through two
+ * slots, each with its own input and output, handed over with a pair of
+ * counters that the worker polls every millisecond, so submitting a job is
+ * a single atomic store. A job that misses its block is not waited for: the previous
+ * block's tail plays again, and the late result is dropped when it lands.
+ * If both slots are still busy a block later, that input block is dropped
+ * too and the tail's history is cleared before the next job, so it never
+ * plays out of alignment.
+ *
+ * Construction does all allocation and FFT work, so build one off the audio
+ * thread and swap it in. process() never allocates.
+ */
+class PartitionedConvolver
+{
+public:
+    static constexpr int headLength = 64;
+    static constexpr int shortBlockSize = 64;
+    static constexpr int longBlockSize = 1024;
+    static constexpr int longSegmentStart = 2 * longBlockSize;
+
+    // impulseResponse channels are reused if there are fewer than numChannels
+    PartitionedConvolver(const juce::AudioBuffer<float>& impulseResponse, int numChannels);
+    ~PartitionedConvolver();
+
+    // Clears all history. Waits for the worker, so not for the audio thread.
+    void reset();
+
+    // Convolves in place. Any block size, up to the channel count given at construction.
+    void process(juce::dsp::AudioBlock<float>& block);
+
+    int getImpulseLength() const { return impulseLength; }
+
+private:
+    using Spectrum = std::vector<std::complex<float>>;
+
+    // One uniformly partitioned overlap-save stage (block size B, FFT size 2B)
+    struct Segment
+    {
+        int blockSize = 0;
+        int numPartitions = 0;
+        std::unique_ptr<juce::dsp::FFT> fft;
+
+        // Per IR channel: one spectrum per partition
+        std::vector<std::vector<Spectrum>> filterSpectra;
+
+        struct ChannelState
+        {
+            std::vector<float> inputWindow;          // Last 2B input samples
+            std::vector<Spectrum> delayLine;         // Spectra of past input windows
+            std::vector<float> fftBuffer;            // 2 * FFT size floats
+            std::vector<float> output;               // Result for the next B samples
+            int filterChannel = 0;
+        };
+
+        std::vector<ChannelState> channels;
+        int delayLineIndex = 0;
+
+        void prepare(const juce::AudioBuffer<float>& impulseResponse, int firstTap, int lastTap,
+                     int blockSizeToUse, int numChannels);
+        void reset();
+
+        // newInput holds B fresh samples for the given channel; the result lands in channel.output
+        void processBlock(int channel, const float* newInput);
+        void advance();
+    };
+
+    // Direct FIR for the first taps
+    struct Head
+    {
+        std::vector<std::vector<float>> taps;        // Per IR channel, reversed
+        std::vector<std::vector<float>> history;     // Per channel, doubled for contiguous reads
+        std::vector<int> filterChannel;
+        std::vector<int> writeIndex;
+        int length = 0;
+
+        float processSample(int channel, float input);
+    };
+
+    // Runs 1024-sample tail blocks at high priority
+    class TailWorker;
+
+    struct TailJob
+    {
+        std::vector<std::vector<float>> input;      // Per channel, one long block
+        std::vector<std::vector<float>> output;
+        bool clearHistoryFirst = false;             // Blocks were dropped before this one
+    };
+
+    static constexpr juce::uint32 numTailJobs = 2;
+
+    const int numChannels;
+    int impulseLength = 0;
+
+    Head head;
+    Segment shortSegment;
+    Segment longSegment;
+    bool hasShortSegment = false;
+    bool hasLongSegment = false;
+
+    // Audio thread buffers
+    std::vector<std::vector<float>> shortInput;      // Collects shortBlockSize samples
+    std::vector<std::vector<float>> longInput;       // Collects longBlockSize samples
+    std::vector<std::vector<float>> longOutput;      // Tail result being played out
+    int shortPosition = 0;
+    int longPosition = 0;
+
+    // Shared with the worker. The audio thread only writes a slot when the
+    // counters show the worker is done with it, and the worker only reads
+    // slots the audio thread has published.
+    std::array<TailJob, numTailJobs> tailJobs;
+    std::atomic<juce::uint32> jobsSubmitted { 0 };   // Written by the audio thread
+    std::atomic<juce::uint32> jobsCompleted { 0 };   // Written by the worker
+    std::unique_ptr<TailWorker> worker;
+
+    // Audio thread only
+    bool tailJobDue = false;                         // A job went out at the last long block
+    bool tailHistoryDropped = false;
+
+    void runTailJob(TailJob& job);
+    void waitForTailJobs();
+    void collectTailJob();
+    void submitTailJob();
+};
@@ -0,0 +1,80 @@
+#include "SharedAssetCache.h"
+
+SharedAssetCache& SharedAssetCache::getInstance()
+{
+    static SharedAssetCache cache;
+    return cache;
+}
+
+SharedAssetCache::Claim SharedAssetCache::findOrClaim(const juce::String& key, PendingAsset build)
+{
+    const juce::ScopedLock sl(lock);
+    Claim claim;
+
+    const auto it = assets.find(key);
+
+    if (it != assets.end())
+    {
+        if ((claim.asset = it->second.asset.lock()) != nullptr)
+            return claim;
+
+        if (it->second.pending.valid())
+        {
+            claim.pending = it->second.pending;
+            return claim;
+        }
+    }
+
+    // A new entry: drop those whose assets have gone while we're here
+    for (auto entry = assets.begin(); entry != assets.end();)
+        entry = entry->second.asset.expired() && !entry->second.pending.valid()
+                    ? assets.erase(entry) : std::next(entry);
+
+    assets[key].pending = std::move(build);
+    claim.mustBuild = true;
+    return claim;
+}
+
+void SharedAssetCache::finishBuild(const juce::String& key, std::shared_ptr<const void> asset)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (asset == nullptr)
+    {
+        assets.erase(key);
+        return;
+    }
+
+    auto& entry = assets[key];
+    entry.asset = asset;
+    entry.pending = {};
+}
+
+int SharedAssetCache::getNumAssets() const
+{
+    const juce::ScopedLock sl(lock);
+
+    return static_cast<int>(std::count_if(assets.begin(), assets.end(),
+                                          [](const auto& entry) { return !entry.second.asset.expired(); }));
+}
+
+juce::uint64 SharedAssetCache::hashBytes(const void* data, size_t numBytes, juce::uint64 seed)
+{
+    const auto* bytes = static_cast<const juce::uint8*>(data);
+    auto hash = seed;
+
+    for (size_t i = 0; i < numBytes; ++i)
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+
+    return hash;
+}
+
+juce::uint64 SharedAssetCache::hashString(const juce::String& text, juce::uint64 seed)
+{
+    return hashBytes(text.toRawUTF8(), text.getNumBytesAsUTF8(), seed);
+}
+
+juce::String SharedAssetCache::makeKey(const juce::String& assetType, juce::uint64 hash)
+{
+    return assetType + ":" + juce::String::toHexString(static_cast<juce::int64>(hash));
+}
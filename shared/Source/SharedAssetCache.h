@@ -0,0 +1,96 @@
+#pragma once
+#include <JuceHeader.h>
+#include <future>
+
+/**
+ * SharedAssetCache - Immutable assets shared by every plugin instance in the process
+ *
+ * Wavetables, sample libraries and impulse responses cost memory and load
+ * time, and ten instances of a plugin usually want the same ones. Each
+ * asset is built once and handed out as std::shared_ptr<const T>; the cache
+ * itself only keeps weak references, so an asset is freed when the last
+ * instance using it lets go.
+ *
+ * Keys start with the asset type and end in a hash of whatever the asset is
+ * made from (file contents, or the settings a generated table depends on),
+ * so the same data loaded under two names is still shared.
+ *
+ * Only loader threads (message thread, render workers) use the cache. The
+ * audio thread reads assets through pointers its owner handed over with the
+ * usual atomic swap - they never change, so that needs no locking - and
+ * owners release their references away from the audio thread.
+ */
+class SharedAssetCache
+{
+public:
+    static SharedAssetCache& getInstance();
+
+    // Returns the cached asset for this key, or builds it with create(), which
+    // returns a std::shared_ptr<const Asset> (null on failure - nothing is
+    // cached). Building happens outside the cache lock, so other assets load
+    // meanwhile; callers asking for an asset that is already being built wait
+    // for that build and share its result rather than building it again.
+    template <typename Asset, typename Factory>
+    std::shared_ptr<const Asset> getOrCreate(const juce::String& key, Factory&& create)
+    {
+        std::promise<std::shared_ptr<const void>> build;
+        const auto claim = findOrClaim(key, build.get_future().share());
+
+        if (claim.asset != nullptr)
+            return std::static_pointer_cast<const Asset>(claim.asset);
+
+        if (!claim.mustBuild)
+            return std::static_pointer_cast<const Asset>(claim.pending.get());
+
+        std::shared_ptr<const Asset> asset = create();
+        finishBuild(key, asset);
+        build.set_value(asset);
+
+        return asset;
+    }
+
+    // Assets currently in use somewhere
+    int getNumAssets() const;
+
+    // 64-bit FNV-1a; chain calls through seed to hash several pieces
+    static constexpr juce::uint64 hashSeed = 0xcbf29ce484222325ull;
+    static juce::uint64 hashBytes(const void* data, size_t numBytes, juce::uint64 seed = hashSeed);
+    static juce::uint64 hashString(const juce::String& text, juce::uint64 seed = hashSeed);
+
+    template <typename Value>
+    static juce::uint64 hashValue(Value value, juce::uint64 seed = hashSeed)
+    {
+        static_assert(std::is_trivially_copyable<Value>::value, "Hash plain values only");
+        return hashBytes(&value, sizeof(value), seed);
+    }
+
+    static juce::String makeKey(const juce::String& assetType, juce::uint64 hash);
+
+private:
+    SharedAssetCache() = default;
+
+    using PendingAsset = std::shared_future<std::shared_ptr<const void>>;
+
+    struct Entry
+    {
+        std::weak_ptr<const void> asset;
+        PendingAsset pending;  // Valid while a caller is building the asset
+    };
+
+    struct Claim
+    {
+        std::shared_ptr<const void> asset;  // Already built
+        PendingAsset pending;               // Or being built by someone else
+        bool mustBuild = false;             // Or neither - the caller builds it
+    };
+
+    juce::CriticalSection lock;
+    std::map<juce::String, Entry> assets;
+
+    // The asset, another caller's build to wait for, or - when there's neither -
+    // the job of building it, with build registered for later callers to wait on
+    Claim findOrClaim(const juce::String& key, PendingAsset build);
+    void finishBuild(const juce::String& key, std::shared_ptr<const void> asset);
+
+    JUCE_DECLARE_NON_COPYABLE(SharedAssetCache)
+};
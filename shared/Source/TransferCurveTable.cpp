@@ -0,0 +1,126 @@
+#include "TransferCurveTable.h"
+#include "WaveshaperKernels.h"
+
+TransferCurveTable::TransferCurveTable(CurveFunction curveToUse, float inputRangeToUse, int tableSizeToUse)
+    : curve(curveToUse),
+      inputRange(inputRangeToUse),
+      tableSize(juce::jmax(2, tableSizeToUse))
+{
+    jassert(curve != nullptr && inputRange > 0.0f);
+
+    // All storage is allocated here - nothing is resized after construction
+    for (auto& table : tables)
+        table.resize(static_cast<size_t>(tableSize));
+
+    buildTable(tables[0], builtParameter);
+}
+
+void TransferCurveTable::prepare(double sampleRate)
+{
+    builtParameter = requestedParameter;
+    buildTable(tables[0], builtParameter);
+
+    activeTable = 0;
+    crossfading = false;
+    crossfadePosition = 0;
+    setSampleRate(sampleRate);
+}
+
+void TransferCurveTable::reset()
+{
+    // Finish any crossfade immediately
+    crossfading = false;
+    crossfadePosition = 0;
+}
+
+void TransferCurveTable::setSampleRate(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    crossfadeLength = juce::jmax(1, juce::roundToInt(crossfadeSeconds * currentSampleRate));
+}
+
+void TransferCurveTable::setCrossfadeTime(double seconds)
+{
+    crossfadeSeconds = seconds;
+    setSampleRate(currentSampleRate);
+}
+
+void TransferCurveTable::setParameter(float newParameter)
+{
+    requestedParameter = newParameter;
+}
+
+void TransferCurveTable::buildTable(std::vector<float>& table, float parameter) const
+{
+    const float step = 2.0f * inputRange / static_cast<float>(tableSize - 1);
+
+    for (int i = 0; i < tableSize; ++i)
+        table[static_cast<size_t>(i)] = -inputRange + static_cast<float>(i) * step;
+
+    curve(table.data(), tableSize, parameter);
+}
+
+void TransferCurveTable::lookup(const std::vector<float>& table, float* data, int numSamples,
+                                float inputGain, float outputGain) const
+{
+    WaveshaperKernels::tableLookup(data, numSamples, table.data(), tableSize, inputRange, inputGain, outputGain);
+}
+
+void TransferCurveTable::process(juce::dsp::AudioBlock<float>& block, float inputGain, float outputGain)
+{
+    // One crossfade at a time - a newer setting waits for the current fade to finish
+    if (!crossfading && requestedParameter != builtParameter)
+    {
+        builtParameter = requestedParameter;
+        activeTable = 1 - activeTable;
+        buildTable(tables[static_cast<size_t>(activeTable)], builtParameter);
+        crossfading = true;
+        crossfadePosition = 0;
+    }
+
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = static_cast<int>(block.getNumChannels());
+    const auto& newTable = tables[static_cast<size_t>(activeTable)];
+
+    if (!crossfading)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            lookup(newTable, block.getChannelPointer(static_cast<size_t>(channel)), numSamples, inputGain, outputGain);
+
+        return;
+    }
+
+    // Linear crossfade from the old table to the new one, a chunk at a time
+    const auto& oldTable = tables[static_cast<size_t>(1 - activeTable)];
+    const float fadeStep = 1.0f / static_cast<float>(crossfadeLength);
+    float oldOut[crossfadeChunkSize];
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* channelData = block.getChannelPointer(static_cast<size_t>(channel));
+        int position = crossfadePosition;
+
+        for (int start = 0; start < numSamples; start += crossfadeChunkSize)
+        {
+            const int chunkLength = juce::jmin(crossfadeChunkSize, numSamples - start);
+            float* newOut = channelData + start;
+
+            std::copy(newOut, newOut + chunkLength, oldOut);
+            lookup(oldTable, oldOut, chunkLength, inputGain, outputGain);
+            lookup(newTable, newOut, chunkLength, inputGain, outputGain);
+
+            for (int sample = 0; sample < chunkLength; ++sample)
+            {
+                const float newAmount = std::min(1.0f, static_cast<float>(position + sample) * fadeStep);
+                newOut[sample] = oldOut[sample] + newAmount * (newOut[sample] - oldOut[sample]);
+            }
+
+            position += chunkLength;
+        }
+    }
+
+    crossfadePosition += numSamples;
+
+    if (crossfadePosition >= crossfadeLength)
+        crossfading = false;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * TransferCurveTable - Precomputed static waveshaper
+ *
+ * Wraps any memoryless curve y = curve(x, parameter) (e.g. a whole drive
+ * chain as a function of the drive setting) in a lookup table, so the
+ * per-sample cost is one linearly interpolated lookup no matter how
+ * expensive the curve is to evaluate. Lookups go through
+ * WaveshaperKernels::tableLookup, so they are vectorised too.
+ *
+ * The curve is sampled over [-inputRange, inputRange]. Inputs outside that
+ * range read the end points, so the curve should have settled onto its
+ * asymptotes by then.
+ *
+ * The curve is evaluated a whole table at a time, so a SIMD curve (like
+ * WaveshaperKernels::ampStageCurve) builds a table in a few microseconds.
+ * That is cheap enough to do on the audio thread in the block where the
+ * parameter changes; the new table is then crossfaded in. Both tables are
+ * allocated up front, so nothing waits or allocates, and an offline render
+ * gets the same result on every run.
+ */
+class TransferCurveTable
+{
+public:
+    // Replaces numSamples evenly spaced inputs (from -inputRange to
+    // inputRange) with the curve's outputs for this parameter value
+    using CurveFunction = void (*)(float* data, int numSamples, float parameter);
+
+    TransferCurveTable(CurveFunction curveToUse, float inputRangeToUse, int tableSizeToUse = 4096);
+
+    // Builds the table for the current parameter with no crossfade
+    void prepare(double sampleRate);
+    void reset();
+
+    // Sample rate of the blocks passed to process() and how long a new
+    // table takes to fade in. Cheap - may be called from the audio thread.
+    void setSampleRate(double sampleRate);
+    void setCrossfadeTime(double seconds);
+
+    // The new table is built at the start of the next process() and faded
+    // in from there. A change during a crossfade waits for it to finish.
+    void setParameter(float newParameter);
+
+    // out = table(in * inputGain) * outputGain, in place on every channel
+    void process(juce::dsp::AudioBlock<float>& block, float inputGain, float outputGain);
+
+private:
+    static constexpr int crossfadeChunkSize = 64;  // Old table's output is held on the stack
+
+    const CurveFunction curve;
+    const float inputRange;
+    const int tableSize;
+
+    std::array<std::vector<float>, 2> tables;
+    int activeTable = 0;                 // The other one is fading out, or free
+    bool crossfading = false;
+
+    float requestedParameter = 0.0f;
+    float builtParameter = 0.0f;
+
+    int crossfadeLength = 441;
+    int crossfadePosition = 0;
+    double currentSampleRate = 44100.0;
+    double crossfadeSeconds = 0.01;
+
+    void buildTable(std::vector<float>& table, float parameter) const;
+    void lookup(const std::vector<float>& table, float* data, int numSamples, float inputGain, float outputGain) const;
+};
@@ -0,0 +1,443 @@
+#include "WaveshaperKernels.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#elif JUCE_ARM && JUCE_64BIT
+ #include <arm_neon.h>
+#endif
+
+// Per-function target attributes let us build an AVX2 copy of the kernels
+// without raising the baseline ISA for the whole plugin. MSVC emits AVX
+// intrinsics without any flags, so there the attribute is simply dropped.
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #define WAVESHAPER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+ #define WAVESHAPER_TARGET_AVX2
+#endif
+
+namespace
+{
+    constexpr float clipLimit = 3.0f;           // Rational tanh hits +/-1 exactly here
+    constexpr float positiveInputScale = 0.8f;  // Softer clipping on the positive half
+    constexpr float positiveOutputScale = 1.25f;
+    constexpr float negativeInputScale = 1.2f;  // Harder clipping on the negative half
+    constexpr float negativeOutputScale = 0.83f;
+    constexpr float powerAmpInputScale = 0.9f;
+    constexpr float powerAmpOutputScale = 1.1f;
+
+    //==============================================================================
+    // Scalar versions - used for the tail of each block and when no vector path exists.
+    // Same operations in the same order as the vector code, so results are identical.
+    inline float tanhApprox(float x)
+    {
+        x = std::min(std::max(x, -clipLimit), clipLimit);
+        const float x2 = x * x;
+        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    }
+
+    inline float asymmetricTube(float driven)
+    {
+        const bool positive = driven > 0.0f;
+        const float inputScale = positive ? positiveInputScale : negativeInputScale;
+        const float outputScale = positive ? positiveOutputScale : negativeOutputScale;
+        return tanhApprox(driven * inputScale) * outputScale;
+    }
+
+    inline float ampStage(float x, float preampGain, float driveGain, float outputGain)
+    {
+        const float preampOut = tanhApprox(x * preampGain);
+        const float driveOut = asymmetricTube(preampOut * driveGain);
+        return tanhApprox(driveOut * powerAmpInputScale) * powerAmpOutputScale * outputGain;
+    }
+
+    void softClipScalar(float* data, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = tanhApprox(data[i]);
+    }
+
+    void ampStagesScalar(float* data, int numSamples, float preampGain, float driveGain, float outputGain)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = ampStage(data[i], preampGain, driveGain, outputGain);
+    }
+
+    // Table lookups: the index is clamped in float before truncating, which
+    // is the same as clamping the integer index but needs no integer min
+    struct LookupSetup
+    {
+        LookupSetup(const float* tableToUse, int tableSize, float range, float input, float output)
+            : table(tableToUse),
+              inputRange(range),
+              indexScale(static_cast<float>(tableSize - 1) / (2.0f * range)),
+              maxIndex(static_cast<float>(tableSize - 2)),
+              inputGain(input),
+              outputGain(output)
+        {
+        }
+
+        const float* table;
+        float inputRange;
+        float indexScale;
+        float maxIndex;
+        float inputGain;
+        float outputGain;
+    };
+
+    inline float tableLookup(const LookupSetup& setup, float input)
+    {
+        const float clamped = std::min(std::max(input * setup.inputGain, -setup.inputRange), setup.inputRange);
+        const float position = (clamped + setup.inputRange) * setup.indexScale;
+        const int index = static_cast<int>(std::min(position, setup.maxIndex));
+        const float fraction = position - static_cast<float>(index);
+        const float low = setup.table[index];
+        return (low + fraction * (setup.table[index + 1] - low)) * setup.outputGain;
+    }
+
+    void tableLookupScalar(float* data, int numSamples, const LookupSetup& setup)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = tableLookup(setup, data[i]);
+    }
+
+   #if JUCE_INTEL
+    //==============================================================================
+    // SSE2 - baseline on every x86-64 CPU
+    inline __m128 tanhApprox(__m128 x)
+    {
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-clipLimit)), _mm_set1_ps(clipLimit));
+        const __m128 x2 = _mm_mul_ps(x, x);
+        const __m128 numerator = _mm_mul_ps(x, _mm_add_ps(_mm_set1_ps(27.0f), x2));
+        const __m128 denominator = _mm_add_ps(_mm_set1_ps(27.0f), _mm_mul_ps(_mm_set1_ps(9.0f), x2));
+        return _mm_div_ps(numerator, denominator);
+    }
+
+    inline __m128 select(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+    }
+
+    inline __m128 asymmetricTube(__m128 driven)
+    {
+        const __m128 positive = _mm_cmpgt_ps(driven, _mm_setzero_ps());
+        const __m128 inputScale = select(positive, _mm_set1_ps(positiveInputScale), _mm_set1_ps(negativeInputScale));
+        const __m128 outputScale = select(positive, _mm_set1_ps(positiveOutputScale), _mm_set1_ps(negativeOutputScale));
+        return _mm_mul_ps(tanhApprox(_mm_mul_ps(driven, inputScale)), outputScale);
+    }
+
+    void softClipSSE2(float* data, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_ps(data + i, tanhApprox(_mm_loadu_ps(data + i)));
+
+        softClipScalar(data + i, numSamples - i);
+    }
+
+    void ampStagesSSE2(float* data, int numSamples, float preampGain, float driveGain, float outputGain)
+    {
+        const __m128 preamp = _mm_set1_ps(preampGain);
+        const __m128 drive = _mm_set1_ps(driveGain);
+        const __m128 output = _mm_set1_ps(outputGain);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const __m128 preampOut = tanhApprox(_mm_mul_ps(_mm_loadu_ps(data + i), preamp));
+            const __m128 driveOut = asymmetricTube(_mm_mul_ps(preampOut, drive));
+            const __m128 powerAmpOut = _mm_mul_ps(tanhApprox(_mm_mul_ps(driveOut, _mm_set1_ps(powerAmpInputScale))),
+                                                  _mm_set1_ps(powerAmpOutputScale));
+            _mm_storeu_ps(data + i, _mm_mul_ps(powerAmpOut, output));
+        }
+
+        ampStagesScalar(data + i, numSamples - i, preampGain, driveGain, outputGain);
+    }
+
+    void tableLookupSSE2(float* data, int numSamples, const LookupSetup& setup)
+    {
+        const __m128 inputGain = _mm_set1_ps(setup.inputGain);
+        const __m128 range = _mm_set1_ps(setup.inputRange);
+        const __m128 negativeRange = _mm_set1_ps(-setup.inputRange);
+        const __m128 indexScale = _mm_set1_ps(setup.indexScale);
+        const __m128 maxIndex = _mm_set1_ps(setup.maxIndex);
+        const __m128 outputGain = _mm_set1_ps(setup.outputGain);
+        alignas(16) std::int32_t indices[4];
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const __m128 input = _mm_mul_ps(_mm_loadu_ps(data + i), inputGain);
+            const __m128 position = _mm_mul_ps(_mm_add_ps(_mm_min_ps(_mm_max_ps(input, negativeRange), range), range), indexScale);
+            const __m128i index = _mm_cvttps_epi32(_mm_min_ps(position, maxIndex));
+            const __m128 fraction = _mm_sub_ps(position, _mm_cvtepi32_ps(index));
+
+            // No gather before AVX2 - the arithmetic stays in registers, the loads are scalar
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+            const float* t = setup.table;
+            const __m128 low = _mm_setr_ps(t[indices[0]], t[indices[1]], t[indices[2]], t[indices[3]]);
+            const __m128 high = _mm_setr_ps(t[indices[0] + 1], t[indices[1] + 1], t[indices[2] + 1], t[indices[3] + 1]);
+
+            _mm_storeu_ps(data + i, _mm_mul_ps(_mm_add_ps(low, _mm_mul_ps(fraction, _mm_sub_ps(high, low))), outputGain));
+        }
+
+        tableLookupScalar(data + i, numSamples - i, setup);
+    }
+
+    //==============================================================================
+    // AVX2 - eight samples at a time, only called when the CPU reports support.
+    // FMA is deliberately left out so results match the SSE2 and scalar paths.
+    WAVESHAPER_TARGET_AVX2 inline __m256 tanhApprox(__m256 x)
+    {
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-clipLimit)), _mm256_set1_ps(clipLimit));
+        const __m256 x2 = _mm256_mul_ps(x, x);
+        const __m256 numerator = _mm256_mul_ps(x, _mm256_add_ps(_mm256_set1_ps(27.0f), x2));
+        const __m256 denominator = _mm256_add_ps(_mm256_set1_ps(27.0f), _mm256_mul_ps(_mm256_set1_ps(9.0f), x2));
+        return _mm256_div_ps(numerator, denominator);
+    }
+
+    WAVESHAPER_TARGET_AVX2 inline __m256 asymmetricTube(__m256 driven)
+    {
+        const __m256 positive = _mm256_cmp_ps(driven, _mm256_setzero_ps(), _CMP_GT_OQ);
+        const __m256 inputScale = _mm256_blendv_ps(_mm256_set1_ps(negativeInputScale), _mm256_set1_ps(positiveInputScale), positive);
+        const __m256 outputScale = _mm256_blendv_ps(_mm256_set1_ps(negativeOutputScale), _mm256_set1_ps(positiveOutputScale), positive);
+        return _mm256_mul_ps(tanhApprox(_mm256_mul_ps(driven, inputScale)), outputScale);
+    }
+
+    WAVESHAPER_TARGET_AVX2 void softClipAVX2(float* data, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps(data + i, tanhApprox(_mm256_loadu_ps(data + i)));
+
+        softClipScalar(data + i, numSamples - i);
+    }
+
+    WAVESHAPER_TARGET_AVX2 void ampStagesAVX2(float* data, int numSamples, float preampGain, float driveGain, float outputGain)
+    {
+        const __m256 preamp = _mm256_set1_ps(preampGain);
+        const __m256 drive = _mm256_set1_ps(driveGain);
+        const __m256 output = _mm256_set1_ps(outputGain);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256 preampOut = tanhApprox(_mm256_mul_ps(_mm256_loadu_ps(data + i), preamp));
+            const __m256 driveOut = asymmetricTube(_mm256_mul_ps(preampOut, drive));
+            const __m256 powerAmpOut = _mm256_mul_ps(tanhApprox(_mm256_mul_ps(driveOut, _mm256_set1_ps(powerAmpInputScale))),
+                                                     _mm256_set1_ps(powerAmpOutputScale));
+            _mm256_storeu_ps(data + i, _mm256_mul_ps(powerAmpOut, output));
+        }
+
+        ampStagesScalar(data + i, numSamples - i, preampGain, driveGain, outputGain);
+    }
+
+    WAVESHAPER_TARGET_AVX2 void tableLookupAVX2(float* data, int numSamples, const LookupSetup& setup)
+    {
+        const __m256 inputGain = _mm256_set1_ps(setup.inputGain);
+        const __m256 range = _mm256_set1_ps(setup.inputRange);
+        const __m256 negativeRange = _mm256_set1_ps(-setup.inputRange);
+        const __m256 indexScale = _mm256_set1_ps(setup.indexScale);
+        const __m256 maxIndex = _mm256_set1_ps(setup.maxIndex);
+        const __m256 outputGain = _mm256_set1_ps(setup.outputGain);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256 input = _mm256_mul_ps(_mm256_loadu_ps(data + i), inputGain);
+            const __m256 position = _mm256_mul_ps(_mm256_add_ps(_mm256_min_ps(_mm256_max_ps(input, negativeRange), range), range), indexScale);
+            const __m256i index = _mm256_cvttps_epi32(_mm256_min_ps(position, maxIndex));
+            const __m256 fraction = _mm256_sub_ps(position, _mm256_cvtepi32_ps(index));
+            const __m256 low = _mm256_i32gather_ps(setup.table, index, 4);
+            const __m256 high = _mm256_i32gather_ps(setup.table + 1, index, 4);
+
+            _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_add_ps(low, _mm256_mul_ps(fraction, _mm256_sub_ps(high, low))), outputGain));
+        }
+
+        tableLookupScalar(data + i, numSamples - i, setup);
+    }
+
+   #elif JUCE_ARM && JUCE_64BIT
+    //==============================================================================
+    // NEON - baseline on every arm64 CPU
+    inline float32x4_t tanhApprox(float32x4_t x)
+    {
+        x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(-clipLimit)), vdupq_n_f32(clipLimit));
+        const float32x4_t x2 = vmulq_f32(x, x);
+        const float32x4_t numerator = vmulq_f32(x, vaddq_f32(vdupq_n_f32(27.0f), x2));
+        const float32x4_t denominator = vaddq_f32(vdupq_n_f32(27.0f), vmulq_f32(vdupq_n_f32(9.0f), x2));
+        return vdivq_f32(numerator, denominator);
+    }
+
+    inline float32x4_t asymmetricTube(float32x4_t driven)
+    {
+        const uint32x4_t positive = vcgtq_f32(driven, vdupq_n_f32(0.0f));
+        const float32x4_t inputScale = vbslq_f32(positive, vdupq_n_f32(positiveInputScale), vdupq_n_f32(negativeInputScale));
+        const float32x4_t outputScale = vbslq_f32(positive, vdupq_n_f32(positiveOutputScale), vdupq_n_f32(negativeOutputScale));
+        return vmulq_f32(tanhApprox(vmulq_f32(driven, inputScale)), outputScale);
+    }
+
+    void softClipNEON(float* data, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            vst1q_f32(data + i, tanhApprox(vld1q_f32(data + i)));
+
+        softClipScalar(data + i, numSamples - i);
+    }
+
+    void ampStagesNEON(float* data, int numSamples, float preampGain, float driveGain, float outputGain)
+    {
+        const float32x4_t preamp = vdupq_n_f32(preampGain);
+        const float32x4_t drive = vdupq_n_f32(driveGain);
+        const float32x4_t output = vdupq_n_f32(outputGain);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const float32x4_t preampOut = tanhApprox(vmulq_f32(vld1q_f32(data + i), preamp));
+            const float32x4_t driveOut = asymmetricTube(vmulq_f32(preampOut, drive));
+            const float32x4_t powerAmpOut = vmulq_f32(tanhApprox(vmulq_f32(driveOut, vdupq_n_f32(powerAmpInputScale))),
+                                                      vdupq_n_f32(powerAmpOutputScale));
+            vst1q_f32(data + i, vmulq_f32(powerAmpOut, output));
+        }
+
+        ampStagesScalar(data + i, numSamples - i, preampGain, driveGain, outputGain);
+    }
+
+    void tableLookupNEON(float* data, int numSamples, const LookupSetup& setup)
+    {
+        const float32x4_t inputGain = vdupq_n_f32(setup.inputGain);
+        const float32x4_t range = vdupq_n_f32(setup.inputRange);
+        const float32x4_t negativeRange = vdupq_n_f32(-setup.inputRange);
+        const float32x4_t indexScale = vdupq_n_f32(setup.indexScale);
+        const float32x4_t maxIndex = vdupq_n_f32(setup.maxIndex);
+        const float32x4_t outputGain = vdupq_n_f32(setup.outputGain);
+        std::int32_t indices[4];
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const float32x4_t input = vmulq_f32(vld1q_f32(data + i), inputGain);
+            const float32x4_t position = vmulq_f32(vaddq_f32(vminq_f32(vmaxq_f32(input, negativeRange), range), range), indexScale);
+            const int32x4_t index = vcvtq_s32_f32(vminq_f32(position, maxIndex));
+            const float32x4_t fraction = vsubq_f32(position, vcvtq_f32_s32(index));
+
+            // NEON has no gather - the arithmetic stays in registers, the loads are scalar
+            vst1q_s32(indices, index);
+            const float* t = setup.table;
+            const float lowValues[4] = { t[indices[0]], t[indices[1]], t[indices[2]], t[indices[3]] };
+            const float highValues[4] = { t[indices[0] + 1], t[indices[1] + 1], t[indices[2] + 1], t[indices[3] + 1] };
+            const float32x4_t low = vld1q_f32(lowValues);
+            const float32x4_t high = vld1q_f32(highValues);
+
+            vst1q_f32(data + i, vmulq_f32(vaddq_f32(low, vmulq_f32(fraction, vsubq_f32(high, low))), outputGain));
+        }
+
+        tableLookupScalar(data + i, numSamples - i, setup);
+    }
+   #endif
+
+    //==============================================================================
+    // Picked once, the first time any kernel runs
+    struct Dispatch
+    {
+        void (*softClip)(float*, int) = softClipScalar;
+        void (*ampStages)(float*, int, float, float, float) = ampStagesScalar;
+        void (*tableLookup)(float*, int, const LookupSetup&) = tableLookupScalar;
+        const char* instructionSet = "Scalar";
+
+        Dispatch()
+        {
+           #if JUCE_INTEL
+            softClip = softClipSSE2;
+            ampStages = ampStagesSSE2;
+            tableLookup = tableLookupSSE2;
+            instructionSet = "SSE2";
+
+            if (juce::SystemStats::hasAVX2())
+            {
+                softClip = softClipAVX2;
+                ampStages = ampStagesAVX2;
+                tableLookup = tableLookupAVX2;
+                instructionSet = "AVX2";
+            }
+           #elif JUCE_ARM && JUCE_64BIT
+            softClip = softClipNEON;
+            ampStages = ampStagesNEON;
+            tableLookup = tableLookupNEON;
+            instructionSet = "NEON";
+           #endif
+        }
+    };
+
+    const Dispatch& getDispatch()
+    {
+        static const Dispatch dispatch;
+        return dispatch;
+    }
+}
+
+namespace WaveshaperKernels
+{
+    void softClip(float* data, int numSamples)
+    {
+        getDispatch().softClip(data, numSamples);
+    }
+
+    void ampStages(float* data, int numSamples, const AmpStageGains& gains)
+    {
+        getDispatch().ampStages(data, numSamples, gains.preampGain, gains.driveGain, gains.outputGain);
+    }
+
+    void ampStageCurve(float* data, int numSamples, float driveGain)
+    {
+        getDispatch().ampStages(data, numSamples, 1.0f, driveGain, 1.0f);
+    }
+
+    void tableLookup(float* data, int numSamples, const float* table, int tableSize,
+                     float inputRange, float inputGain, float outputGain)
+    {
+        jassert(tableSize >= 2 && inputRange > 0.0f);
+        getDispatch().tableLookup(data, numSamples, { table, tableSize, inputRange, inputGain, outputGain });
+    }
+
+    const char* getActiveInstructionSet()
+    {
+        return getDispatch().instructionSet;
+    }
+
+    namespace reference
+    {
+        float tanhApprox(float x)
+        {
+            if (x > 3.0f) return 1.0f;
+            if (x < -3.0f) return -1.0f;
+
+            float x2 = x * x;
+            return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+        }
+
+        float softClip(float x)
+        {
+            return tanhApprox(x);
+        }
+
+        float asymmetricTube(float driven)
+        {
+            if (driven > 0.0f)
+                return tanhApprox(driven * 0.8f) * 1.25f;
+
+            return tanhApprox(driven * 1.2f) * 0.83f;
+        }
+
+        float ampStages(float x, const AmpStageGains& gains)
+        {
+            const float preampOut = softClip(x * gains.preampGain);
+            const float driveOut = asymmetricTube(preampOut * gains.driveGain);
+            return tanhApprox(driveOut * 0.9f) * 1.1f * gains.outputGain;
+        }
+    }
+}
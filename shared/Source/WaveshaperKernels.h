@@ -0,0 +1,57 @@
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * WaveshaperKernels - Branch-free block waveshapers
+ *
+ * Every kernel processes a whole channel at a time and is written without
+ * data-dependent branches (clamps are min/max, the asymmetric tube curve
+ * picks its constants with a select), so the loops vectorise to SSE/NEON.
+ * On x86 an AVX2 build of the same loops is picked at runtime when the CPU
+ * supports it. It is built without FMA so every path rounds the same way.
+ * Table lookups gather their points with AVX2; SSE2 and NEON have no
+ * gather, so they load the points one by one and vectorise the rest.
+ *
+ * The curves match the original scalar code exactly: the rational tanh
+ * reaches +/-1 at +/-3, so clamping the input there is the same as clamping
+ * the output. The scalar reference versions are kept in
+ * WaveshaperKernels::reference for accuracy checks.
+ */
+namespace WaveshaperKernels
+{
+    // Gains for the fused preamp -> drive -> power amp stage of the amp sim
+    struct AmpStageGains
+    {
+        float preampGain = 1.0f;   // Into the preamp soft clipper
+        float driveGain = 1.0f;    // Into the asymmetric tube stage
+        float outputGain = 1.0f;   // After the power amp compression
+    };
+
+    // tanh_approx(x) on every sample
+    void softClip(float* data, int numSamples);
+
+    // out = powerAmp(asymmetricTube(softClip(in * preamp) * drive)) * output
+    void ampStages(float* data, int numSamples, const AmpStageGains& gains);
+
+    // The fused stage for one drive setting (preamp and output gain of 1),
+    // in place - what a TransferCurveTable samples to build its table
+    void ampStageCurve(float* data, int numSamples, float driveGain);
+
+    // data = table(data * inputGain) * outputGain, linearly interpolated from
+    // tableSize points spread evenly over [-inputRange, inputRange]. Inputs
+    // outside the range read the end points.
+    void tableLookup(float* data, int numSamples, const float* table, int tableSize,
+                     float inputRange, float inputGain, float outputGain);
+
+    // Name of the code path the dispatcher picked ("AVX2", "SSE2", "NEON", ...)
+    const char* getActiveInstructionSet();
+
+    // Original per-sample implementations, for comparison only
+    namespace reference
+    {
+        float tanhApprox(float x);
+        float softClip(float x);
+        float asymmetricTube(float driven);
+        float ampStages(float x, const AmpStageGains& gains);
+    }
+}
@@ -0,0 +1,242 @@
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+namespace
+{
+    // Meters show -60dB to 0dB
+    constexpr float meterFloorDb = -60.0f;
+
+    float dbToMeterProportion(float db)
+    {
+        return juce::jlimit(0.0f, 1.0f, (db - meterFloorDb) / -meterFloorDb);
+    }
+}
+
+SmartNoiseGateAudioProcessorEditor::SmartNoiseGateAudioProcessorEditor(SmartNoiseGateAudioProcessor& p)
+    : AudioProcessorEditor(&p),
+      audioProcessor(p)
+{
+    // Vertical layout fits better in a DAW
+    setSize(360, 520);
+
+    setupKnob(thresholdSlider, thresholdLabel, audioProcessor.thresholdParam, "THRESHOLD", " dB",
+              "Threshold = the minimum volume needed to open the gate.\n"
+              "Too low = doesn't cut noise. Too high = cuts wanted notes.");
+
+    setupKnob(attackSlider, attackLabel, audioProcessor.attackParam, "ATTACK", " ms",
+              "Attack = how fast the gate opens.\n"
+              "Fast (0.5ms) preserves sharp pick attacks. Slow (10ms+) can soften transients.");
+
+    setupKnob(releaseSlider, releaseLabel, audioProcessor.releaseParam, "RELEASE", " ms",
+              "Release = how fast the gate closes.\n"
+              "Too fast = unnatural cutoff. Too slow = lets noise through.");
+
+    setupKnob(holdSlider, holdLabel, audioProcessor.holdParam, "HOLD", " ms",
+              "Hold = time the gate stays open after the signal drops.\n"
+              "Prevents rapid opening/closing on borderline signals.");
+
+    setupKnob(hysteresisSlider, hysteresisLabel, audioProcessor.hysteresisParam, "HYSTERESIS", " dB",
+              "Hysteresis = gap between the open and close thresholds.\n"
+              "Prevents the gate from flickering on/off rapidly.");
+
+    setupKnob(lookaheadSlider, lookaheadLabel, audioProcessor.lookaheadParam, "LOOKAHEAD", " ms",
+              "Lookahead = opens the gate slightly before a note arrives.\n"
+              "Keeps the very first transient intact, at the cost of this much latency.");
+
+    // Detection mode
+    detectionSelector.addItemList(audioProcessor.detectionParam->choices, 1);
+    detectionSelector.setSelectedItemIndex(audioProcessor.detectionParam->getIndex(), juce::dontSendNotification);
+    detectionSelector.setColour(juce::ComboBox::backgroundColourId, panelColor);
+    detectionSelector.setColour(juce::ComboBox::outlineColourId, outlineColor);
+    detectionSelector.setTooltip("Peak reacts to fast transients (good for guitar).\n"
+                                 "RMS follows average energy and is more forgiving.");
+    detectionSelector.onChange = [this]()
+    {
+        auto* param = audioProcessor.detectionParam;
+        param->setValueNotifyingHost(param->convertTo0to1(detectionSelector.getSelectedItemIndex()));
+    };
+    addAndMakeVisible(detectionSelector);
+
+    // Sidechain switch
+    sidechainButton.setToggleState(audioProcessor.sidechainParam->get(), juce::dontSendNotification);
+    sidechainButton.setColour(juce::ToggleButton::tickColourId, accentColor);
+    sidechainButton.setTooltip("Open the gate from the sidechain input instead of the main input");
+    sidechainButton.onClick = [this]()
+    {
+        audioProcessor.sidechainParam->setValueNotifyingHost(sidechainButton.getToggleState() ? 1.0f : 0.0f);
+    };
+    addAndMakeVisible(sidechainButton);
+
+    // Start timer to sync GUI with parameter changes and animate the meters
+    startTimerHz(30);
+}
+
+SmartNoiseGateAudioProcessorEditor::~SmartNoiseGateAudioProcessorEditor()
+{
+}
+
+void SmartNoiseGateAudioProcessorEditor::setupKnob(juce::Slider& slider, juce::Label& label,
+                                                   juce::AudioParameterFloat* param, const juce::String& name,
+                                                   const juce::String& suffix, const juce::String& tooltip)
+{
+    const auto& range = param->range;
+
+    slider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+    slider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 18);
+    slider.setNormalisableRange(juce::NormalisableRange<double>(range.start, range.end, range.interval, range.skew));
+    slider.setTextValueSuffix(suffix);
+    slider.setValue(param->get(), juce::dontSendNotification);
+    slider.setTooltip(tooltip);
+
+    slider.setColour(juce::Slider::rotarySliderFillColourId, accentColor);
+    slider.setColour(juce::Slider::rotarySliderOutlineColourId, outlineColor);
+    slider.setColour(juce::Slider::thumbColourId, accentColor);
+    slider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    slider.setColour(juce::Slider::textBoxBackgroundColourId, panelColor);
+    slider.setColour(juce::Slider::textBoxOutlineColourId, outlineColor);
+
+    slider.onValueChange = [&slider, param]()
+    {
+        param->setValueNotifyingHost(param->convertTo0to1(static_cast<float>(slider.getValue())));
+    };
+
+    label.setText(name, juce::dontSendNotification);
+    label.setJustificationType(juce::Justification::centred);
+    label.setColour(juce::Label::textColourId, juce::Colours::white.withAlpha(0.7f));
+    label.attachToComponent(&slider, false);
+
+    addAndMakeVisible(slider);
+    addAndMakeVisible(label);
+}
+
+void SmartNoiseGateAudioProcessorEditor::paint(juce::Graphics& g)
+{
+    juce::ColourGradient gradient(panelColor, 0.0f, 0.0f,
+                                  backgroundColor, 0.0f, static_cast<float>(getHeight()), false);
+    g.setGradientFill(gradient);
+    g.fillAll();
+
+    g.setColour(outlineColor);
+    g.drawRect(getLocalBounds(), 2);
+
+    // Title
+    g.setColour(accentColor);
+    g.setFont(juce::Font(24.0f, juce::Font::bold));
+    g.drawFittedText("Smart Noise Gate", getLocalBounds().removeFromTop(50), juce::Justification::centred, 1);
+
+    // Key level meter with open (solid) and close (dashed region) thresholds
+    {
+        g.setColour(backgroundColor);
+        g.fillRect(keyMeterArea);
+
+        auto level = keyMeterArea.withWidth(juce::roundToInt(keyMeterArea.getWidth() * dbToMeterProportion(displayedKeyLevel)));
+        g.setColour(displayedOpen ? openColor : outlineColor);
+        g.fillRect(level);
+
+        const float threshold = audioProcessor.thresholdParam->get();
+        const float closeThreshold = threshold - audioProcessor.hysteresisParam->get();
+        const float openX = keyMeterArea.getX() + keyMeterArea.getWidth() * dbToMeterProportion(threshold);
+        const float closeX = keyMeterArea.getX() + keyMeterArea.getWidth() * dbToMeterProportion(closeThreshold);
+
+        g.setColour(accentColor.withAlpha(0.25f));
+        g.fillRect(juce::Rectangle<float>(closeX, static_cast<float>(keyMeterArea.getY()),
+                                          openX - closeX, static_cast<float>(keyMeterArea.getHeight())));
+
+        g.setColour(accentColor);
+        g.drawLine(openX, static_cast<float>(keyMeterArea.getY() - 3), openX, static_cast<float>(keyMeterArea.getBottom() + 3), 2.0f);
+
+        g.setColour(outlineColor);
+        g.drawRect(keyMeterArea);
+
+        g.setColour(juce::Colours::white.withAlpha(0.7f));
+        g.setFont(11.0f);
+        g.drawText("INPUT", keyMeterArea.translated(0, -16).withHeight(14), juce::Justification::centredLeft);
+    }
+
+    // Gain reduction meter - fills from the right as the gate closes
+    {
+        g.setColour(backgroundColor);
+        g.fillRect(reductionMeterArea);
+
+        const float reduction = 1.0f - dbToMeterProportion(displayedGainReduction);
+        const int width = juce::roundToInt(reductionMeterArea.getWidth() * reduction);
+        g.setColour(closedColor.withAlpha(0.8f));
+        g.fillRect(reductionMeterArea.withLeft(reductionMeterArea.getRight() - width));
+
+        g.setColour(outlineColor);
+        g.drawRect(reductionMeterArea);
+
+        g.setColour(juce::Colours::white.withAlpha(0.7f));
+        g.setFont(11.0f);
+        g.drawText("GAIN REDUCTION", reductionMeterArea.translated(0, -16).withHeight(14), juce::Justification::centredLeft);
+    }
+
+    // Gate state indicator
+    {
+        g.setColour(displayedOpen ? openColor : closedColor);
+        g.fillRoundedRectangle(stateArea.toFloat(), 6.0f);
+
+        g.setColour(juce::Colours::white);
+        g.setFont(juce::Font(14.0f, juce::Font::bold));
+        g.drawText(displayedOpen ? "OPEN" : "CLOSED", stateArea, juce::Justification::centred);
+    }
+}
+
+void SmartNoiseGateAudioProcessorEditor::resized()
+{
+    auto bounds = getLocalBounds().reduced(20);
+    bounds.removeFromTop(40); // Title
+
+    // Meters
+    bounds.removeFromTop(16);
+    keyMeterArea = bounds.removeFromTop(16);
+    bounds.removeFromTop(24);
+    reductionMeterArea = bounds.removeFromTop(16);
+    bounds.removeFromTop(14);
+
+    // Gate state, detection mode and sidechain on one row
+    auto statusRow = bounds.removeFromTop(28);
+    stateArea = statusRow.removeFromLeft(90);
+    statusRow.removeFromLeft(10);
+    detectionSelector.setBounds(statusRow.removeFromLeft(100));
+    statusRow.removeFromLeft(10);
+    sidechainButton.setBounds(statusRow);
+
+    // Two rows of three knobs (labels sit above each knob)
+    bounds.removeFromTop(30);
+    const int rowHeight = (bounds.getHeight() - 20) / 2;
+
+    auto layoutRow = [](juce::Rectangle<int> row, std::initializer_list<juce::Slider*> sliders)
+    {
+        const int width = row.getWidth() / static_cast<int>(sliders.size());
+
+        for (auto* slider : sliders)
+            slider->setBounds(row.removeFromLeft(width).reduced(6, 0));
+    };
+
+    layoutRow(bounds.removeFromTop(rowHeight), {&thresholdSlider, &attackSlider, &releaseSlider});
+    bounds.removeFromTop(20);
+    layoutRow(bounds.removeFromTop(rowHeight), {&holdSlider, &hysteresisSlider, &lookaheadSlider});
+}
+
+void SmartNoiseGateAudioProcessorEditor::timerCallback()
+{
+    // Sync controls with current parameter values (DAW automation, preset loading)
+    thresholdSlider.setValue(audioProcessor.thresholdParam->get(), juce::dontSendNotification);
+    attackSlider.setValue(audioProcessor.attackParam->get(), juce::dontSendNotification);
+    releaseSlider.setValue(audioProcessor.releaseParam->get(), juce::dontSendNotification);
+    holdSlider.setValue(audioProcessor.holdParam->get(), juce::dontSendNotification);
+    hysteresisSlider.setValue(audioProcessor.hysteresisParam->get(), juce::dontSendNotification);
+    lookaheadSlider.setValue(audioProcessor.lookaheadParam->get(), juce::dontSendNotification);
+    detectionSelector.setSelectedItemIndex(audioProcessor.detectionParam->getIndex(), juce::dontSendNotification);
+    sidechainButton.setToggleState(audioProcessor.sidechainParam->get(), juce::dontSendNotification);
+
+    // Meters: jump up, fall back smoothly
+    const auto& gate = audioProcessor.getGate();
+    const float keyLevel = gate.getKeyLevelDb();
+    displayedKeyLevel = keyLevel > displayedKeyLevel ? keyLevel : displayedKeyLevel - 1.5f;
+    displayedGainReduction = gate.getGainReductionDb();
+    displayedOpen = gate.isGateOpen();
+
+    repaint();
+}
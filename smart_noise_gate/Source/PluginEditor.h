@@ -0,0 +1,57 @@
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+/**
+ * SmartNoiseGateAudioProcessorEditor
+ *
+ * Vertical gate panel from NOISE_GATE_PLAN.md:
+ * - Key level meter with the open/close thresholds marked
+ * - Gain reduction meter and OPEN/CLOSED indicator
+ * - Rotary controls for threshold, attack, release, hold, hysteresis, lookahead
+ * - Detection mode and sidechain switches
+ */
+class SmartNoiseGateAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                           private juce::Timer
+{
+public:
+    SmartNoiseGateAudioProcessorEditor(SmartNoiseGateAudioProcessor&);
+    ~SmartNoiseGateAudioProcessorEditor() override;
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;
+
+    // Wires a rotary slider to a float parameter, shown in real units
+    void setupKnob(juce::Slider& slider, juce::Label& label, juce::AudioParameterFloat* param,
+                   const juce::String& name, const juce::String& suffix, const juce::String& tooltip);
+
+    SmartNoiseGateAudioProcessor& audioProcessor;
+
+    juce::Slider thresholdSlider, attackSlider, releaseSlider, holdSlider, hysteresisSlider, lookaheadSlider;
+    juce::Label thresholdLabel, attackLabel, releaseLabel, holdLabel, hysteresisLabel, lookaheadLabel;
+
+    juce::ComboBox detectionSelector;
+    juce::ToggleButton sidechainButton { "Sidechain" };
+
+    // Meter values, smoothed for display
+    float displayedKeyLevel = -100.0f;
+    float displayedGainReduction = -100.0f;
+    bool displayedOpen = false;
+
+    juce::Rectangle<int> keyMeterArea;
+    juce::Rectangle<int> reductionMeterArea;
+    juce::Rectangle<int> stateArea;
+
+    // Colors
+    const juce::Colour backgroundColor = juce::Colour(0xff1a1d2e);
+    const juce::Colour panelColor = juce::Colour(0xff2d3142);
+    const juce::Colour outlineColor = juce::Colour(0xff4f5d75);
+    const juce::Colour accentColor = juce::Colour(0xffef8354);
+    const juce::Colour openColor = juce::Colour(0xff4caf50);
+    const juce::Colour closedColor = juce::Colour(0xffe53935);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SmartNoiseGateAudioProcessorEditor)
+};
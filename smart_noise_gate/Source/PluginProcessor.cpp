@@ -0,0 +1,243 @@
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+SmartNoiseGateAudioProcessor::SmartNoiseGateAudioProcessor()
+    : AudioProcessor(BusesProperties()
+                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                         .withOutput("Output", juce::AudioChannelSet::stereo(), true)
+                         .withInput("Sidechain", juce::AudioChannelSet::stereo(), false))
+{
+    // Ranges and defaults follow NOISE_GATE_PLAN.md
+
+    addParameter(thresholdParam = new juce::AudioParameterFloat(
+        "threshold",
+        "Threshold",
+        juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f),
+        -40.0f));               // Good starting point for guitar
+
+    juce::NormalisableRange<float> attackRange(0.1f, 50.0f, 0.01f);
+    attackRange.setSkewForCentre(5.0f);
+    addParameter(attackParam = new juce::AudioParameterFloat(
+        "attack",
+        "Attack",
+        attackRange,
+        0.5f));                 // Fast enough to keep pick attacks
+
+    juce::NormalisableRange<float> releaseRange(10.0f, 2000.0f, 1.0f);
+    releaseRange.setSkewForCentre(200.0f);
+    addParameter(releaseParam = new juce::AudioParameterFloat(
+        "release",
+        "Release",
+        releaseRange,
+        100.0f));               // Natural decay
+
+    addParameter(holdParam = new juce::AudioParameterFloat(
+        "hold",
+        "Hold",
+        juce::NormalisableRange<float>(0.0f, 500.0f, 1.0f),
+        50.0f));
+
+    addParameter(hysteresisParam = new juce::AudioParameterFloat(
+        "hysteresis",
+        "Hysteresis",
+        juce::NormalisableRange<float>(0.0f, 12.0f, 0.1f),
+        3.0f));
+
+    addParameter(lookaheadParam = new juce::AudioParameterFloat(
+        "lookahead",
+        "Lookahead",
+        juce::NormalisableRange<float>(0.0f, static_cast<float>(NoiseGate::maxLookaheadMs), 0.1f),
+        0.0f));                 // Off - no added latency
+
+    addParameter(detectionParam = new juce::AudioParameterChoice(
+        "detection",
+        "Detection",
+        juce::StringArray{"Peak", "RMS"},
+        0));                    // Peak suits guitar transients
+
+    addParameter(sidechainParam = new juce::AudioParameterBool(
+        "sidechain",
+        "External Sidechain",
+        false));
+}
+
+SmartNoiseGateAudioProcessor::~SmartNoiseGateAudioProcessor()
+{
+}
+
+const juce::String SmartNoiseGateAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SmartNoiseGateAudioProcessor::acceptsMidi() const
+{
+    return false;
+}
+
+bool SmartNoiseGateAudioProcessor::producesMidi() const
+{
+    return false;
+}
+
+bool SmartNoiseGateAudioProcessor::isMidiEffect() const
+{
+    return false;
+}
+
+double SmartNoiseGateAudioProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+int SmartNoiseGateAudioProcessor::getNumPrograms()
+{
+    return 1;
+}
+
+int SmartNoiseGateAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void SmartNoiseGateAudioProcessor::setCurrentProgram(int index)
+{
+    juce::ignoreUnused(index);
+}
+
+const juce::String SmartNoiseGateAudioProcessor::getProgramName(int index)
+{
+    juce::ignoreUnused(index);
+    return {};
+}
+
+void SmartNoiseGateAudioProcessor::changeProgramName(int index, const juce::String& newName)
+{
+    juce::ignoreUnused(index, newName);
+}
+
+void SmartNoiseGateAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    gate.prepare(sampleRate, samplesPerBlock, getMainBusNumInputChannels());
+
+    updateGate();
+    cancelPendingUpdate();
+    setLatencySamples(gate.getLatencySamples());
+}
+
+void SmartNoiseGateAudioProcessor::updateGate()
+{
+    gate.setThreshold(*thresholdParam);
+    gate.setAttack(*attackParam);
+    gate.setRelease(*releaseParam);
+    gate.setHold(*holdParam);
+    gate.setHysteresis(*hysteresisParam);
+    gate.setDetectionMode(detectionParam->getIndex() == 0 ? NoiseGate::DetectionMode::Peak
+                                                          : NoiseGate::DetectionMode::RMS);
+
+    const int previousLatency = gate.getLatencySamples();
+    gate.setLookahead(*lookaheadParam);
+
+    // Changing the reported latency isn't safe from the audio callback
+    if (gate.getLatencySamples() != previousLatency)
+    {
+        pendingLatencySamples = gate.getLatencySamples();
+        triggerAsyncUpdate();
+    }
+}
+
+void SmartNoiseGateAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(pendingLatencySamples.load());
+}
+
+void SmartNoiseGateAudioProcessor::releaseResources()
+{
+    gate.reset();
+}
+
+bool SmartNoiseGateAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    // Support mono and stereo
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // Input and output layout must match
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+
+    // Sidechain is optional, mono or stereo
+    const auto sidechain = layouts.getChannelSet(true, 1);
+
+    return sidechain.isDisabled()
+        || sidechain == juce::AudioChannelSet::mono()
+        || sidechain == juce::AudioChannelSet::stereo();
+}
+
+void SmartNoiseGateAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+
+    juce::ScopedNoDenormals noDenormals;
+
+    updateGate();
+
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
+    juce::dsp::AudioBlock<float> block(mainBuffer);
+
+    // Key from the sidechain bus when it's connected and switched on
+    if (*sidechainParam && getBusCount(true) > 1 && getBus(true, 1)->isEnabled())
+    {
+        auto sidechainBuffer = getBusBuffer(buffer, true, 1);
+        gate.process(block, juce::dsp::AudioBlock<const float>(sidechainBuffer));
+    }
+    else
+    {
+        gate.process(block);
+    }
+}
+
+bool SmartNoiseGateAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
+juce::AudioProcessorEditor* SmartNoiseGateAudioProcessor::createEditor()
+{
+    return new SmartNoiseGateAudioProcessorEditor(*this);
+}
+
+void SmartNoiseGateAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
+{
+    // Save parameter states for DAW project persistence
+    juce::MemoryOutputStream stream(destData, true);
+
+    stream.writeFloat(*thresholdParam);
+    stream.writeFloat(*attackParam);
+    stream.writeFloat(*releaseParam);
+    stream.writeFloat(*holdParam);
+    stream.writeFloat(*hysteresisParam);
+    stream.writeFloat(*lookaheadParam);
+    stream.writeInt(detectionParam->getIndex());
+    stream.writeBool(*sidechainParam);
+}
+
+void SmartNoiseGateAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
+{
+    // Restore parameter states when loading DAW project
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+
+    for (auto* param : {thresholdParam, attackParam, releaseParam, holdParam, hysteresisParam, lookaheadParam})
+        param->setValueNotifyingHost(param->convertTo0to1(stream.readFloat()));
+
+    detectionParam->setValueNotifyingHost(detectionParam->convertTo0to1(stream.readInt()));
+    sidechainParam->setValueNotifyingHost(stream.readBool() ? 1.0f : 0.0f);
+}
+
+// This creates new instances of the plugin
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SmartNoiseGateAudioProcessor();
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <JuceHeader.h>
+#include "NoiseGate.h"
+
+/**
+ * SmartNoiseGateAudioProcessor
+ *
+ * Main plugin processor class - handles:
+ * - Gating via the shared NoiseGate engine
+ * - Optional sidechain input to key the gate from another signal
+ * - Parameter management and automation
+ * - Latency reporting for lookahead
+ * - State save/load for DAW projects
+ */
+class SmartNoiseGateAudioProcessor : public juce::AudioProcessor,
+                                     private juce::AsyncUpdater
+{
+public:
+    SmartNoiseGateAudioProcessor();
+    ~SmartNoiseGateAudioProcessor() override;
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    const juce::String getName() const override;
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram(int index) override;
+    const juce::String getProgramName(int index) override;
+    void changeProgramName(int index, const juce::String& newName) override;
+
+    void getStateInformation(juce::MemoryBlock& destData) override;
+    void setStateInformation(const void* data, int sizeInBytes) override;
+
+    // Metering for the editor
+    const NoiseGate& getGate() const { return gate; }
+
+    // Public access to parameters for editor
+    juce::AudioParameterFloat* thresholdParam;
+    juce::AudioParameterFloat* attackParam;
+    juce::AudioParameterFloat* releaseParam;
+    juce::AudioParameterFloat* holdParam;
+    juce::AudioParameterFloat* hysteresisParam;
+    juce::AudioParameterFloat* lookaheadParam;
+    juce::AudioParameterChoice* detectionParam;    // Peak or RMS
+    juce::AudioParameterBool* sidechainParam;      // Key from the sidechain bus
+
+private:
+    NoiseGate gate;
+
+    // Push parameter values into the gate and report latency changes
+    void updateGate();
+
+    // Lookahead changes found on the audio thread are reported to the host
+    // from the message thread
+    std::atomic<int> pendingLatencySamples { 0 };
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SmartNoiseGateAudioProcessor)
+};